@@ -1,6 +1,7 @@
 #pragma once
 
 #include "async_resp.hpp"
+#include "cancellation.hpp"
 #include "http_request.hpp"
 #include "http_server.hpp"
 #include "logging.hpp"
@@ -69,6 +70,14 @@ class App
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                 bool bypassAuth = false)
     {
+        if (asyncResp->res.isCancelled())
+        {
+            BMCWEB_LOG_DEBUG << "Request is cancelled, not handling "
+                             << req.url;
+            asyncResp->res.getCancellationToken()->markWorkSkipped();
+            return;
+        }
+        CancellationScope scope(asyncResp->res.getCancellationToken());
         router.handle(req, asyncResp, bypassAuth);
     }
 
@@ -89,6 +98,15 @@ class App
         return *this;
     }
 
+#ifdef BMCWEB_ENABLE_UNIX_SOCKET
+    // A listening Unix socket to serve alongside the TCP one, without TLS
+    App& localSocket(int existingSocket)
+    {
+        localSocketFd = existingSocket;
+        return *this;
+    }
+#endif
+
     App& port(std::uint16_t port)
     {
         portUint = port;
@@ -120,6 +138,12 @@ class App
             sslServer = std::make_unique<ssl_server_t>(this, socketFd,
                                                        sslContext, io);
         }
+#ifdef BMCWEB_ENABLE_UNIX_SOCKET
+        if (-1 != localSocketFd)
+        {
+            sslServer->addLocalSocket(localSocketFd);
+        }
+#endif
         sslServer->run();
 
 #else
@@ -133,6 +157,12 @@ class App
         {
             server = std::make_unique<server_t>(this, socketFd, nullptr, io);
         }
+#ifdef BMCWEB_ENABLE_UNIX_SOCKET
+        if (-1 != localSocketFd)
+        {
+            server->addLocalSocket(localSocketFd);
+        }
+#endif
         server->run();
 
 #endif
@@ -193,6 +223,9 @@ class App
 #endif
     std::string bindaddrStr = "0.0.0.0";
     int socketFd = -1;
+#ifdef BMCWEB_ENABLE_UNIX_SOCKET
+    int localSocketFd = -1;
+#endif
     Router router;
 
 #ifdef BMCWEB_ENABLE_SSL
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace crow
+{
+
+/**
+ * @brief Marks the work done on behalf of a request as no longer wanted.
+ *
+ * Every request has a token.  The connection cancels the token of a read it
+ * is handling when the client goes away; writes are never cancelled.  The
+ * token travels with the Response, so handlers and sub-requests made for
+ * $expand and only can check it, and D-Bus calls made through dbus::utility
+ * while it is current are skipped, instead of building a response nobody
+ * will read.  Their callbacks still run, with
+ * operation_aborted, so callers waiting on them can tell a skipped call from
+ * an empty answer.  Work shared between requests, such as filling a cache,
+ * runs under CancellationScope(nullptr) so no one request can cut it short.
+ *
+ * A token can also carry a deadline, the time budget of the route that was
+ * requested.  Past it the token counts as cancelled, so the response goes
+ * out with whatever had been gathered by then.
+ *
+ * D-Bus calls that fail fast because their service isn't responding mark
+ * the token too, so that the request is answered with a 503.
+ */
+class CancellationToken
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    bool isCancelled() const
+    {
+        return cancelled || deadlineExceeded();
+    }
+
+    void cancel()
+    {
+        cancelled = true;
+    }
+
+    void setDeadline(Clock::time_point when)
+    {
+        deadline = when;
+    }
+
+    bool hasDeadline() const
+    {
+        return deadline.has_value();
+    }
+
+    bool deadlineExceeded() const
+    {
+        return deadline && Clock::now() >= *deadline;
+    }
+
+    // Time left until the deadline, if there is one
+    std::optional<Clock::duration> timeLeft() const
+    {
+        if (!deadline)
+        {
+            return std::nullopt;
+        }
+        return std::max(*deadline - Clock::now(), Clock::duration::zero());
+    }
+
+    // Called by whatever dropped work because the token was cancelled, so
+    // the response can be marked as incomplete
+    void markWorkSkipped()
+    {
+        workWasSkipped = true;
+    }
+
+    bool workSkipped() const
+    {
+        return workWasSkipped;
+    }
+
+    // Called by whatever failed a call fast because the service it was made
+    // to isn't responding, with how long until it is worth trying again
+    void markServiceUnavailable(std::chrono::seconds retryAfter)
+    {
+        unavailableRetryAfter = std::max(
+            unavailableRetryAfter.value_or(std::chrono::seconds(0)),
+            retryAfter);
+    }
+
+    const std::optional<std::chrono::seconds>& serviceUnavailable() const
+    {
+        return unavailableRetryAfter;
+    }
+
+  private:
+    bool cancelled = false;
+    bool workWasSkipped = false;
+    std::optional<std::chrono::seconds> unavailableRetryAfter;
+    std::optional<Clock::time_point> deadline;
+};
+
+/**
+ * @brief Makes a token the current one for as long as the scope lives.
+ *
+ * Routing a request, and each callback dbus::utility runs for it, happens
+ * inside one of these, so calls made from there can pick the token up
+ * without it being passed around.
+ */
+class CancellationScope
+{
+  public:
+    explicit CancellationScope(std::shared_ptr<CancellationToken> token) :
+        previous(std::exchange(currentToken(), std::move(token)))
+    {}
+
+    ~CancellationScope()
+    {
+        currentToken() = std::move(previous);
+    }
+
+    CancellationScope(const CancellationScope&) = delete;
+    CancellationScope(CancellationScope&&) = delete;
+    CancellationScope& operator=(const CancellationScope&) = delete;
+    CancellationScope& operator=(CancellationScope&&) = delete;
+
+    static const std::shared_ptr<CancellationToken>& current()
+    {
+        return currentToken();
+    }
+
+  private:
+    static std::shared_ptr<CancellationToken>& currentToken()
+    {
+        static std::shared_ptr<CancellationToken> token;
+        return token;
+    }
+
+    std::shared_ptr<CancellationToken> previous;
+};
+
+} // namespace crow
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "security_headers.hpp"
+
+#include <array>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace crow
+{
+
+/**
+ * @brief Header lines that are the same on every response, pre-serialized.
+ *
+ * The block holds the Date header followed by the fixed security headers,
+ * and is written to the socket as-is, next to the per-response headers.
+ * It is rebuilt at most once per second, when the Date changes; a response
+ * being written keeps the block it started with alive until it is done.
+ */
+class CommonHeaders
+{
+  public:
+    std::shared_ptr<const std::string> get()
+    {
+        time_t now = time(nullptr);
+        if (block == nullptr || now != blockTime)
+        {
+            rebuild(now);
+        }
+        return block;
+    }
+
+  private:
+    void rebuild(time_t now)
+    {
+        tm myTm{};
+        gmtime_r(&now, &myTm);
+
+        std::array<char, 64> dateStr{};
+        size_t dateStrSz = strftime(dateStr.data(), dateStr.size(),
+                                    "%a, %d %b %Y %H:%M:%S GMT", &myTm);
+
+        const std::string& securityBlock = getSecurityHeaderBlock();
+        auto newBlock = std::make_shared<std::string>();
+        newBlock->reserve(dateStrSz + securityBlock.size() + 8);
+        *newBlock += "Date: ";
+        newBlock->append(dateStr.data(), dateStrSz);
+        *newBlock += "\r\n";
+        *newBlock += securityBlock;
+
+        block = std::move(newBlock);
+        blockTime = now;
+    }
+
+    std::shared_ptr<const std::string> block;
+    time_t blockTime = 0;
+};
+
+} // namespace crow
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace crow
+{
+
+/**
+ * @brief How well requests to one destination have been getting through.
+ *
+ * A request that was given up on after its last retry counts as a failure,
+ * not each attempt at it.  Once a destination has failed holdOffStreak
+ * requests in a row, new requests to it wait until holdUntil, rather than
+ * each one connecting (and handshaking) straight away.
+ */
+struct DestinationHealth
+{
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t fullScore = 100;
+    static constexpr uint32_t holdOffStreak = 3;
+
+    // Moving average of the outcomes of recent requests, from 0 when they
+    // all failed to fullScore when they all got through
+    uint32_t score = fullScore;
+    // Requests failed since the last one that got through
+    uint32_t failureStreak = 0;
+    uint64_t delivered = 0;
+    uint64_t failed = 0;
+    uint64_t retries = 0;
+    Clock::time_point lastDelivered;
+    Clock::time_point lastFailed;
+    Clock::time_point holdUntil;
+
+    void recordDelivered(Clock::time_point now)
+    {
+        delivered++;
+        failureStreak = 0;
+        score = (score * 3 + fullScore) / 4;
+        lastDelivered = now;
+    }
+
+    void recordFailed(Clock::time_point now, Clock::duration holdOff)
+    {
+        failed++;
+        failureStreak++;
+        score = score * 3 / 4;
+        lastFailed = now;
+        holdUntil = now + holdOff;
+    }
+
+    bool isHoldingOff(Clock::time_point now) const
+    {
+        return failureStreak >= holdOffStreak && now < holdUntil;
+    }
+};
+
+// Each request failed in a row doubles the backoff once more, up to this
+static constexpr uint32_t maxFailurePenaltyDoublings = 4;
+
+/**
+ * @brief How long to wait before the given retry of a request, 1 for the
+ * first.
+ *
+ * Starts at base, and doubles for each retry, and for each request the
+ * destination has failed in a row, up to cap.  A random extra of up to half
+ * of that is then added, so that requests that failed together, such as the
+ * events of every subscription to a listener that went down, don't all
+ * retry together too.
+ */
+template <typename Generator>
+std::chrono::milliseconds retryBackoff(std::chrono::seconds base,
+                                       std::chrono::seconds cap,
+                                       uint32_t retry, uint32_t failureStreak,
+                                       Generator& gen)
+{
+    using std::chrono::milliseconds;
+    milliseconds baseMs = base;
+    // The cap can't make retries more frequent than asked for
+    milliseconds capMs = std::max(milliseconds(cap), baseMs);
+    if (baseMs.count() <= 0)
+    {
+        return milliseconds(0);
+    }
+
+    uint32_t doublings = (retry > 0 ? retry - 1 : 0) +
+                         std::min(failureStreak, maxFailurePenaltyDoublings);
+    milliseconds delay = baseMs;
+    for (uint32_t i = 0; i < doublings && delay < capMs; i++)
+    {
+        delay *= 2;
+    }
+    delay = std::min(delay, capMs);
+
+    std::uniform_int_distribution<milliseconds::rep> jitter(0,
+                                                            delay.count() / 2);
+    return delay + milliseconds(jitter(gen));
+}
+
+} // namespace crow
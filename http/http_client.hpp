@@ -16,7 +16,9 @@
 #pragma once
 
 #include "async_resolve.hpp"
+#include "destination_health.hpp"
 #include "http_response.hpp"
+#include "memory_accounting.hpp"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/io_context.hpp>
@@ -42,12 +44,18 @@
 #include <logging.hpp>
 #include <ssl_key_handler.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <optional>
 #include <queue>
+#include <random>
 #include <string>
+#include <string_view>
+#include <vector>
 namespace crow
 {
 
@@ -55,6 +63,8 @@ namespace crow
 // of BMCWeb which can handle 100 simultaneous connections.
 constexpr size_t maxPoolSize = 20;
 constexpr size_t maxRequestQueueSize = 500;
+// Over all the destinations and owners of one client
+constexpr size_t maxClientQueueSize = 2000;
 constexpr unsigned int httpReadBodyLimit = 131072;
 constexpr unsigned int httpReadBufferSize = 4096;
 
@@ -109,20 +119,54 @@ struct ConnectionPolicy
 
     std::string retryPolicyAction = "RetryForever";
 
+    // Retries start retryIntervalSecs apart, backing off exponentially up to
+    // maxRetryIntervalSecs
     std::chrono::seconds retryIntervalSecs = std::chrono::seconds(0);
+    std::chrono::seconds maxRetryIntervalSecs = std::chrono::seconds(300);
     std::function<boost::system::error_code(unsigned int respCode)>
         invalidResp = defaultRetryHandler;
 };
 
+// Totals of what happened to the requests sent through an HttpClient
+struct DeliveryStats
+{
+    uint64_t delivered = 0;
+    // Given up on after the last retry
+    uint64_t failed = 0;
+    // Not sent at all, because the request queue was full
+    uint64_t dropped = 0;
+    uint64_t retries = 0;
+    // Waiting in a queue now, over all destinations
+    size_t queued = 0;
+};
+
+// What an HttpClient reports about each destination it sends to
+struct DestinationStatus
+{
+    std::string destination;
+    DestinationHealth health;
+    size_t queued = 0;
+    bool holdingOff = false;
+};
+
+// Only spreads retries out, so it needn't be a secure source
+inline std::minstd_rand& retryJitterGenerator()
+{
+    static std::minstd_rand gen(std::random_device{}());
+    return gen;
+}
+
 struct PendingRequest
 {
     boost::beast::http::request<boost::beast::http::string_body> req;
     std::function<void(bool, uint32_t, Response&)> callback;
+    std::shared_ptr<ConnectionPolicy> policy;
     PendingRequest(
         boost::beast::http::request<boost::beast::http::string_body>&& reqIn,
-        const std::function<void(bool, uint32_t, Response&)>& callbackIn) :
+        const std::function<void(bool, uint32_t, Response&)>& callbackIn,
+        const std::shared_ptr<ConnectionPolicy>& policyIn) :
         req(std::move(reqIn)),
-        callback(callbackIn)
+        callback(callbackIn), policy(policyIn)
     {}
 };
 
@@ -133,6 +177,9 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
     uint32_t retryCount = 0;
     std::string subId;
     std::shared_ptr<ConnectionPolicy> connPolicy;
+    std::shared_ptr<DeliveryStats> stats;
+    // Shared by the connections of a pool
+    std::shared_ptr<DestinationHealth> health;
     std::string host;
     uint16_t port;
     uint32_t connId;
@@ -397,6 +444,8 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         // Send is successful
         // Reset the counter just in case this was after retrying
         retryCount = 0;
+        stats->delivered++;
+        health->recordDelivered(DestinationHealth::Clock::now());
 
         // Keep the connection alive if server supports it
         // Else close the connection
@@ -457,6 +506,16 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
                 state = ConnState::idle;
             }
 
+            stats->failed++;
+            // New requests wait out the backoff once the destination keeps
+            // failing, so that each doesn't connect again straight away
+            health->recordFailed(
+                DestinationHealth::Clock::now(),
+                retryBackoff(connPolicy->retryIntervalSecs,
+                             connPolicy->maxRetryIntervalSecs, 1,
+                             health->failureStreak + 1,
+                             retryJitterGenerator()));
+
             // We want to return a 502 to indicate there was an error with
             // the external server
             res.result(boost::beast::http::status::bad_gateway);
@@ -470,12 +529,16 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
         }
 
         retryCount++;
+        stats->retries++;
+        health->retries++;
 
+        std::chrono::milliseconds delay = retryBackoff(
+            connPolicy->retryIntervalSecs, connPolicy->maxRetryIntervalSecs,
+            retryCount, health->failureStreak, retryJitterGenerator());
         BMCWEB_LOG_DEBUG << "Attempt retry after "
-                         << std::to_string(
-                                connPolicy->retryIntervalSecs.count())
-                         << " seconds. RetryCount = " << retryCount;
-        timer.expires_after(connPolicy->retryIntervalSecs);
+                         << std::to_string(delay.count())
+                         << " ms. RetryCount = " << retryCount;
+        timer.expires_after(delay);
         timer.async_wait(std::bind_front(&ConnectionInfo::onTimerDone, this,
                                          shared_from_this()));
     }
@@ -646,10 +709,13 @@ class ConnectionInfo : public std::enable_shared_from_this<ConnectionInfo>
     explicit ConnectionInfo(
         boost::asio::io_context& iocIn, const std::string& idIn,
         const std::shared_ptr<ConnectionPolicy>& connPolicyIn,
+        const std::shared_ptr<DeliveryStats>& statsIn,
+        const std::shared_ptr<DestinationHealth>& healthIn,
         const std::string& destIPIn, uint16_t destPortIn, bool useSSL,
         unsigned int connIdIn) :
         subId(idIn),
-        connPolicy(connPolicyIn), host(destIPIn), port(destPortIn),
+        connPolicy(connPolicyIn), stats(statsIn), health(healthIn),
+        host(destIPIn), port(destPortIn),
         connId(connIdIn), ioc(iocIn), conn(makeConnection(iocIn, useSSL)),
         timer(iocIn)
     {}
@@ -661,11 +727,26 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     boost::asio::io_context& ioc;
     std::string id;
     std::shared_ptr<ConnectionPolicy> connPolicy;
+    std::shared_ptr<DeliveryStats> stats;
+    std::shared_ptr<DestinationHealth> health =
+        std::make_shared<DestinationHealth>();
     std::string destIP;
     uint16_t destPort;
     bool useSSL;
     std::vector<std::shared_ptr<ConnectionInfo>> connections;
-    boost::container::devector<PendingRequest> requestQueue;
+    // Sends what was queued while the destination was held off
+    boost::asio::steady_timer holdOffTimer;
+    // Once a hold off runs out, a single request goes out on this connection
+    // to see whether the destination is back.  The rest stay queued until it
+    // gets through.
+    std::optional<uint32_t> probeConnId;
+    // Requests waiting for a free connection, by the owner that sent them.
+    // Owners are served round robin, so one busy sender sharing the pool
+    // can't starve the others.
+    std::map<std::string, boost::container::devector<PendingRequest>,
+             std::less<>>
+        requestQueues;
+    std::string lastServedOwner;
 
     friend class HttpClient;
 
@@ -673,23 +754,80 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     // preparation to begin sending the request
     void setConnProps(ConnectionInfo& conn)
     {
-        if (requestQueue.empty())
+        if (requestQueues.empty())
         {
             BMCWEB_LOG_DEBUG
                 << "setConnProps() should not have been called when requestQueue is empty";
             return;
         }
 
-        auto nextReq = requestQueue.front();
+        // Next owner after the one served last, wrapping around
+        auto queue = requestQueues.upper_bound(lastServedOwner);
+        if (queue == requestQueues.end())
+        {
+            queue = requestQueues.begin();
+        }
+        lastServedOwner = queue->first;
+
+        PendingRequest& nextReq = queue->second.front();
         conn.req = std::move(nextReq.req);
         conn.callback = std::move(nextReq.callback);
+        conn.connPolicy = std::move(nextReq.policy);
 
         BMCWEB_LOG_DEBUG << "Setting properties for connection " << conn.host
                          << ":" << std::to_string(conn.port)
                          << ", id: " << std::to_string(conn.connId);
 
         // We can remove the request from the queue at this point
-        requestQueue.pop_front();
+        queue->second.pop_front();
+        stats->queued--;
+        if (queue->second.empty())
+        {
+            requestQueues.erase(queue);
+        }
+    }
+
+    size_t queuedRequestCount() const
+    {
+        size_t count = 0;
+        for (const auto& queue : requestQueues)
+        {
+            count += queue.second.size();
+        }
+        return count;
+    }
+
+    // Forgets what owner still has queued, once it is gone
+    void dropQueue(std::string_view owner)
+    {
+        auto queue = requestQueues.find(owner);
+        if (queue == requestQueues.end())
+        {
+            return;
+        }
+        BMCWEB_LOG_DEBUG << "Dropping " << std::to_string(queue->second.size())
+                         << " requests of " << owner << " queued for "
+                         << destIP << ":" << std::to_string(destPort);
+        stats->queued -= queue->second.size();
+        requestQueues.erase(queue);
+    }
+
+    // Whether the pool has nothing to send, nor anything to remember about
+    // its destination, so it can be thrown away
+    bool isUnused() const
+    {
+        if (!requestQueues.empty() || probeConnId ||
+            health->isHoldingOff(DestinationHealth::Clock::now()))
+        {
+            return false;
+        }
+        return std::ranges::all_of(
+            connections, [](const std::shared_ptr<ConnectionInfo>& conn) {
+            return conn->state == ConnState::idle ||
+                   conn->state == ConnState::initialized ||
+                   conn->state == ConnState::closed ||
+                   conn->state == ConnState::abortConnection;
+            });
     }
 
     // Gets called as part of callback after request is sent
@@ -704,10 +842,17 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         // AsyncResponse shared_ptr to this callback
         conn->callback = nullptr;
 
+        // A probe that failed has held the destination off again
+        bool probeDone = probeConnId == connId;
+        if (probeDone)
+        {
+            probeConnId.reset();
+        }
+
         // Reuse the connection to send the next request in the queue
-        if (!requestQueue.empty())
+        if (!requestQueues.empty() && !holdingBack())
         {
-            BMCWEB_LOG_DEBUG << std::to_string(requestQueue.size())
+            BMCWEB_LOG_DEBUG << std::to_string(queuedRequestCount())
                              << " requests remaining in queue for " << destIP
                              << ":" << std::to_string(destPort)
                              << ", reusing connnection "
@@ -726,9 +871,20 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
                 conn->doClose();
                 conn->restartConnection();
             }
+            if (probeDone)
+            {
+                // The destination is back; the free connections can help
+                // with the rest
+                startQueued();
+            }
             return;
         }
 
+        if (!requestQueues.empty() && !probeConnId)
+        {
+            scheduleResume();
+        }
+
         // No more messages to send so close the connection if necessary
         if (keepAlive)
         {
@@ -745,7 +901,9 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     void sendData(std::string& data, const std::string& destUri,
                   const boost::beast::http::fields& httpHeader,
                   const boost::beast::http::verb verb,
-                  const std::function<void(Response&)>& resHandler)
+                  const std::function<void(Response&)>& resHandler,
+                  const std::shared_ptr<ConnectionPolicy>& requestPolicy,
+                  std::string_view owner)
     {
         // Construct the request to be sent
         boost::beast::http::request<boost::beast::http::string_body> thisReq(
@@ -756,6 +914,20 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         thisReq.prepare_payload();
         auto cb = std::bind_front(&ConnectionPool::afterSendData,
                                   weak_from_this(), resHandler);
+
+        if (holdingBack())
+        {
+            BMCWEB_LOG_DEBUG << destIP << ":" << std::to_string(destPort)
+                             << " keeps failing, queueing request";
+            queueRequest(std::move(thisReq), std::move(cb), resHandler,
+                         requestPolicy, owner);
+            if (!probeConnId)
+            {
+                scheduleResume();
+            }
+            return;
+        }
+
         // Reuse an existing connection if one is available
         for (unsigned int i = 0; i < connections.size(); i++)
         {
@@ -766,6 +938,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             {
                 conn->req = std::move(thisReq);
                 conn->callback = std::move(cb);
+                conn->connPolicy = requestPolicy;
                 std::string commonMsg = std::to_string(i) + " from pool " +
                                         destIP + ":" + std::to_string(destPort);
 
@@ -792,13 +965,41 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             auto conn = addConnection();
             conn->req = std::move(thisReq);
             conn->callback = std::move(cb);
+            conn->connPolicy = requestPolicy;
             conn->doResolve();
+            return;
         }
-        else if (requestQueue.size() < maxRequestQueueSize)
+
+        queueRequest(std::move(thisReq), std::move(cb), resHandler,
+                     requestPolicy, owner);
+    }
+
+    void queueRequest(
+        boost::beast::http::request<boost::beast::http::string_body>&& thisReq,
+        std::function<void(bool, uint32_t, Response&)>&& cb,
+        const std::function<void(Response&)>& resHandler,
+        const std::shared_ptr<ConnectionPolicy>& requestPolicy,
+        std::string_view owner)
+    {
+        // Each owner gets its own queue limit, so one backed up owner can't
+        // cause requests of the others to be dropped.  The client as a whole
+        // has a limit too, however many owners share it.
+        auto queue = requestQueues.find(owner);
+        if (queue == requestQueues.end())
+        {
+            queue = requestQueues.emplace(std::string(owner),
+                                          boost::container::devector<
+                                              PendingRequest>())
+                        .first;
+        }
+        if (queue->second.size() < maxRequestQueueSize &&
+            stats->queued < maxClientQueueSize)
         {
             BMCWEB_LOG_DEBUG << "Max pool size reached. Adding data to queue."
                              << destIP << ":" << std::to_string(destPort);
-            requestQueue.emplace_back(std::move(thisReq), std::move(cb));
+            queue->second.emplace_back(std::move(thisReq), std::move(cb),
+                                       requestPolicy);
+            stats->queued++;
         }
         else
         {
@@ -806,12 +1007,119 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
             // handle a 429 Too Many Requests dummy response
             BMCWEB_LOG_ERROR << destIP << ": " << std::to_string(destPort)
                              << " request queue full.  Dropping request.";
+            stats->dropped++;
+            if (queue->second.empty())
+            {
+                requestQueues.erase(queue);
+            }
             Response dummyRes;
             dummyRes.result(boost::beast::http::status::too_many_requests);
             resHandler(dummyRes);
         }
     }
 
+    // Whether requests have to wait, for a hold off to run out or for the
+    // probe that follows it to get through
+    bool holdingBack() const
+    {
+        return probeConnId.has_value() ||
+               health->isHoldingOff(DestinationHealth::Clock::now());
+    }
+
+    void scheduleResume()
+    {
+        holdOffTimer.expires_at(health->holdUntil);
+        holdOffTimer.async_wait(
+            std::bind_front(&ConnectionPool::afterHoldOff, weak_from_this()));
+    }
+
+    static void afterHoldOff(const std::weak_ptr<ConnectionPool>& weakSelf,
+                             const boost::system::error_code& ec)
+    {
+        if (ec)
+        {
+            // Cancelled, or moved to a later time
+            return;
+        }
+        std::shared_ptr<ConnectionPool> self = weakSelf.lock();
+        if (!self)
+        {
+            return;
+        }
+        self->resumeAfterHoldOff();
+    }
+
+    // Sends the first of what was queued as a probe, on a free connection.
+    // If the destination fails again, it is held off for longer, otherwise
+    // the rest of the queue follows.
+    void resumeAfterHoldOff()
+    {
+        if (requestQueues.empty() || probeConnId)
+        {
+            return;
+        }
+        std::optional<uint32_t> started = startOne();
+        if (!started)
+        {
+            // Every connection is still shutting down, or busy and will
+            // send from the queue when done; check again shortly
+            holdOffTimer.expires_after(std::chrono::seconds(1));
+            holdOffTimer.async_wait(std::bind_front(
+                &ConnectionPool::afterHoldOff, weak_from_this()));
+            return;
+        }
+        BMCWEB_LOG_DEBUG << "Probing " << destIP << ":"
+                         << std::to_string(destPort) << " on connection "
+                         << std::to_string(*started);
+        probeConnId = started;
+    }
+
+    // Starts the next queued request on a free connection, or on a new one
+    // if there is room for it.  Returns the connection used, if any.
+    std::optional<uint32_t> startOne()
+    {
+        for (const std::shared_ptr<ConnectionInfo>& conn : connections)
+        {
+            if ((conn->state != ConnState::idle) &&
+                (conn->state != ConnState::initialized) &&
+                (conn->state != ConnState::closed))
+            {
+                continue;
+            }
+            setConnProps(*conn);
+            if (conn->state == ConnState::idle)
+            {
+                conn->sendMessage();
+            }
+            else
+            {
+                conn->restartConnection();
+            }
+            return conn->connId;
+        }
+        if (connections.size() < connPolicy->maxConnections)
+        {
+            std::shared_ptr<ConnectionInfo>& conn = addConnection();
+            setConnProps(*conn);
+            conn->doResolve();
+            return conn->connId;
+        }
+        return std::nullopt;
+    }
+
+    // Starts queued requests on every connection that is free, or can be
+    // added
+    void startQueued()
+    {
+        while (!requestQueues.empty())
+        {
+            if (!startOne())
+            {
+                return;
+            }
+        }
+    }
+
     // Callback to be called once the request has been sent
     static void afterSendData(const std::weak_ptr<ConnectionPool>& weakSelf,
                               const std::function<void(Response&)>& resHandler,
@@ -838,7 +1146,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
         unsigned int newId = static_cast<unsigned int>(connections.size());
 
         auto& ret = connections.emplace_back(std::make_shared<ConnectionInfo>(
-            ioc, id, connPolicy, destIP, destPort, useSSL, newId));
+            ioc, id, connPolicy, stats, health, destIP, destPort, useSSL,
+            newId));
 
         BMCWEB_LOG_DEBUG << "Added connection "
                          << std::to_string(connections.size() - 1)
@@ -852,10 +1161,11 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
     explicit ConnectionPool(
         boost::asio::io_context& iocIn, const std::string& idIn,
         const std::shared_ptr<ConnectionPolicy>& connPolicyIn,
+        const std::shared_ptr<DeliveryStats>& statsIn,
         const std::string& destIPIn, uint16_t destPortIn, bool useSSLIn) :
         ioc(iocIn),
-        id(idIn), connPolicy(connPolicyIn), destIP(destIPIn),
-        destPort(destPortIn), useSSL(useSSLIn)
+        id(idIn), connPolicy(connPolicyIn), stats(statsIn), destIP(destIPIn),
+        destPort(destPortIn), useSSL(useSSLIn), holdOffTimer(iocIn)
     {
         BMCWEB_LOG_DEBUG << "Initializing connection pool for " << destIP << ":"
                          << std::to_string(destPort);
@@ -873,6 +1183,7 @@ class HttpClient
     boost::asio::io_context& ioc =
         crow::connections::systemBus->get_io_context();
     std::shared_ptr<ConnectionPolicy> connPolicy;
+    std::shared_ptr<DeliveryStats> stats = std::make_shared<DeliveryStats>();
 
     // Used as a dummy callback by sendData() in order to call
     // sendDataWithCallback()
@@ -893,16 +1204,63 @@ class HttpClient
     HttpClient& operator=(HttpClient&&) = delete;
     ~HttpClient() = default;
 
+    const DeliveryStats& getStats() const
+    {
+        return *stats;
+    }
+
+    std::vector<DestinationStatus> getDestinations() const
+    {
+        std::vector<DestinationStatus> destinations;
+        DestinationHealth::Clock::time_point now =
+            DestinationHealth::Clock::now();
+        for (const auto& [key, pool] : connectionPools)
+        {
+            DestinationStatus& status = destinations.emplace_back();
+            status.destination = key;
+            status.health = *pool->health;
+            status.queued = pool->queuedRequestCount();
+            status.holdingOff = pool->health->isHoldingOff(now);
+        }
+        std::ranges::sort(destinations, {}, &DestinationStatus::destination);
+        return destinations;
+    }
+
+    // Drops the requests owner still has queued, when it stops sending, and
+    // the pools of destinations that have nothing left to do
+    void removeOwner(std::string_view owner)
+    {
+        for (auto it = connectionPools.begin(); it != connectionPools.end();)
+        {
+            it->second->dropQueue(owner);
+            if (it->second->isUnused())
+            {
+                BMCWEB_LOG_DEBUG << "Removing connection pool " << it->first;
+                it = connectionPools.erase(it);
+                continue;
+            }
+            it++;
+        }
+    }
+
     // Send a request to destIP:destPort where additional processing of the
-    // result is not required
+    // result is not required.
+    //
+    // Requests to the same destination share one connection pool, whoever
+    // sends them.  Senders sharing a client can pass their own retry policy,
+    // and an owner name under which their requests are queued; queued
+    // requests of different owners are sent round robin.
     void sendData(std::string& data, const std::string& destIP,
                   uint16_t destPort, const std::string& destUri, bool useSSL,
                   const boost::beast::http::fields& httpHeader,
-                  const boost::beast::http::verb verb)
+                  const boost::beast::http::verb verb,
+                  const std::shared_ptr<ConnectionPolicy>& requestPolicy =
+                      nullptr,
+                  std::string_view owner = "")
     {
         const std::function<void(Response&)> cb = genericResHandler;
         sendDataWithCallback(data, destIP, destPort, destUri, useSSL,
-                             httpHeader, verb, cb);
+                             httpHeader, verb, cb, requestPolicy, owner);
     }
 
     // Send request to destIP:destPort and use the provided callback to
@@ -912,8 +1270,13 @@ class HttpClient
                               bool useSSL,
                               const boost::beast::http::fields& httpHeader,
                               const boost::beast::http::verb verb,
-                              const std::function<void(Response&)>& resHandler)
+                              const std::function<void(Response&)>& resHandler,
+                              const std::shared_ptr<ConnectionPolicy>&
+                                  requestPolicy = nullptr,
+                              std::string_view owner = "")
     {
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("HttpClient"));
         std::string clientKey = useSSL ? "https" : "http";
         clientKey += destIP;
         clientKey += ":";
@@ -922,12 +1285,13 @@ class HttpClient
         if (pool.first->second == nullptr)
         {
             pool.first->second = std::make_shared<ConnectionPool>(
-                ioc, clientKey, connPolicy, destIP, destPort, useSSL);
+                ioc, clientKey, connPolicy, stats, destIP, destPort, useSSL);
         }
         // Send the data using either the existing connection pool or the newly
         // created connection pool
-        pool.first->second->sendData(data, destUri, httpHeader, verb,
-                                     resHandler);
+        pool.first->second->sendData(
+            data, destUri, httpHeader, verb, resHandler,
+            requestPolicy != nullptr ? requestPolicy : connPolicy, owner);
     }
 };
 } // namespace crow
@@ -2,35 +2,55 @@
 #include "bmcweb_config.h"
 
 #include "authentication.hpp"
+#include "cancellation.hpp"
+#include "common_headers.hpp"
 #ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
 #include "audit_events.hpp"
 #endif
 #include "dump_utils.hpp"
 #include "http_response.hpp"
 #include "http_utility.hpp"
+#include "inflating_body.hpp"
 #include "logging.hpp"
+#include "mtls_identity_cache.hpp"
+#include "probes.hpp"
+#include "request_pipeline.hpp"
+#include "tls_handshake_limiter.hpp"
+#include "tracing.hpp"
 #include "utility.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/parser.hpp>
 #include <boost/beast/http/read.hpp>
-#include <boost/beast/http/serializer.hpp>
-#include <boost/beast/http/write.hpp>
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/beast/websocket.hpp>
+#include <grp.h>
+#include <pwd.h>
+#include <sys/socket.h>
+
 #include <boost/url/url_view.hpp>
 #include <json_html_serializer.hpp>
 #include <security_headers.hpp>
 #include <ssl_key_handler.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cerrno>
+#include <charconv>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace crow
@@ -44,6 +64,45 @@ inline void prettyPrintJson(crow::Response& res)
                   "text/html;charset=UTF-8");
 }
 
+// The name of a local user that may use Redfish, such as one on the other
+// end of a Unix socket.  Those are the members of the redfish group, whom
+// the user manager knows; other local users, such as those of daemons, are
+// not BMC users.
+inline std::optional<std::string> localRedfishUser(uid_t uid)
+{
+    passwd entry{};
+    passwd* found = nullptr;
+    std::array<char, 1024> strings{};
+    if (getpwuid_r(uid, &entry, strings.data(), strings.size(), &found) != 0 ||
+        found == nullptr)
+    {
+        return std::nullopt;
+    }
+    group redfishGroup{};
+    group* foundGroup = nullptr;
+    std::array<char, 4096> groupStrings{};
+    if (getgrnam_r("redfish", &redfishGroup, groupStrings.data(),
+                   groupStrings.size(), &foundGroup) != 0 ||
+        foundGroup == nullptr)
+    {
+        return std::nullopt;
+    }
+    std::vector<gid_t> groups(16);
+    int count = static_cast<int>(groups.size());
+    while (getgrouplist(found->pw_name, found->pw_gid, groups.data(),
+                        &count) < 0)
+    {
+        // Sets count to how many there are
+        groups.resize(static_cast<size_t>(count));
+    }
+    groups.resize(static_cast<size_t>(count));
+    if (std::ranges::find(groups, foundGroup->gr_gid) == groups.end())
+    {
+        return std::nullopt;
+    }
+    return std::string(found->pw_name);
+}
+
 static int connectionCount = 0;
 
 // request body limit size set by the bmcwebHttpReqBodyLimitMb option
@@ -52,26 +111,61 @@ constexpr uint64_t httpReqBodyLimit = 1024UL * 1024UL *
 
 constexpr uint64_t loggedOutPostBodyLimit = 4096;
 
+// Compressed request bodies are limited to httpReqBodyLimit both as sent and
+// once inflated, and may not inflate more than this many times over
+constexpr uint64_t maxRequestBodyInflateRatio = 100;
+
+using RequestBody =
+    InflatingStringBody<httpReqBodyLimit, maxRequestBodyInflateRatio>;
+
 constexpr uint32_t httpHeaderLimit = 8192;
 
+// A TLS handshake holds a slot of the TlsHandshakeLimiter, so a client gets
+// only this long to complete one
+constexpr std::chrono::seconds tlsHandshakeTimeout(5);
+
 template <typename Adaptor, typename Handler>
 class Connection :
     public std::enable_shared_from_this<Connection<Adaptor, Handler>>
 {
+    // Connections accepted on the Unix socket, from clients on the BMC
+    static constexpr bool isLocalSocket =
+        std::is_same_v<Adaptor, boost::asio::local::stream_protocol::socket>;
+
+    // A request read from the connection, from being handled until its
+    // response has been written
+    struct PendingRequest
+    {
+        explicit PendingRequest(crow::Request&& reqIn) : req(std::move(reqIn))
+        {}
+
+        crow::Request req;
+        crow::Response res;
+        bool keepAlive = true;
+        // Whether it may be handled alongside the requests ahead of it
+        bool concurrent = false;
+        // Set once res holds the response, ready to be written
+        bool complete = false;
+        // Set while a request that may be abandoned is being handled
+        std::shared_ptr<CancellationToken> cancellation;
+        // Covers the request from being read to the response being written
+        Span requestSpan;
+    };
+
   public:
     Connection(Handler* handlerIn, boost::asio::steady_timer&& timerIn,
-               std::function<std::string()>& getCachedDateStrF,
-               Adaptor adaptorIn) :
+               CommonHeaders& commonHeadersIn, Adaptor adaptorIn) :
         adaptor(std::move(adaptorIn)),
         handler(handlerIn), timer(std::move(timerIn)),
-        getCachedDateStr(getCachedDateStrF)
+        commonHeaders(commonHeadersIn)
     {
-        parser.emplace(std::piecewise_construct, std::make_tuple());
-        parser->body_limit(httpReqBodyLimit);
-        parser->header_limit(httpHeaderLimit);
+        resetParser();
 
 #ifdef BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
-        prepareMutualTls();
+        if constexpr (!isLocalSocket)
+        {
+            prepareMutualTls();
+        }
 #endif // BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
 
         connectionCount++;
@@ -82,8 +176,13 @@ class Connection :
 
     ~Connection()
     {
-        res.setCompleteRequestHandler(nullptr);
+        authRes.setCompleteRequestHandler(nullptr);
         cancelDeadlineTimer();
+        if (peerSession != nullptr)
+        {
+            persistent_data::SessionStore::getInstance().removeSession(
+                peerSession);
+        }
 
         connectionCount--;
         BMCWEB_LOG_DEBUG << this << " Connection closed, total "
@@ -176,112 +275,211 @@ class Connection :
             BMCWEB_LOG_DEBUG << this
                              << " Certificate verification of final depth";
 
-            // Verify KeyUsage
-            bool isKeyUsageDigitalSignature = false;
-            bool isKeyUsageKeyAgreement = false;
-
-            ASN1_BIT_STRING* usage = static_cast<ASN1_BIT_STRING*>(
-                X509_get_ext_d2i(peerCert, NID_key_usage, nullptr, nullptr));
-
-            if (usage == nullptr)
+            // A certificate seen before maps straight to its session,
+            // without parsing it again
+            persistent_data::MutualTlsIdentityCache& cache =
+                persistent_data::MutualTlsIdentityCache::getInstance();
+            std::optional<persistent_data::MutualTlsIdentityCache::Fingerprint>
+                fingerprint = cache.getFingerprint(peerCert);
+            if (fingerprint)
             {
-                BMCWEB_LOG_DEBUG << this << " TLS usage is null";
-                return true;
+                userSession = cache.lookup(*fingerprint);
+                if (userSession != nullptr)
+                {
+                    BMCWEB_LOG_DEBUG << this << " Reusing TLS session: "
+                                     << userSession->uniqueId;
+                    sessionIsFromTransport = true;
+                    return true;
+                }
             }
 
-            for (int i = 0; i < usage->length; i++)
+            userSession = createSessionFromCertificate(peerCert);
+            if (userSession != nullptr)
             {
-                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-                unsigned char usageChar = usage->data[i];
-                if (KU_DIGITAL_SIGNATURE & usageChar)
-                {
-                    isKeyUsageDigitalSignature = true;
-                }
-                if (KU_KEY_AGREEMENT & usageChar)
+                sessionIsFromTransport = true;
+                if (fingerprint)
                 {
-                    isKeyUsageKeyAgreement = true;
+                    cache.insert(*fingerprint, peerCert, userSession);
                 }
             }
-            ASN1_BIT_STRING_free(usage);
+            return true;
+        });
+    }
 
-            if (!isKeyUsageDigitalSignature || !isKeyUsageKeyAgreement)
-            {
-                BMCWEB_LOG_DEBUG << this
-                                 << " Certificate ExtendedKeyUsage does "
-                                    "not allow provided certificate to "
-                                    "be used for user authentication";
-                return true;
-            }
+    // Maps a client certificate whose chain has already been verified to a
+    // new session for the user named in its CommonName, provided its key
+    // usages allow it to be used for client authentication.
+    std::shared_ptr<persistent_data::UserSession>
+        createSessionFromCertificate(X509* peerCert)
+    {
+        // Verify KeyUsage
+        bool isKeyUsageDigitalSignature = false;
+        bool isKeyUsageKeyAgreement = false;
 
-            // Determine that ExtendedKeyUsage includes Client Auth
+        ASN1_BIT_STRING* usage = static_cast<ASN1_BIT_STRING*>(
+            X509_get_ext_d2i(peerCert, NID_key_usage, nullptr, nullptr));
 
-            stack_st_ASN1_OBJECT* extUsage = static_cast<stack_st_ASN1_OBJECT*>(
-                X509_get_ext_d2i(peerCert, NID_ext_key_usage, nullptr,
-                                 nullptr));
+        if (usage == nullptr)
+        {
+            BMCWEB_LOG_DEBUG << this << " TLS usage is null";
+            return nullptr;
+        }
 
-            if (extUsage == nullptr)
+        for (int i = 0; i < usage->length; i++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            unsigned char usageChar = usage->data[i];
+            if (KU_DIGITAL_SIGNATURE & usageChar)
             {
-                BMCWEB_LOG_DEBUG << this << " TLS extUsage is null";
-                return true;
+                isKeyUsageDigitalSignature = true;
             }
-
-            bool isExKeyUsageClientAuth = false;
-            for (int i = 0; i < sk_ASN1_OBJECT_num(extUsage); i++)
+            if (KU_KEY_AGREEMENT & usageChar)
             {
-                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-                int nid = OBJ_obj2nid(sk_ASN1_OBJECT_value(extUsage, i));
-                if (NID_client_auth == nid)
-                {
-                    isExKeyUsageClientAuth = true;
-                    break;
-                }
+                isKeyUsageKeyAgreement = true;
             }
-            sk_ASN1_OBJECT_free(extUsage);
+        }
+        ASN1_BIT_STRING_free(usage);
 
-            // Certificate has to have proper key usages set
-            if (!isExKeyUsageClientAuth)
-            {
-                BMCWEB_LOG_DEBUG << this
-                                 << " Certificate ExtendedKeyUsage does "
-                                    "not allow provided certificate to "
-                                    "be used for user authentication";
-                return true;
-            }
-            std::string sslUser;
-            // Extract username contained in CommonName
-            sslUser.resize(256, '\0');
+        if (!isKeyUsageDigitalSignature || !isKeyUsageKeyAgreement)
+        {
+            BMCWEB_LOG_DEBUG << this
+                             << " Certificate ExtendedKeyUsage does "
+                                "not allow provided certificate to "
+                                "be used for user authentication";
+            return nullptr;
+        }
+
+        // Determine that ExtendedKeyUsage includes Client Auth
+
+        stack_st_ASN1_OBJECT* extUsage = static_cast<stack_st_ASN1_OBJECT*>(
+            X509_get_ext_d2i(peerCert, NID_ext_key_usage, nullptr, nullptr));
 
-            int status = X509_NAME_get_text_by_NID(
-                X509_get_subject_name(peerCert), NID_commonName, sslUser.data(),
-                static_cast<int>(sslUser.size()));
+        if (extUsage == nullptr)
+        {
+            BMCWEB_LOG_DEBUG << this << " TLS extUsage is null";
+            return nullptr;
+        }
 
-            if (status == -1)
+        bool isExKeyUsageClientAuth = false;
+        for (int i = 0; i < sk_ASN1_OBJECT_num(extUsage); i++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+            int nid = OBJ_obj2nid(sk_ASN1_OBJECT_value(extUsage, i));
+            if (NID_client_auth == nid)
             {
-                BMCWEB_LOG_DEBUG
-                    << this << " TLS cannot get username to create session";
-                return true;
+                isExKeyUsageClientAuth = true;
+                break;
             }
+        }
+        sk_ASN1_OBJECT_free(extUsage);
+
+        // Certificate has to have proper key usages set
+        if (!isExKeyUsageClientAuth)
+        {
+            BMCWEB_LOG_DEBUG << this
+                             << " Certificate ExtendedKeyUsage does "
+                                "not allow provided certificate to "
+                                "be used for user authentication";
+            return nullptr;
+        }
+        std::string sslUser;
+        // Extract username contained in CommonName
+        sslUser.resize(256, '\0');
+
+        int status = X509_NAME_get_text_by_NID(
+            X509_get_subject_name(peerCert), NID_commonName, sslUser.data(),
+            static_cast<int>(sslUser.size()));
+
+        if (status == -1)
+        {
+            BMCWEB_LOG_DEBUG
+                << this << " TLS cannot get username to create session";
+            return nullptr;
+        }
+
+        size_t lastChar = sslUser.find('\0');
+        if (lastChar == std::string::npos || lastChar == 0)
+        {
+            BMCWEB_LOG_DEBUG << this << " Invalid TLS user name";
+            return nullptr;
+        }
+        sslUser.resize(lastChar);
+        boost::asio::ip::address ip;
+        if (getClientIp(ip))
+        {
+            BMCWEB_LOG_DEBUG << this << " Unable to get client IP";
+        }
+        // Never stored, so it is not listed as a Redfish session nor
+        // persisted.  It lives as long as the connection, or the identity
+        // cache entry, holding it; requests don't end it.
+        std::shared_ptr<persistent_data::UserSession> session =
+            persistent_data::SessionStore::generateEphemeralSession(sslUser,
+                                                                    ip);
+        if (session != nullptr)
+        {
+            session->persistence = persistent_data::PersistenceType::TIMEOUT;
+            BMCWEB_LOG_DEBUG << this << " Generating TLS session: "
+                             << session->uniqueId;
+        }
+        return session;
+    }
+
+    // Resumed TLS sessions skip certificate verification, and with it the
+    // verify callback.  Recover the identity from the peer certificate kept
+    // in the resumed session, unless the trust store has changed since that
+    // session was first verified.
+    void restoreTlsIdentity()
+    {
+        SSL* ssl = adaptor.native_handle();
+        if (!persistent_data::SessionStore::getInstance()
+                 .getAuthMethodsConfig()
+                 .tls ||
+            SSL_session_reused(ssl) != 1 ||
+            SSL_get_verify_result(ssl) != X509_V_OK)
+        {
+            return;
+        }
+        SSL_SESSION* tlsSession = SSL_get_session(ssl);
+        if (tlsSession == nullptr)
+        {
+            return;
+        }
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
+        X509* peerCert = SSL_get_peer_certificate(ssl);
+#else
+        X509* peerCert = SSL_get1_peer_certificate(ssl);
+#endif
+        if (peerCert == nullptr)
+        {
+            return;
+        }
 
-            size_t lastChar = sslUser.find('\0');
-            if (lastChar == std::string::npos || lastChar == 0)
+        persistent_data::MutualTlsIdentityCache& cache =
+            persistent_data::MutualTlsIdentityCache::getInstance();
+        std::optional<persistent_data::MutualTlsIdentityCache::Fingerprint>
+            fingerprint = cache.getFingerprint(peerCert);
+        if (fingerprint)
+        {
+            userSession = cache.lookup(*fingerprint);
+        }
+        if (userSession == nullptr &&
+            std::chrono::system_clock::from_time_t(
+                SSL_SESSION_get_time(tlsSession)) > cache.trustStoreChangedAt())
+        {
+            userSession = createSessionFromCertificate(peerCert);
+            if (userSession != nullptr && fingerprint)
             {
-                BMCWEB_LOG_DEBUG << this << " Invalid TLS user name";
-                return true;
+                cache.insert(*fingerprint, peerCert, userSession);
             }
-            sslUser.resize(lastChar);
+        }
+        X509_free(peerCert);
+
+        if (userSession != nullptr)
+        {
+            BMCWEB_LOG_DEBUG << this << " Resumed TLS session for "
+                             << userSession->username;
             sessionIsFromTransport = true;
-            userSession = persistent_data::SessionStore::getInstance()
-                              .generateUserSession(
-                                  sslUser, req->ipAddress, std::nullopt,
-                                  persistent_data::PersistenceType::TIMEOUT);
-            if (userSession != nullptr)
-            {
-                BMCWEB_LOG_DEBUG
-                    << this
-                    << " Generating TLS session: " << userSession->uniqueId;
-            }
-            return true;
-        });
+        }
     }
 
     Adaptor& socket()
@@ -305,45 +503,161 @@ class Connection :
                                      boost::beast::ssl_stream<
                                          boost::asio::ip::tcp::socket>>)
         {
-            adaptor.async_handshake(boost::asio::ssl::stream_base::server,
-                                    [this, self(shared_from_this())](
-                                        const boost::system::error_code& ec) {
+            // Only take a handshake slot once the ClientHello is in, so
+            // sockets that never send one can't hold slots
+            adaptor.next_layer().async_wait(
+                boost::asio::socket_base::wait_read,
+                [self(shared_from_this())](
+                    const boost::system::error_code& ec) {
                 if (ec)
                 {
+                    BMCWEB_LOG_DEBUG << self << " Waiting for TLS failed: "
+                                     << ec.message();
                     return;
                 }
-                doReadHeaders();
+                TlsHandshakeLimiter::getInstance().acquire(
+                    [self](TlsHandshakeLimiter::Clock::time_point startedAt) {
+                    self->doHandshake(startedAt);
+                });
             });
         }
         else
         {
+            if constexpr (isLocalSocket)
+            {
+                authenticatePeer();
+            }
             doReadHeaders();
         }
     }
 
+    // Clients of the Unix socket are the local user they run as, when that
+    // user is a Redfish user; other clients are left unauthenticated.
+    // Requests that carry credentials of their own are authenticated with
+    // those instead.
+    void authenticatePeer()
+    {
+        ucred peer{};
+        socklen_t peerSize = sizeof(peer);
+        if (getsockopt(adaptor.native_handle(), SOL_SOCKET, SO_PEERCRED, &peer,
+                       &peerSize) != 0)
+        {
+            BMCWEB_LOG_ERROR << this << " Unable to get peer credentials: "
+                             << errno;
+            return;
+        }
+        std::optional<std::string> username = localRedfishUser(peer.uid);
+        if (!username)
+        {
+            BMCWEB_LOG_DEBUG << this << " No Redfish user with uid "
+                             << peer.uid;
+            return;
+        }
+        boost::asio::ip::address ip;
+        if (getClientIp(ip))
+        {
+            BMCWEB_LOG_DEBUG << this << " Unable to get client IP";
+        }
+        // Never stored, so it can't be looked up by token or listed as a
+        // Redfish session, and goes away with the connection
+        peerSession =
+            persistent_data::SessionStore::generateEphemeralSession(*username,
+                                                                    ip);
+        if (peerSession != nullptr)
+        {
+            BMCWEB_LOG_DEBUG << this << " Generating local session for "
+                             << *username << ": " << peerSession->uniqueId;
+        }
+    }
+
+    void doHandshake(TlsHandshakeLimiter::Clock::time_point startedAt)
+    {
+        startDeadline(tlsHandshakeTimeout);
+        adaptor.async_handshake(
+            boost::asio::ssl::stream_base::server,
+            [this, self(shared_from_this()),
+             startedAt](const boost::system::error_code& ec) {
+            TlsHandshakeLimiter::getInstance().release(startedAt, !ec);
+            if (ec)
+            {
+                BMCWEB_LOG_DEBUG << this
+                                 << " TLS handshake failed: " << ec.message();
+                return;
+            }
+#ifdef BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
+            if (userSession == nullptr)
+            {
+                restoreTlsIdentity();
+            }
+#endif // BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
+            startDeadline();
+            doReadHeaders();
+        });
+    }
+
     void handle()
     {
         std::error_code reqEc;
-        crow::Request& thisReq = req.emplace(parser->release(), reqEc);
+        boost::beast::http::request<RequestBody> parsed = parser->release();
+        // The parser is done with; a fresh one can read the next request
+        // while this one is handled
+        resetParser();
+        auto entry = std::make_shared<PendingRequest>(crow::Request(
+            boost::beast::http::request<boost::beast::http::string_body>(
+                std::move(parsed.base()), std::move(parsed.body())),
+            reqEc));
+        // Headers set while authenticating, for this request's response
+        entry->res = std::move(authRes);
+        authRes.clear();
         if (reqEc)
         {
             BMCWEB_LOG_DEBUG << "Request failed to construct" << reqEc;
-            res.result(boost::beast::http::status::bad_request);
-            completeRequest(res);
+            // Nothing is run for it, so there is nothing to wait for
+            entry->concurrent = true;
+            pipeline.push(entry);
+            entry->res.result(boost::beast::http::status::bad_request);
+            completeRequest(*entry, entry->res);
+            return;
+        }
+        entry->keepAlive = entry->req.keepAlive();
+        entry->req.session = userSession;
+        entry->concurrent = canRunConcurrently(entry->req);
+
+        if (!pipeline.push(entry))
+        {
+            BMCWEB_LOG_DEBUG << this << " Holding request until the "
+                             << pipeline.size() - 1 << " ahead of it finish";
             return;
         }
-        thisReq.session = userSession;
+        startRequest(entry);
+        readNextRequest();
+    }
+
+    void startRequest(const std::shared_ptr<PendingRequest>& entry)
+    {
+        crow::Request& thisReq = entry->req;
+        crow::Response& thisRes = entry->res;
+        BMCWEB_PROBE(request_parsed, &thisReq, thisReq.methodString().data(),
+                     thisReq.methodString().size(), thisReq.target().data(),
+                     thisReq.target().size());
 
         // Fetch the client IP address
-        readClientIp();
+        readClientIp(thisReq);
+
+        entry->requestSpan = Span::startTrace(
+            "HTTP " + std::string(thisReq.methodString()));
+        entry->requestSpan.setAttribute("http.method", thisReq.methodString());
+        entry->requestSpan.setAttribute("http.target", thisReq.target());
+        entry->requestSpan.setAttribute("net.peer.ip",
+                                        thisReq.ipAddress.to_string());
 
         // Check for HTTP version 1.1.
         if (thisReq.version() == 11)
         {
             if (thisReq.getHeaderValue(boost::beast::http::field::host).empty())
             {
-                res.result(boost::beast::http::status::bad_request);
-                completeRequest(res);
+                thisRes.result(boost::beast::http::status::bad_request);
+                completeRequest(*entry, thisRes);
                 return;
             }
         }
@@ -354,34 +668,34 @@ class Connection :
                         << thisReq.methodString() << " " << thisReq.target()
                         << " " << thisReq.ipAddress.to_string();
 
-        res.isAliveHelper = [this]() -> bool { return isAlive(); };
+        thisRes.isAliveHelper = [this]() -> bool { return isAlive(); };
 
         thisReq.ioService = static_cast<decltype(thisReq.ioService)>(
             &adaptor.get_executor().context());
 
-        if (res.completed)
+        if (thisRes.completed)
         {
-            completeRequest(res);
+            completeRequest(*entry, thisRes);
             return;
         }
-        keepAlive = thisReq.keepAlive();
 #ifndef BMCWEB_INSECURE_DISABLE_AUTHX
-        if (!crow::authentication::isOnAllowlist(req->url, req->method()) &&
+        if (!crow::authentication::isOnAllowlist(thisReq.url,
+                                                 thisReq.method()) &&
             thisReq.session == nullptr)
         {
             BMCWEB_LOG_WARNING << "Authentication failed";
             forward_unauthorized::sendUnauthorized(
-                req->url, req->getHeaderValue("X-Requested-With"),
-                req->getHeaderValue("Accept"), res);
-            completeRequest(res);
+                thisReq.url, thisReq.getHeaderValue("X-Requested-With"),
+                thisReq.getHeaderValue("Accept"), thisRes);
+            completeRequest(*entry, thisRes);
             return;
         }
 #endif // BMCWEB_INSECURE_DISABLE_AUTHX
         auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
         BMCWEB_LOG_DEBUG << "Setting completion handler";
         asyncResp->res.setCompleteRequestHandler(
-            [self(shared_from_this())](crow::Response& thisRes) {
-            self->completeRequest(thisRes);
+            [self(shared_from_this()), entry](crow::Response& completed) {
+            self->completeRequest(*entry, completed);
         });
 
         if (thisReq.isUpgrade() &&
@@ -390,8 +704,8 @@ class Connection :
                 "websocket"))
         {
             asyncResp->res.setCompleteRequestHandler(
-                [self(shared_from_this())](crow::Response& thisRes) {
-                if (thisRes.result() != boost::beast::http::status::ok)
+                [self(shared_from_this()), entry](crow::Response& completed) {
+                if (completed.result() != boost::beast::http::status::ok)
                 {
                     // When any error occurs before handle upgradation,
                     // the result in response will be set to respective
@@ -399,21 +713,20 @@ class Connection :
                     // which implies successful handle upgrade. Response
                     // needs to be sent over this connection only on
                     // failure.
-                    self->completeRequest(thisRes);
+                    self->completeRequest(*entry, completed);
                     return;
                 }
             });
-            handler->handleUpgrade(thisReq, asyncResp, std::move(adaptor));
+            handOver(thisReq, asyncResp);
             return;
         }
 
-        std::string url(req->target());
-        if (boost::contains(url, "/Dump/Entries/") &&
-            boost::ends_with(url, "/attachment"))
+        std::string url(thisReq.target());
+        if (isAttachmentDownload(url))
         {
             asyncResp->res.setCompleteRequestHandler(
-                [self(shared_from_this())](crow::Response& thisRes) {
-                if (thisRes.result() != boost::beast::http::status::ok)
+                [self(shared_from_this()), entry](crow::Response& completed) {
+                if (completed.result() != boost::beast::http::status::ok)
                 {
                     // When any error occurs before handle upgradation,
                     // the result in response will be set to respective
@@ -421,37 +734,65 @@ class Connection :
                     // which implies successful handle upgrade. Response
                     // needs to be sent over this connection only on
                     // failure.
-                    self->completeRequest(thisRes);
+                    self->completeRequest(*entry, completed);
                     return;
                 }
             });
 
             redfish::dump_utils::getValidDumpEntryForAttachment(
                 asyncResp, url,
-                [asyncResp, this, self(shared_from_this())](
+                [asyncResp, this, self(shared_from_this()), entry](
                     [[maybe_unused]] const std::string& objectPath,
                     [[maybe_unused]] const std::string& entryID,
                     [[maybe_unused]] const std::string& dumpType) {
                 BMCWEB_LOG_DEBUG << "upgrade stream connection";
-                handler->handleUpgrade(*req, asyncResp, std::move(adaptor));
+                handOver(entry->req, asyncResp);
 
                 // delete lambda with self shared_ptr
                 // to enable connection destruction
-                res.completeRequestHandler = nullptr;
+                entry->res.completeRequestHandler = nullptr;
             });
 
             return;
         }
 
         std::string_view expected =
-            req->getHeaderValue(boost::beast::http::field::if_none_match);
+            thisReq.getHeaderValue(boost::beast::http::field::if_none_match);
         if (!expected.empty())
         {
-            res.setExpectedHash(expected);
+            thisRes.setExpectedHash(expected);
         }
+
+        // Only reads are abandoned when the client goes away; a write that
+        // was cut short halfway could leave things half configured.
+        std::shared_ptr<CancellationToken> token =
+            std::make_shared<CancellationToken>();
+        asyncResp->res.setCancellationToken(token);
+        if (thisReq.method() == boost::beast::http::verb::get ||
+            thisReq.method() == boost::beast::http::verb::head)
+        {
+            entry->cancellation = std::move(token);
+            watchForDisconnect();
+        }
+        asyncResp->res.setTraceContext(entry->requestSpan.context());
         handler->handle(thisReq, asyncResp);
     }
 
+    // Websockets and dump attachments take the socket over, for which there
+    // are handlers of TCP connections only
+    void handOver(const crow::Request& thisReq,
+                  const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        if constexpr (isLocalSocket)
+        {
+            asyncResp->res.result(boost::beast::http::status::not_found);
+        }
+        else
+        {
+            handler->handleUpgrade(thisReq, asyncResp, std::move(adaptor));
+        }
+    }
+
     bool isAlive()
     {
         if constexpr (std::is_same_v<Adaptor,
@@ -467,12 +808,23 @@ class Connection :
     }
     void close()
     {
+        for (const std::shared_ptr<PendingRequest>& entry : pipeline)
+        {
+            if (entry->cancellation)
+            {
+                entry->cancellation->cancel();
+            }
+        }
         if constexpr (std::is_same_v<Adaptor,
                                      boost::beast::ssl_stream<
                                          boost::asio::ip::tcp::socket>>)
         {
             adaptor.next_layer().close();
-            if (sessionIsFromTransport && userSession != nullptr)
+            // Sessions in the identity cache outlive the connection, so the
+            // next connection with the same certificate can use them
+            if (sessionIsFromTransport && userSession != nullptr &&
+                !persistent_data::MutualTlsIdentityCache::getInstance()
+                     .contains(userSession))
             {
                 BMCWEB_LOG_DEBUG
                     << this
@@ -487,19 +839,22 @@ class Connection :
         }
     }
 
-    void completeRequest(crow::Response& thisRes)
+    void completeRequest(PendingRequest& entry, crow::Response& thisRes)
     {
-        if (!req)
+        if (entry.complete)
         {
             return;
         }
+        crow::Request& thisReq = entry.req;
+        crow::Response& res = entry.res;
+        entry.cancellation = nullptr;
         res = std::move(thisRes);
-        res.keepAlive(keepAlive);
+        res.keepAlive(entry.keepAlive);
 
 #ifdef BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
-        if (audit::wantAudit(*req))
+        if (audit::wantAudit(thisReq))
         {
-            if (userSession != nullptr)
+            if (thisReq.session != nullptr)
             {
                 bool requestSuccess = false;
                 // Look for good return codes and if so we know the operation
@@ -509,7 +864,8 @@ class Connection :
                     requestSuccess = true;
                 }
 
-                audit::auditEvent(*req, userSession->username, requestSuccess);
+                audit::auditEvent(thisReq, thisReq.session->username,
+                                  requestSuccess);
             }
             else
             {
@@ -519,12 +875,13 @@ class Connection :
         }
 #endif // BMCWEB_ENABLE_LINUX_AUDIT_EVENTS
 
-        BMCWEB_LOG_INFO << "Response: " << this << ' ' << req->url << ' '
-                        << res.resultInt() << " keepalive=" << keepAlive;
+        BMCWEB_LOG_INFO << "Response: " << this << ' ' << thisReq.url << ' '
+                        << res.resultInt()
+                        << " keepalive=" << entry.keepAlive;
 
-        addSecurityHeaders(*req, res);
+        addSecurityHeaders(thisReq, res);
 
-        crow::authentication::cleanupTempSession(*req);
+        crow::authentication::cleanupTempSession(thisReq);
 
         if (!isAlive())
         {
@@ -536,6 +893,8 @@ class Connection :
             // delete lambda with self shared_ptr
             // to enable connection destruction
             res.setCompleteRequestHandler(nullptr);
+            entry.requestSpan.setAttribute("error", "client gone");
+            entry.requestSpan.end();
             return;
         }
 
@@ -546,8 +905,8 @@ class Connection :
             using http_helpers::ContentType;
             std::array<ContentType, 2> allowed{ContentType::JSON,
                                                ContentType::HTML};
-            ContentType prefered =
-                getPreferedContentType(req->getHeaderValue("Accept"), allowed);
+            ContentType prefered = getPreferedContentType(
+                thisReq.getHeaderValue("Accept"), allowed);
 
             if (prefered == ContentType::HTML)
             {
@@ -560,6 +919,7 @@ class Connection :
                 // backward compatibility.
                 res.addHeader(boost::beast::http::field::content_type,
                               "application/json");
+                Span serializeSpan("serialize", entry.requestSpan.context());
                 res.body() = res.jsonValue.dump(
                     2, ' ', true, nlohmann::json::error_handler_t::replace);
             }
@@ -580,18 +940,26 @@ class Connection :
             res.body().clear();
         }
 
-        res.addHeader(boost::beast::http::field::date, getCachedDateStr());
-
-        res.keepAlive(req->keepAlive());
+        res.keepAlive(thisReq.keepAlive());
 
-        doWrite(res);
+        if (entry.requestSpan.isActive())
+        {
+            res.addHeader("X-Trace-Id",
+                          Tracer::hexId(entry.requestSpan.context().traceId));
+            entry.requestSpan.setAttribute("http.status_code",
+                                           std::to_string(res.resultInt()));
+            entry.requestSpan.end();
+        }
 
         // delete lambda with self shared_ptr
         // to enable connection destruction
         res.setCompleteRequestHandler(nullptr);
+
+        entry.complete = true;
+        writeNextResponse();
     }
 
-    void readClientIp()
+    void readClientIp(crow::Request& thisReq)
     {
         boost::asio::ip::address ip;
         boost::system::error_code ec = getClientIp(ip);
@@ -599,32 +967,206 @@ class Connection :
         {
             return;
         }
-        req->ipAddress = ip;
+        thisReq.ipAddress = ip;
     }
 
     boost::system::error_code getClientIp(boost::asio::ip::address& ip)
     {
         boost::system::error_code ec;
-        BMCWEB_LOG_DEBUG << "Fetch the client IP address";
-        boost::asio::ip::tcp::endpoint endpoint =
-            boost::beast::get_lowest_layer(adaptor).remote_endpoint(ec);
-
-        if (ec)
+        if constexpr (isLocalSocket)
         {
-            // If remote endpoint fails keep going. "ClientOriginIPAddress"
-            // will be empty.
-            BMCWEB_LOG_ERROR << "Failed to get the client's IP Address. ec : "
-                             << ec;
-            return ec;
+            // Clients of the Unix socket are on the BMC itself
+            ip = boost::asio::ip::address_v4::loopback();
+        }
+        else
+        {
+            BMCWEB_LOG_DEBUG << "Fetch the client IP address";
+            boost::asio::ip::tcp::endpoint endpoint =
+                boost::beast::get_lowest_layer(adaptor).remote_endpoint(ec);
+
+            if (ec)
+            {
+                // If remote endpoint fails keep going.
+                // "ClientOriginIPAddress" will be empty.
+                BMCWEB_LOG_ERROR
+                    << "Failed to get the client's IP Address. ec : " << ec;
+                return ec;
+            }
+            ip = endpoint.address();
         }
-        ip = endpoint.address();
         return ec;
     }
 
   private:
+    // Dump attachments are streamed by handing the socket over, like
+    // websockets
+    static bool isAttachmentDownload(std::string_view url)
+    {
+        return boost::contains(url, "/Dump/Entries/") &&
+               boost::ends_with(url, "/attachment");
+    }
+
+    // Whether a request may be handled while the ones ahead of it on the
+    // connection are.  Only reads are, so that the effects of writes happen
+    // in the order the client sent them.  Requests that take the socket over
+    // need it to themselves.
+    static bool canRunConcurrently(const crow::Request& thisReq)
+    {
+        if (thisReq.isUpgrade() || isAttachmentDownload(thisReq.target()))
+        {
+            return false;
+        }
+        return thisReq.method() == boost::beast::http::verb::get ||
+               thisReq.method() == boost::beast::http::verb::head;
+    }
+
+    void resetParser()
+    {
+        parser.emplace(std::piecewise_construct, std::make_tuple());
+        setBodyLimit(httpReqBodyLimit);
+        parser->header_limit(httpHeaderLimit);
+    }
+
+    // Limits the body as sent and once inflated.  At full size both are
+    // httpReqBodyLimit, so a lowered limit stays the same for both.
+    void setBodyLimit(uint64_t limit)
+    {
+        parser->body_limit(limit);
+        parser->get().body().limit = limit;
+    }
+
+    bool anyCancellable() const
+    {
+        return std::ranges::any_of(
+            pipeline, [](const std::shared_ptr<PendingRequest>& entry) {
+            return entry->cancellation != nullptr;
+        });
+    }
+
+    void readNextRequest()
+    {
+        if (reading)
+        {
+            return;
+        }
+        if (pipeline.isReadClosed())
+        {
+            // Nothing more is coming; close once everything is answered
+            if (pipeline.finished())
+            {
+                close();
+            }
+            return;
+        }
+        if (pipeline.canReadNext())
+        {
+            doReadHeaders();
+            return;
+        }
+        if (anyCancellable())
+        {
+            watchForDisconnect();
+        }
+    }
+
+    // Writes the response to the oldest request, once it is complete.
+    // Responses to the requests behind it wait, however early they finish.
+    void writeNextResponse()
+    {
+        PendingRequest* next = pipeline.nextToWrite();
+        if (writing || next == nullptr)
+        {
+            return;
+        }
+        doWrite(next->res);
+    }
+
+    // While nothing is read from the socket, wait for it to become readable
+    // to notice the client leaving.  When a request is being read, a read
+    // error does that instead.
+    void watchForDisconnect()
+    {
+        if (watching || reading || pipeline.isReadClosed())
+        {
+            return;
+        }
+        watching = true;
+        std::weak_ptr<Connection<Adaptor, Handler>> weakSelf = weak_from_this();
+        boost::beast::get_lowest_layer(adaptor).async_wait(
+            boost::asio::socket_base::wait_read,
+            [weakSelf](const boost::system::error_code& ec) {
+            std::shared_ptr<Connection<Adaptor, Handler>> self =
+                weakSelf.lock();
+            if (!self)
+            {
+                return;
+            }
+            self->watching = false;
+            if (ec)
+            {
+                return;
+            }
+            self->checkForDisconnect();
+        });
+    }
+
+    void checkForDisconnect()
+    {
+        if (!anyCancellable())
+        {
+            return;
+        }
+        std::array<uint8_t, 1> next{};
+        ssize_t got =
+            recv(boost::beast::get_lowest_layer(adaptor).native_handle(),
+                 next.data(), next.size(), MSG_PEEK | MSG_DONTWAIT);
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK ||
+                        errno == EINTR))
+        {
+            watchForDisconnect();
+            return;
+        }
+        if (got < 0)
+        {
+            BMCWEB_LOG_WARNING
+                << this << " Client went away, cancelling its requests";
+            close();
+            return;
+        }
+        // End of stream.  Over TLS, the client says goodbye with an alert
+        // record (close_notify) before closing the socket.
+        bool endOfStream = got == 0;
+        if constexpr (std::is_same_v<Adaptor,
+                                     boost::beast::ssl_stream<
+                                         boost::asio::ip::tcp::socket>>)
+        {
+            constexpr uint8_t tlsAlertRecord = 0x15;
+            endOfStream = endOfStream || next[0] == tlsAlertRecord;
+        }
+        if (!endOfStream)
+        {
+            // A pipelined request; read it now if it can be handled
+            // alongside, otherwise once the ones ahead of it are answered
+            if (!reading && pipeline.canReadNext())
+            {
+                doReadHeaders();
+            }
+            return;
+        }
+        // The client may only have shut down its side, after sending all it
+        // wanted to, and still be waiting for the responses.  A client that
+        // went away entirely shows up as the writes failing.
+        BMCWEB_LOG_DEBUG << this << " Client finished sending";
+        if (pipeline.endOfStream())
+        {
+            close();
+        }
+    }
+
     void doReadHeaders()
     {
         BMCWEB_LOG_DEBUG << this << " doReadHeaders";
+        reading = true;
 
         // Clean up any previous Connection.
         boost::beast::http::async_read_header(
@@ -660,27 +1202,52 @@ class Connection :
                 }
             }
 
-            cancelDeadlineTimer();
+            // The deadline of a response being written meanwhile stays
+            if (!writing)
+            {
+                cancelDeadlineTimer();
+            }
 
             if (errorWhileReading)
             {
+                reading = false;
+                // A client that finished sending still gets the responses to
+                // the requests it sent before
+                if (ec == boost::beast::http::error::end_of_stream &&
+                    !pipeline.endOfStream())
+                {
+                    BMCWEB_LOG_DEBUG << this << " Client finished sending";
+                    return;
+                }
                 close();
                 BMCWEB_LOG_DEBUG << this << " from read(1)";
                 return;
             }
 
-            readClientIp();
-
             boost::asio::ip::address ip;
             if (getClientIp(ip))
             {
                 BMCWEB_LOG_DEBUG << "Unable to get client IP";
             }
+            // If the session was built from the transport, we don't need to
+            // clear it.  All other sessions are generated per request.
+            if (!sessionIsFromTransport)
+            {
+                userSession = nullptr;
+            }
             sessionIsFromTransport = false;
 #ifndef BMCWEB_INSECURE_DISABLE_AUTHX
             boost::beast::http::verb method = parser->get().method();
             userSession = crow::authentication::authenticate(
-                ip, res, method, parser->get().base(), userSession);
+                ip, authRes, method, parser->get().base(), userSession);
+            // Credentials that fail are rejected, rather than falling back
+            // to the local user
+            if (userSession == nullptr &&
+                !crow::authentication::carriesCredentials(
+                    parser->get().base()))
+            {
+                userSession = peerSession;
+            }
 
             bool loggedIn = userSession != nullptr;
             if (!loggedIn)
@@ -691,18 +1258,53 @@ class Connection :
                 {
                     BMCWEB_LOG_DEBUG << "Content length greater than limit "
                                      << *contentLength;
+                    reading = false;
                     close();
                     return;
                 }
+                // Also covers chunked bodies, and bodies once inflated
+                setBodyLimit(loggedOutPostBodyLimit);
 
                 BMCWEB_LOG_DEBUG << "Starting quick deadline";
             }
 #endif // BMCWEB_INSECURE_DISABLE_AUTHX
 
+            if (!isSupportedContentEncoding(
+                    parser->get()[boost::beast::http::field::content_encoding]))
+            {
+                rejectUnreadBody(
+                    boost::beast::http::status::unsupported_media_type);
+                return;
+            }
+
             doRead();
         });
     }
 
+    // Answers the request whose headers were just read without reading its
+    // body, which can't be handled.  The body is still on the wire, so the
+    // connection is closed once the response is written.
+    void rejectUnreadBody(boost::beast::http::status status)
+    {
+        BMCWEB_LOG_WARNING << this << " Rejecting request body with " << status;
+        reading = false;
+        crow::Request::Message message(std::move(parser->release().base()),
+                                       std::string());
+        message.keep_alive(false);
+        resetParser();
+        std::error_code reqEc;
+        auto entry = std::make_shared<PendingRequest>(
+            crow::Request(std::move(message), reqEc));
+        entry->res = std::move(authRes);
+        authRes.clear();
+        entry->keepAlive = false;
+        // Nothing is run for it, so there is nothing to wait for
+        entry->concurrent = true;
+        pipeline.push(entry);
+        entry->res.result(status);
+        completeRequest(*entry, entry->res);
+    }
+
     void doRead()
     {
         BMCWEB_LOG_DEBUG << this << " doRead";
@@ -713,7 +1315,11 @@ class Connection :
                                            std::size_t bytesTransferred) {
             BMCWEB_LOG_DEBUG << this << " async_read " << bytesTransferred
                              << " Bytes";
-            cancelDeadlineTimer();
+            reading = false;
+            if (!writing)
+            {
+                cancelDeadlineTimer();
+            }
             if (ec)
             {
                 BMCWEB_LOG_ERROR << this
@@ -726,26 +1332,80 @@ class Connection :
         });
     }
 
+    // Serializes the status line and the headers set on this particular
+    // response into responseHead, reusing its storage across responses.
+    void serializeResponseHead(const crow::Response::response_type& thisRes)
+    {
+        responseHead.clear();
+        responseHead += "HTTP/";
+        responseHead += static_cast<char>('0' + thisRes.version() / 10);
+        responseHead += '.';
+        responseHead += static_cast<char>('0' + thisRes.version() % 10);
+        responseHead += ' ';
+        std::array<char, 8> status{};
+        auto [ptr, ec] = std::to_chars(status.begin(), status.end(),
+                                       thisRes.result_int());
+        if (ec == std::errc())
+        {
+            responseHead.append(status.begin(), ptr);
+        }
+        responseHead += ' ';
+        std::string_view reason = thisRes.reason();
+        responseHead.append(reason.data(), reason.size());
+        responseHead += "\r\n";
+        for (const auto& field : thisRes)
+        {
+            std::string_view name = field.name_string();
+            std::string_view value = field.value();
+            responseHead.append(name.data(), name.size());
+            responseHead += ": ";
+            responseHead.append(value.data(), value.size());
+            responseHead += "\r\n";
+        }
+    }
+
     void doWrite(crow::Response& thisRes)
     {
         BMCWEB_LOG_DEBUG << this << " doWrite";
+        writing = true;
         thisRes.preparePayload();
-        serializer.emplace(*thisRes.stringResponse);
+        serializeResponseHead(*thisRes.stringResponse);
+        // Held until the write completes, in case the block is rebuilt
+        // meanwhile
+        writeCommonHeaders = commonHeaders.get();
+
+        constexpr std::string_view endOfHeaders = "\r\n";
+        std::array<boost::asio::const_buffer, 4> buffers{
+            boost::asio::buffer(responseHead),
+            boost::asio::buffer(*writeCommonHeaders),
+            boost::asio::buffer(endOfHeaders.data(), endOfHeaders.size()),
+            boost::asio::buffer(thisRes.body())};
+        bool keepAlive = thisRes.keepAlive();
         startDeadline();
-        boost::beast::http::async_write(adaptor, *serializer,
-                                        [this, self(shared_from_this())](
-                                            const boost::system::error_code& ec,
-                                            std::size_t bytesTransferred) {
+        BMCWEB_PROBE(response_write_start, this, thisRes.resultInt(),
+                     thisRes.body().size());
+        boost::asio::async_write(adaptor, buffers,
+                                 [this, self(shared_from_this()), keepAlive](
+                                     const boost::system::error_code& ec,
+                                     std::size_t bytesTransferred) {
             BMCWEB_LOG_DEBUG << this << " async_write " << bytesTransferred
                              << " bytes";
+            BMCWEB_PROBE(response_write_done, this, bytesTransferred,
+                         ec.value());
 
-            cancelDeadlineTimer();
+            writing = false;
+            // A request body being read meanwhile keeps its deadline
+            if (!reading || !parser->is_header_done())
+            {
+                cancelDeadlineTimer();
+            }
 
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << this << " from write(2)";
                 return;
             }
+            std::shared_ptr<PendingRequest> next = pipeline.popWritten();
             if (!keepAlive)
             {
                 close();
@@ -753,24 +1413,16 @@ class Connection :
                 return;
             }
 
-            serializer.reset();
+            writeCommonHeaders.reset();
             BMCWEB_LOG_DEBUG << this << " Clearing response";
-            res.clear();
-            parser.emplace(std::piecewise_construct, std::make_tuple());
-            parser->body_limit(httpReqBodyLimit); // reset body limit for
-                                                  // newly created parser
-            buffer.consume(buffer.size());
 
-            // If the session was built from the transport, we don't need to
-            // clear it.  All other sessions are generated per request.
-            if (!sessionIsFromTransport)
+            if (next != nullptr)
             {
-                userSession = nullptr;
+                // Everything ahead of the held request is answered
+                startRequest(next);
             }
-
-            // Destroy the Request via the std::optional
-            req.reset();
-            doReadHeaders();
+            writeNextResponse();
+            readNextRequest();
         });
     }
 
@@ -779,11 +1431,10 @@ class Connection :
         timer.cancel();
     }
 
-    void startDeadline()
+    void startDeadline(std::chrono::seconds timeout = std::chrono::seconds(120))
     {
         cancelDeadlineTimer();
 
-        std::chrono::seconds timeout(120);
         // allow slow uploads for logged in users
         bool loggedIn = userSession != nullptr;
         if (loggedIn)
@@ -830,27 +1481,36 @@ class Connection :
     Handler* handler;
     // Making this a std::optional allows it to be efficiently destroyed and
     // re-created on Connection reset
-    std::optional<
-        boost::beast::http::request_parser<boost::beast::http::string_body>>
-        parser;
+    std::optional<boost::beast::http::request_parser<RequestBody>> parser;
 
+    // Also holds the start of pipelined requests that were read along with
+    // the one before them, until the parser gets to them
     boost::beast::flat_static_buffer<8192> buffer;
 
-    std::optional<boost::beast::http::response_serializer<
-        boost::beast::http::string_body>>
-        serializer;
+    // Status line and per-response headers of the response being written
+    std::string responseHead;
+    std::shared_ptr<const std::string> writeCommonHeaders;
+
+    // Headers set while authenticating the request being read
+    crow::Response authRes;
 
-    std::optional<crow::Request> req;
-    crow::Response res;
+    // Requests read and not yet answered.  Up to bmcwebHttpPipelineDepth of
+    // them are handled at once.
+    RequestPipeline<PendingRequest> pipeline{bmcwebHttpPipelineDepth};
+
+    bool reading = false;
+    bool writing = false;
+    bool watching = false;
 
     bool sessionIsFromTransport = false;
     std::shared_ptr<persistent_data::UserSession> userSession;
+    // The local user on the other end of a Unix socket, for the life of the
+    // connection
+    std::shared_ptr<persistent_data::UserSession> peerSession;
 
     boost::asio::steady_timer timer;
 
-    bool keepAlive = true;
-
-    std::function<std::string()>& getCachedDateStr;
+    CommonHeaders& commonHeaders;
 
     using std::enable_shared_from_this<
         Connection<Adaptor, Handler>>::shared_from_this;
@@ -10,6 +10,7 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/url/url_view.hpp>
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -19,25 +20,22 @@ namespace crow
 
 struct Request
 {
-    boost::beast::http::request<boost::beast::http::string_body> req;
-    boost::beast::http::fields& fields;
+    using Message =
+        boost::beast::http::request<boost::beast::http::string_body>;
+
     std::string_view url{};
     boost::urls::url_view urlView{};
 
     bool isSecure{false};
 
-    std::string& body;
-
     boost::asio::io_context* ioService{};
     boost::asio::ip::address ipAddress{};
 
     std::shared_ptr<persistent_data::UserSession> session;
 
     std::string userRole{};
-    Request(boost::beast::http::request<boost::beast::http::string_body> reqIn,
-            std::error_code& ec) :
-        req(std::move(reqIn)),
-        fields(req.base()), body(req.body())
+    Request(Message reqIn, std::error_code& ec) :
+        message(std::make_shared<Message>(std::move(reqIn)))
     {
         if (!setUrlInfo())
         {
@@ -45,72 +43,79 @@ struct Request
         }
     }
 
-    Request(const Request& other) :
-        req(other.req), fields(req.base()), isSecure(other.isSecure),
-        body(req.body()), ioService(other.ioService),
-        ipAddress(other.ipAddress), session(other.session),
-        userRole(other.userRole)
+    // Copies share the message, so url and urlView, which point into its
+    // target, stay valid
+    Request(const Request& other) = default;
+    Request(Request&& other) noexcept = default;
+
+    Request& operator=(const Request&) = delete;
+    Request& operator=(const Request&&) = delete;
+    ~Request() = default;
+
+    const Message& req() const
     {
-        setUrlInfo();
+        return *message;
     }
 
-    Request(Request&& other) noexcept :
-        req(std::move(other.req)), fields(req.base()), isSecure(other.isSecure),
-        body(req.body()), ioService(other.ioService),
-        ipAddress(std::move(other.ipAddress)),
-        session(std::move(other.session)), userRole(std::move(other.userRole))
+    const boost::beast::http::fields& fields() const
     {
-        setUrlInfo();
+        return message->base();
     }
 
-    Request& operator=(const Request&) = delete;
-    Request& operator=(const Request&&) = delete;
-    ~Request() = default;
+    const std::string& body() const
+    {
+        return message->body();
+    }
 
     boost::beast::http::verb method() const
     {
-        return req.method();
+        return message->method();
     }
 
     std::string_view getHeaderValue(std::string_view key) const
     {
-        return req[key];
+        return (*message)[key];
     }
 
     std::string_view getHeaderValue(boost::beast::http::field key) const
     {
-        return req[key];
+        return (*message)[key];
+    }
+
+    void clearHeader(boost::beast::http::field key)
+    {
+        mutableMessage().erase(key);
     }
 
     std::string_view methodString() const
     {
-        return req.method_string();
+        return message->method_string();
     }
 
     std::string_view target() const
     {
-        return req.target();
+        return message->target();
     }
 
     bool target(const std::string_view target)
     {
-        req.target(target);
+        mutableMessage().target(target);
         return setUrlInfo();
     }
 
     unsigned version() const
     {
-        return req.version();
+        return message->version();
     }
 
     bool isUpgrade() const
     {
-        return boost::beast::websocket::is_upgrade(req);
+        return boost::beast::websocket::is_upgrade(*message);
     }
 
     bool keepAlive() const
     {
-        return req.keep_alive();
+        return message->keep_alive();
     }
 
   private:
@@ -126,6 +131,23 @@ struct Request
         url = urlView.encoded_path();
         return true;
     }
+
+    // Gives this request its own copy of the message, if it shares it, so
+    // that changing it doesn't change the other copies
+    Message& mutableMessage()
+    {
+        if (message.use_count() > 1)
+        {
+            message = std::make_shared<Message>(*message);
+            setUrlInfo();
+        }
+        return *message;
+    }
+
+    // Headers and body, as parsed.  Shared between copies of the request,
+    // so that handlers and the continuations they set up can keep a request
+    // without copying the body, and only copied by mutableMessage().
+    std::shared_ptr<Message> message;
 };
 
 } // namespace crow
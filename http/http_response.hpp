@@ -1,6 +1,8 @@
 #pragma once
+#include "cancellation.hpp"
 #include "logging.hpp"
 #include "nlohmann/json.hpp"
+#include "tracing.hpp"
 
 #include <boost/asio/buffer.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
@@ -9,6 +11,7 @@
 #include <boost/beast/http/string_body.hpp>
 #include <utils/hex_utils.hpp>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -54,6 +57,8 @@ struct Response
         }
         isAliveHelper = res.isAliveHelper;
         res.isAliveHelper = nullptr;
+        cancellationToken = std::move(res.cancellationToken);
+        traceContext = res.traceContext;
     }
 
     ~Response() = default;
@@ -91,6 +96,8 @@ struct Response
         completed = r.completed;
         isAliveHelper = std::move(r.isAliveHelper);
         r.isAliveHelper = nullptr;
+        cancellationToken = std::move(r.cancellationToken);
+        traceContext = r.traceContext;
         return *this;
     }
 
@@ -156,6 +163,8 @@ struct Response
         jsonValue.clear();
         completed = false;
         expectedHash = std::nullopt;
+        cancellationToken = nullptr;
+        traceContext = {};
     }
 
     void write(std::string_view bodyPart)
@@ -237,6 +246,33 @@ struct Response
         return ret;
     }
 
+    // True once the client this response is for has gone away
+    bool isCancelled() const
+    {
+        return cancellationToken && cancellationToken->isCancelled();
+    }
+
+    void setCancellationToken(std::shared_ptr<CancellationToken> token)
+    {
+        cancellationToken = std::move(token);
+    }
+
+    const std::shared_ptr<CancellationToken>& getCancellationToken() const
+    {
+        return cancellationToken;
+    }
+
+    // The span work for this response is traced under
+    void setTraceContext(TraceContext context)
+    {
+        traceContext = context;
+    }
+
+    TraceContext getTraceContext() const
+    {
+        return traceContext;
+    }
+
     void setHashAndHandleNotModified()
     {
         // Can only hash if we have content that's valid
@@ -264,6 +300,8 @@ struct Response
     bool completed = false;
     std::function<void(Response&)> completeRequestHandler;
     std::function<bool()> isAliveHelper;
+    std::shared_ptr<CancellationToken> cancellationToken;
+    TraceContext traceContext;
 };
 
 struct DynamicResponse
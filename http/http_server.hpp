@@ -1,10 +1,13 @@
 #pragma once
 
+#include "common_headers.hpp"
 #include "http_connection.hpp"
 #include "logging.hpp"
+#include "probes.hpp"
 
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/steady_timer.hpp>
@@ -65,40 +68,31 @@ class Server
                adaptorCtxIn, io)
     {}
 
-    void updateDateStr()
+    // Also serves connections on a listening Unix socket, with the same
+    // handler.  They are plain HTTP, whatever Adaptor is; their clients are
+    // on the BMC, and authenticated by their peer credentials.
+    void addLocalSocket(int existingSocket)
     {
-        time_t lastTimeT = time(nullptr);
-        tm myTm{};
-
-        gmtime_r(&lastTimeT, &myTm);
-
-        dateStr.resize(100);
-        size_t dateStrSz = strftime(&dateStr[0], 99,
-                                    "%a, %d %b %Y %H:%M:%S GMT", &myTm);
-        dateStr.resize(dateStrSz);
+        localAcceptor =
+            std::make_unique<boost::asio::local::stream_protocol::acceptor>(
+                *ioService, boost::asio::local::stream_protocol(),
+                existingSocket);
     }
 
     void run()
     {
         loadCertificate();
-        updateDateStr();
-
-        getCachedDateStr = [this]() -> std::string {
-            static std::chrono::time_point<std::chrono::steady_clock>
-                lastDateUpdate = std::chrono::steady_clock::now();
-            if (std::chrono::steady_clock::now() - lastDateUpdate >=
-                std::chrono::seconds(10))
-            {
-                lastDateUpdate = std::chrono::steady_clock::now();
-                updateDateStr();
-            }
-            return this->dateStr;
-        };
 
         BMCWEB_LOG_INFO << "bmcweb server is running, local endpoint "
                         << acceptor->local_endpoint().address().to_string();
         startAsyncWaitForSignal();
         doAccept();
+        if (localAcceptor)
+        {
+            BMCWEB_LOG_INFO << "Also serving local socket "
+                            << localAcceptor->local_endpoint().path();
+            doAcceptLocal();
+        }
     }
 
     void loadCertificate()
@@ -123,8 +117,14 @@ class Server
         BMCWEB_LOG_INFO << "Building SSL Context file=" << certFile.string();
         std::string sslPemFile(certFile);
         ensuressl::ensureOpensslKeyPresentAndValid(sslPemFile);
+        std::string ecdsaPemFile(certPath / ensuressl::ecdsaCertFileName);
+        if (!ensuressl::ensureEcdsaKeyPresentAndValid(sslPemFile,
+                                                      ecdsaPemFile))
+        {
+            ecdsaPemFile.clear();
+        }
         std::shared_ptr<boost::asio::ssl::context> sslContext =
-            ensuressl::getSslContext(sslPemFile);
+            ensuressl::getSslContext(sslPemFile, ecdsaPemFile);
         adaptorCtx = sslContext;
         handler->ssl(std::move(sslContext));
 #endif
@@ -186,13 +186,13 @@ class Server
                                        boost::asio::ip::tcp::socket>>::value)
         {
             connection = std::make_shared<Connection<Adaptor, Handler>>(
-                handler, std::move(timer), getCachedDateStr,
+                handler, std::move(timer), commonHeaders,
                 Adaptor(*ioService, *adaptorCtx));
         }
         else
         {
             connection = std::make_shared<Connection<Adaptor, Handler>>(
-                handler, std::move(timer), getCachedDateStr,
+                handler, std::move(timer), commonHeaders,
                 Adaptor(*ioService));
         }
         acceptor->async_accept(
@@ -200,6 +200,7 @@ class Server
             [this, connection](boost::system::error_code ec) {
             if (!ec)
             {
+                BMCWEB_PROBE(connection_accept, connection.get());
                 boost::asio::post(*this->ioService,
                                   [connection] { connection->start(); });
             }
@@ -207,14 +208,33 @@ class Server
         });
     }
 
+    void doAcceptLocal()
+    {
+        using LocalSocket = boost::asio::local::stream_protocol::socket;
+        boost::asio::steady_timer timer(*ioService);
+        auto connection = std::make_shared<Connection<LocalSocket, Handler>>(
+            handler, std::move(timer), commonHeaders, LocalSocket(*ioService));
+        localAcceptor->async_accept(
+            connection->socket(),
+            [this, connection](boost::system::error_code ec) {
+            if (!ec)
+            {
+                BMCWEB_PROBE(connection_accept, connection.get());
+                boost::asio::post(*this->ioService,
+                                  [connection] { connection->start(); });
+            }
+            doAcceptLocal();
+        });
+    }
+
   private:
     std::shared_ptr<boost::asio::io_context> ioService;
-    std::function<std::string()> getCachedDateStr;
+    CommonHeaders commonHeaders;
     std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+    std::unique_ptr<boost::asio::local::stream_protocol::acceptor>
+        localAcceptor;
     boost::asio::signal_set signals;
 
-    std::string dateStr;
-
     Handler* handler;
 
     std::shared_ptr<boost::asio::ssl::context> adaptorCtx;
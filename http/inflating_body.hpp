@@ -0,0 +1,185 @@
+#pragma once
+
+#include "gzip_helper.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/system/errc.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+
+// Whether InflatingStringBody can decode a body sent with this
+// Content-Encoding.  The connection answers the others with 415 before
+// reading the body.
+inline bool isSupportedContentEncoding(std::string_view encoding)
+{
+    return encoding.empty() || boost::beast::iequals(encoding, "identity") ||
+           boost::beast::iequals(encoding, "gzip") ||
+           boost::beast::iequals(encoding, "x-gzip") ||
+           boost::beast::iequals(encoding, "deflate");
+}
+
+/**
+ * @brief A string request body that is decoded as it is read, when it was
+ * sent with Content-Encoding gzip or deflate.
+ *
+ * Only the compressed bytes are ever held besides the decoded body, one read
+ * at a time, and the limits are checked as the body grows: a body stops
+ * being read as soon as it would exceed its limit once decoded, or decodes
+ * to more than maxRatio times the compressed bytes read so far.  Once read,
+ * the Content-Encoding header is removed, so handlers see a plain body.
+ */
+template <uint64_t maxSize, uint64_t maxRatio>
+struct InflatingStringBody
+{
+    // The body, and the most it may decode to.  Whoever lowers the parser's
+    // body_limit lowers this along with it, so that a small limit on the
+    // wire is not a large one once inflated.
+    struct value_type : std::string
+    {
+        uint64_t limit = maxSize;
+    };
+    using writer = boost::beast::http::string_body::writer;
+
+    static uint64_t size(const value_type& body)
+    {
+        return body.size();
+    }
+
+    class reader
+    {
+      public:
+        template <bool isRequest>
+        reader(boost::beast::http::header<isRequest>& headerIn,
+               value_type& bodyIn) :
+            fields(headerIn),
+            body(bodyIn)
+        {}
+
+        void init(const boost::optional<uint64_t>& length,
+                  boost::system::error_code& ec)
+        {
+            ec = {};
+            std::string_view encoding =
+                fields[boost::beast::http::field::content_encoding];
+            if (encoding.empty() || boost::beast::iequals(encoding, "identity"))
+            {
+                if (length)
+                {
+                    if (*length > body.limit)
+                    {
+                        ec = boost::beast::http::error::body_limit;
+                        return;
+                    }
+                    body.reserve(static_cast<size_t>(*length));
+                }
+                return;
+            }
+            if (boost::beast::iequals(encoding, "gzip") ||
+                boost::beast::iequals(encoding, "x-gzip"))
+            {
+                inflater.emplace(bmcweb::Inflater::Format::Gzip);
+                return;
+            }
+            if (boost::beast::iequals(encoding, "deflate"))
+            {
+                inflater.emplace(bmcweb::Inflater::Format::Deflate);
+                return;
+            }
+            BMCWEB_LOG_WARNING << "Unsupported Content-Encoding " << encoding;
+            ec = boost::system::errc::make_error_code(
+                boost::system::errc::not_supported);
+        }
+
+        template <class ConstBufferSequence>
+        size_t put(const ConstBufferSequence& buffers,
+                   boost::system::error_code& ec)
+        {
+            ec = {};
+            size_t bytes = 0;
+            for (const boost::asio::const_buffer buffer :
+                 boost::beast::buffers_range_ref(buffers))
+            {
+                std::string_view data(static_cast<const char*>(buffer.data()),
+                                      buffer.size());
+                bytes += data.size();
+                if (!inflater)
+                {
+                    if (body.size() + data.size() > body.limit)
+                    {
+                        ec = boost::beast::http::error::body_limit;
+                        return 0;
+                    }
+                    body.append(data);
+                    continue;
+                }
+                if (!inflater->write(data, body, body.limit))
+                {
+                    BMCWEB_LOG_WARNING << "Compressed body is invalid or "
+                                          "inflates to more than "
+                                       << body.limit << " bytes";
+                    ec = boost::beast::http::error::body_limit;
+                    return 0;
+                }
+                if (body.size() > inflater->totalIn() * maxRatio + slack)
+                {
+                    BMCWEB_LOG_WARNING << "Compressed body inflates more than "
+                                       << maxRatio << " times";
+                    ec = boost::beast::http::error::body_limit;
+                    return 0;
+                }
+            }
+            return bytes;
+        }
+
+        void finish(boost::system::error_code& ec)
+        {
+            ec = {};
+            if (!inflater)
+            {
+                return;
+            }
+            if (!inflater->finished())
+            {
+                BMCWEB_LOG_WARNING << "Compressed body is truncated";
+                ec = boost::beast::http::error::partial_message;
+                return;
+            }
+            BMCWEB_LOG_DEBUG << "Inflated " << inflater->totalIn()
+                             << " byte body to " << body.size() << " bytes";
+            fields.erase(boost::beast::http::field::content_encoding);
+            if (fields.find(boost::beast::http::field::content_length) !=
+                fields.end())
+            {
+                fields.set(boost::beast::http::field::content_length,
+                           std::to_string(body.size()));
+            }
+        }
+
+      private:
+        // Headers and the first blocks of a stream don't compress at the
+        // rate of the data that follows; don't hold small bodies to it
+        static constexpr uint64_t slack = 65536;
+
+        boost::beast::http::fields& fields;
+        value_type& body;
+        std::optional<bmcweb::Inflater> inflater;
+    };
+};
+
+} // namespace crow
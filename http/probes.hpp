@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef BMCWEB_ENABLE_USDT_PROBES
+#include <sys/sdt.h>
+#endif
+
+/**
+ * USDT (sys/sdt.h) static probes, for measuring latencies on a running BMC
+ * with perf or bpftrace.  They are compiled out unless bmcweb is built with
+ * the usdt-probes option, and cost a nop each when built in but not
+ * attached to.
+ *
+ * The probes, all under the bmcweb provider, and their arguments are:
+ *   connection_accept(connection)
+ *   request_parsed(request, method, methodLength, target, targetLength)
+ *   route_matched(request, rule)
+ *   handler_start(request, rule)
+ *   handler_finish(request, rule, status)
+ *   dbus_call_start(callId, service, path, interface, member)
+ *   dbus_call_reply(callId, errorCode)
+ *   response_write_start(connection, status, bodyLength)
+ *   response_write_done(connection, bytesWritten, errorCode)
+ *   websocket_send(connection, length, isBinary)
+ *   websocket_receive(connection, length, isBinary)
+ *
+ * Strings given with a length aren't null terminated.  request pointers
+ * identify a request between the probes for it, and are reused once it is
+ * done.  For instance, the time handlers take, per route:
+ *   bpftrace -e 'usdt:/usr/bin/bmcweb:bmcweb:handler_start
+ *                { @start[arg0] = nsecs; }
+ *                usdt:/usr/bin/bmcweb:bmcweb:handler_finish /@start[arg0]/
+ *                { @us[str(arg1)] = hist((nsecs - @start[arg0]) / 1000);
+ *                  delete(@start[arg0]); }'
+ */
+#ifdef BMCWEB_ENABLE_USDT_PROBES
+#define BMCWEB_PROBE(name, ...)                                                \
+    STAP_PROBEV(bmcweb, name __VA_OPT__(, ) __VA_ARGS__)
+#else
+// Arguments are still compiled, but never evaluated, so that values only
+// computed for a probe don't warn as unused
+#define BMCWEB_PROBE(name, ...)                                                \
+    do                                                                         \
+    {                                                                          \
+        if constexpr (false)                                                   \
+        {                                                                      \
+            bmcweb::probes::unused(__VA_ARGS__);                               \
+        }                                                                      \
+    } while (false)
+#endif
+
+namespace bmcweb
+{
+namespace probes
+{
+
+#ifdef BMCWEB_ENABLE_USDT_PROBES
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+template <typename... Args>
+inline void unused(const Args&... /*args*/)
+{}
+
+// Pairs up the probes of an asynchronous call
+inline uint64_t nextCallId()
+{
+    if constexpr (!enabled)
+    {
+        return 0;
+    }
+    static uint64_t callId = 0;
+    return ++callId;
+}
+
+} // namespace probes
+} // namespace bmcweb
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <boost/asio/ip/address.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace crow
+{
+
+struct RateLimit
+{
+    // Tokens added back per second; 0 means no limit
+    double perSecond = 0;
+    // Tokens a bucket holds when full, which is how many requests can be
+    // made at once after a quiet spell
+    double burst = 0;
+};
+
+/**
+ * @brief A bucket of tokens for one client, refilled at a steady rate up to
+ * a burst size.  Each request takes one.
+ */
+class TokenBucket
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket(const RateLimit& limit, Clock::time_point now) :
+        tokens(limit.burst), lastRefill(now)
+    {}
+
+    void refill(const RateLimit& limit, Clock::time_point now)
+    {
+        std::chrono::duration<double> elapsed = now - lastRefill;
+        tokens = std::min(limit.burst,
+                          tokens + elapsed.count() * limit.perSecond);
+        lastRefill = now;
+    }
+
+    bool hasToken() const
+    {
+        return tokens >= 1.0;
+    }
+
+    void take()
+    {
+        tokens -= 1.0;
+    }
+
+    bool isFull(const RateLimit& limit) const
+    {
+        return tokens >= limit.burst;
+    }
+
+    // Time until a token is available, assuming the bucket was just refilled
+    std::chrono::duration<double> waitTime(const RateLimit& limit) const
+    {
+        return std::chrono::duration<double>((1.0 - tokens) /
+                                             limit.perSecond);
+    }
+
+  private:
+    double tokens;
+    Clock::time_point lastRefill;
+};
+
+enum class RouteCost
+{
+    Normal,
+    Expensive,
+};
+
+struct RateLimitStats
+{
+    uint64_t throttledByUser = 0;
+    uint64_t throttledByAddress = 0;
+    uint64_t throttledExpensive = 0;
+    // Clients not tracked because the table was full of active ones
+    uint64_t untracked = 0;
+};
+
+/**
+ * @brief Limits the rate of requests of each user and each source address.
+ *
+ * Every request takes a token from the bucket of its source address and, if
+ * authenticated, from the bucket of its user; requests to routes marked as
+ * expensive also take one from a second, smaller pair of buckets.  A request
+ * is only let through if every bucket it draws from has a token, so one
+ * client polling faster than its budget is answered with 429 and a
+ * Retry-After instead of taking CPU and D-Bus time from everyone else.
+ */
+class RateLimiter
+{
+  public:
+    using Clock = TokenBucket::Clock;
+
+    static constexpr size_t maxClients = 1024;
+
+    RateLimiter(const RateLimit& normalIn, const RateLimit& expensiveIn) :
+        normal(normalIn), expensive(expensiveIn)
+    {}
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter(RateLimiter&&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+    RateLimiter& operator=(RateLimiter&&) = delete;
+    ~RateLimiter() = default;
+
+    static RateLimiter& getInstance()
+    {
+        static RateLimiter limiter(
+            RateLimit{static_cast<double>(bmcwebRateLimitPerSecond),
+                      static_cast<double>(bmcwebRateLimitBurst)},
+            RateLimit{static_cast<double>(bmcwebRateLimitExpensivePerSecond),
+                      2.0 * static_cast<double>(
+                                bmcwebRateLimitExpensivePerSecond)});
+        return limiter;
+    }
+
+    /**
+     * @brief Takes the tokens for one request.
+     *
+     * @return nullopt if the request may go ahead, otherwise the time after
+     * which it can be retried.
+     */
+    std::optional<std::chrono::seconds>
+        tryAcquire(const std::string& username,
+                   const boost::asio::ip::address& address, RouteCost cost,
+                   Clock::time_point now = Clock::now())
+    {
+        if (normal.perSecond <= 0 && expensive.perSecond <= 0)
+        {
+            return std::nullopt;
+        }
+        // Make room before looking clients up, so neither lookup can remove
+        // what the other returned
+        if (clients.size() + 2 > maxClients)
+        {
+            forgetIdleClients(now);
+        }
+        Client* user = nullptr;
+        if (!username.empty())
+        {
+            user = findClient("user:" + username, now);
+        }
+        Client* source = findClient("ip:" + address.to_string(), now);
+
+        std::chrono::duration<double> wait{0};
+        uint64_t* counter = nullptr;
+        auto check = [&wait, &counter, now](Client* client,
+                                            const RateLimit& limit,
+                                            bool expensiveBucket,
+                                            uint64_t& clientCounter) {
+            if (client == nullptr || limit.perSecond <= 0)
+            {
+                return;
+            }
+            TokenBucket& bucket = expensiveBucket ? client->expensive
+                                                  : client->normal;
+            bucket.refill(limit, now);
+            if (!bucket.hasToken())
+            {
+                wait = std::max(wait, bucket.waitTime(limit));
+                if (counter == nullptr)
+                {
+                    counter = &clientCounter;
+                }
+            }
+        };
+        check(user, normal, false, stats.throttledByUser);
+        check(source, normal, false, stats.throttledByAddress);
+        if (cost == RouteCost::Expensive)
+        {
+            check(user, expensive, true, stats.throttledExpensive);
+            check(source, expensive, true, stats.throttledExpensive);
+        }
+        if (counter != nullptr)
+        {
+            (*counter)++;
+            return std::max(std::chrono::ceil<std::chrono::seconds>(wait),
+                            std::chrono::seconds(1));
+        }
+
+        for (Client* client : {user, source})
+        {
+            if (client == nullptr)
+            {
+                continue;
+            }
+            if (normal.perSecond > 0)
+            {
+                client->normal.take();
+            }
+            if (cost == RouteCost::Expensive && expensive.perSecond > 0)
+            {
+                client->expensive.take();
+            }
+        }
+        return std::nullopt;
+    }
+
+    const RateLimitStats& getStats() const
+    {
+        return stats;
+    }
+
+    size_t clientCount() const
+    {
+        return clients.size();
+    }
+
+    const RateLimit& normalLimit() const
+    {
+        return normal;
+    }
+
+    const RateLimit& expensiveLimit() const
+    {
+        return expensive;
+    }
+
+  private:
+    struct Client
+    {
+        TokenBucket normal;
+        TokenBucket expensive;
+    };
+
+    Client* findClient(const std::string& key, Clock::time_point now)
+    {
+        auto it = clients.find(key);
+        if (it != clients.end())
+        {
+            return &it->second;
+        }
+        if (clients.size() >= maxClients)
+        {
+            // Fail open rather than let one client lock out new ones
+            stats.untracked++;
+            return nullptr;
+        }
+        return &clients
+                    .try_emplace(key, Client{TokenBucket(normal, now),
+                                             TokenBucket(expensive, now)})
+                    .first->second;
+    }
+
+    // Clients whose buckets have filled back up are indistinguishable from
+    // new ones, so they needn't be kept
+    void forgetIdleClients(Clock::time_point now)
+    {
+        for (auto it = clients.begin(); it != clients.end();)
+        {
+            Client& client = it->second;
+            client.normal.refill(normal, now);
+            client.expensive.refill(expensive, now);
+            if (client.normal.isFull(normal) &&
+                client.expensive.isFull(expensive))
+            {
+                it = clients.erase(it);
+                continue;
+            }
+            it++;
+        }
+        BMCWEB_LOG_DEBUG << "Rate limiter tracking " << clients.size()
+                         << " clients";
+    }
+
+    RateLimit normal;
+    RateLimit expensive;
+    std::unordered_map<std::string, Client> clients;
+    RateLimitStats stats;
+};
+
+} // namespace crow
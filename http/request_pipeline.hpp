@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+namespace crow
+{
+
+/**
+ * @brief The requests read from one connection and not yet answered, oldest
+ * first.
+ *
+ * While the requests in flight can all run concurrently and are keep-alive,
+ * the next one can be read and handled alongside them, up to depth at once.
+ * A request that can't run concurrently is held until the ones ahead of it
+ * are answered, and nothing more is read until it is handled.  Responses
+ * leave in the order the requests came in, however early they are complete.
+ *
+ * Entry has the flags keepAlive, concurrent and complete, the last set once
+ * its response is ready to be written.
+ */
+template <typename Entry>
+class RequestPipeline
+{
+  public:
+    explicit RequestPipeline(size_t depthIn) : depth(depthIn) {}
+
+    /**
+     * @brief Adds a request that has been read.
+     *
+     * @return Whether it can be handled now.  If not, it is returned by
+     * popWritten once everything ahead of it is answered.
+     */
+    bool push(const std::shared_ptr<Entry>& entry)
+    {
+        entries.emplace_back(entry);
+        if (entries.size() > 1 && !entry->concurrent)
+        {
+            held = entry;
+            return false;
+        }
+        return true;
+    }
+
+    // Whether another request can be read now
+    bool canReadNext() const
+    {
+        if (readClosed || held != nullptr)
+        {
+            return false;
+        }
+        if (entries.empty())
+        {
+            return true;
+        }
+        const Entry& last = *entries.back();
+        return entries.size() < depth && last.keepAlive && last.concurrent;
+    }
+
+    // The oldest request, if its response is ready to be written
+    Entry* nextToWrite() const
+    {
+        if (entries.empty() || !entries.front()->complete)
+        {
+            return nullptr;
+        }
+        return entries.front().get();
+    }
+
+    /**
+     * @brief Removes the oldest request, once its response is written.
+     *
+     * @return The held request, if it can now be handled.
+     */
+    std::shared_ptr<Entry> popWritten()
+    {
+        entries.pop_front();
+        if (held != nullptr && entries.front() == held)
+        {
+            std::shared_ptr<Entry> next = std::move(held);
+            held = nullptr;
+            return next;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief The client finished sending.  The requests already read are
+     * still answered.
+     *
+     * @return Whether there is nothing left to answer, so the connection can
+     * be closed now.
+     */
+    bool endOfStream()
+    {
+        readClosed = true;
+        return entries.empty();
+    }
+
+    // The client finished sending, and everything it sent is answered
+    bool finished() const
+    {
+        return readClosed && entries.empty();
+    }
+
+    bool isReadClosed() const
+    {
+        return readClosed;
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    auto begin() const
+    {
+        return entries.begin();
+    }
+
+    auto end() const
+    {
+        return entries.end();
+    }
+
+  private:
+    size_t depth;
+    std::deque<std::shared_ptr<Entry>> entries;
+    // A request, the last in entries, that waits for the ones ahead of it to
+    // be answered before it is handled
+    std::shared_ptr<Entry> held;
+    bool readClosed = false;
+};
+
+} // namespace crow
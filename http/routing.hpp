@@ -1,5 +1,8 @@
 #pragma once
 
+#include "bmcweb_config.h"
+
+#include "cancellation.hpp"
 #include "common.hpp"
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
@@ -7,8 +10,12 @@
 #include "http_response.hpp"
 #include "http_stream.hpp"
 #include "logging.hpp"
+#include "memory_accounting.hpp"
 #include "privileges.hpp"
+#include "probes.hpp"
+#include "rate_limiter.hpp"
 #include "sessions.hpp"
+#include "tracing.hpp"
 #include "utility.hpp"
 #include "verb.hpp"
 #include "websocket.hpp"
@@ -17,7 +24,10 @@
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/container/flat_map.hpp>
 
+#include <algorithm>
 #include <cerrno>
+#include <charconv>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -103,6 +113,12 @@ class BaseRule
 
     std::vector<redfish::Privileges> privilegesSet;
 
+    // How long a GET of this route may take, if not the default
+    std::optional<std::chrono::milliseconds> routeTimeBudget;
+
+    // Expensive routes draw on the smaller of the per client rate limits
+    RouteCost routeCost = RouteCost::Normal;
+
     std::string rule;
     std::string nameStr;
 
@@ -600,6 +616,20 @@ struct RuleParameterTraits
         }
         return *self;
     }
+
+    self_t& timeBudget(std::chrono::milliseconds budget)
+    {
+        self_t* self = static_cast<self_t*>(this);
+        self->routeTimeBudget = budget;
+        return *self;
+    }
+
+    self_t& expensive()
+    {
+        self_t* self = static_cast<self_t*>(this);
+        self->routeCost = RouteCost::Expensive;
+        return *self;
+    }
 };
 
 class DynamicRule : public BaseRule, public RuleParameterTraits<DynamicRule>
@@ -1398,6 +1428,9 @@ class Router
                 const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                 bool bypassAuth = false)
     {
+        TraceScope traceScope(asyncResp->res.getTraceContext());
+        Span routeSpan("route");
+
         std::optional<HttpVerb> verb = httpVerbFromBoost(req.method());
         if (!verb || static_cast<size_t>(*verb) >= perMethods.size())
         {
@@ -1448,22 +1481,43 @@ class Router
 
         BaseRule& rule = *foundRoute.route.rule;
         RoutingParams params = std::move(foundRoute.route.params);
+        routeSpan.setAttribute("http.route", rule.rule);
+        BMCWEB_PROBE(route_matched, &req, rule.rule.c_str());
 
         BMCWEB_LOG_DEBUG << "Matched rule '" << rule.rule << "' "
                          << static_cast<uint32_t>(*verb) << " / "
                          << rule.getMethods();
 
+        // Requests made internally, for $expand and the like, were paid for
+        // by the request that made them
+        if (!bypassAuth && isRateLimited(req, rule, asyncResp->res))
+        {
+            return;
+        }
+
+        startTimeBudget(req, rule, asyncResp);
+        reportUnavailableServices(asyncResp);
+
+        bmcweb::memory::Tag memoryTag = startMemoryAccounting(rule, asyncResp);
+        bmcweb::memory::Scope memoryScope(memoryTag);
+
         if (req.session == nullptr || bypassAuth)
         {
+            probeHandler(req, rule, asyncResp);
             rule.handle(req, asyncResp, params);
             return;
         }
         std::string username = req.session->username;
 
+        std::shared_ptr<Span> authSpan = Span::startShared("GetUserInfo");
         crow::connections::systemBus->async_method_call(
-            [&req, asyncResp, &rule, params](
+            [&req, asyncResp, &rule, params, memoryTag, authSpan](
                 const boost::system::error_code ec,
                 const dbus::utility::DBusPropertiesMap& userInfoMap) mutable {
+            if (authSpan)
+            {
+                authSpan->end();
+            }
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "GetUserInfo failed...";
@@ -1559,6 +1613,10 @@ class Router
             }
 
             req.userRole = userRole;
+            CancellationScope scope(asyncResp->res.getCancellationToken());
+            bmcweb::memory::Scope memoryScope(memoryTag);
+            TraceScope traceScope(asyncResp->res.getTraceContext());
+            probeHandler(req, rule, asyncResp);
             rule.handle(req, asyncResp, params);
         },
             "xyz.openbmc_project.User.Manager", "/xyz/openbmc_project/user",
@@ -1592,6 +1650,220 @@ class Router
     }
 
   private:
+    // Charges what is allocated while handling the request to its route,
+    // and records its total once the response is complete.  Sub-requests
+    // made for $expand are charged to the request that made them.
+    static bmcweb::memory::Tag startMemoryAccounting(
+        const BaseRule& rule,
+        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        if constexpr (!bmcweb::memory::enabled)
+        {
+            return {};
+        }
+        if (bmcweb::memory::Scope::current().request != nullptr)
+        {
+            return bmcweb::memory::Scope::current();
+        }
+        bmcweb::memory::Tag tag = bmcweb::memory::request(rule.rule);
+        std::function<void(Response&)> next =
+            asyncResp->res.releaseCompleteRequestHandler();
+        asyncResp->res.setCompleteRequestHandler(
+            [route{rule.rule}, usage{tag.request},
+             next{std::move(next)}](Response& res) {
+            bmcweb::memory::finishRequest(route, *usage);
+            if (next)
+            {
+                next(res);
+            }
+        });
+        return tag;
+    }
+
+    // Fires handler_start now, and handler_finish once the response is
+    // complete
+    static void
+        probeHandler(const Request& req, const BaseRule& rule,
+                     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        if constexpr (!bmcweb::probes::enabled)
+        {
+            return;
+        }
+        BMCWEB_PROBE(handler_start, &req, rule.rule.c_str());
+        std::function<void(Response&)> next =
+            asyncResp->res.releaseCompleteRequestHandler();
+        asyncResp->res.setCompleteRequestHandler(
+            [request{&req}, &rule, next{std::move(next)}](Response& res) {
+            BMCWEB_PROBE(handler_finish, request, rule.rule.c_str(),
+                         res.resultInt());
+            if (next)
+            {
+                next(res);
+            }
+        });
+    }
+
+    static bool isRateLimited(const Request& req, const BaseRule& rule,
+                              Response& res)
+    {
+        RouteCost cost = rule.routeCost;
+        if (req.urlView.params().contains("$expand"))
+        {
+            cost = RouteCost::Expensive;
+        }
+        std::string username;
+        if (req.session != nullptr)
+        {
+            username = req.session->username;
+        }
+        std::optional<std::chrono::seconds> retryAfter =
+            RateLimiter::getInstance().tryAcquire(username, req.ipAddress,
+                                                  cost);
+        if (!retryAfter)
+        {
+            return false;
+        }
+        BMCWEB_LOG_WARNING << "Rate limit exceeded by " << req.ipAddress
+                           << (username.empty() ? "" : " user ") << username;
+        res.result(boost::beast::http::status::too_many_requests);
+        res.addHeader(boost::beast::http::field::retry_after,
+                      std::to_string(retryAfter->count()));
+        return true;
+    }
+
+    // Starts the clock on requests that can be cut short, which are reads.
+    // Sub-requests made for $expand share the cancellation token, and with it
+    // the budget of the route originally requested.
+    static void
+        startTimeBudget(const Request& req, const BaseRule& rule,
+                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        if (req.method() != boost::beast::http::verb::get &&
+            req.method() != boost::beast::http::verb::head)
+        {
+            return;
+        }
+        std::shared_ptr<CancellationToken> token =
+            asyncResp->res.getCancellationToken();
+        if (token == nullptr || token->hasDeadline())
+        {
+            return;
+        }
+
+        std::chrono::milliseconds budget = rule.routeTimeBudget.value_or(
+            std::chrono::seconds(bmcwebRequestTimeBudgetSeconds));
+        std::string_view requested =
+            req.getHeaderValue("X-Request-Time-Budget");
+        if (!requested.empty())
+        {
+            uint64_t requestedMs = 0;
+            const char* end = requested.data() + requested.size();
+            auto [ptr, ec] = std::from_chars(requested.data(), end,
+                                             requestedMs);
+            if (ec == std::errc() && ptr == end &&
+                requestedMs > 0 && requestedMs <= maxTimeBudgetMs)
+            {
+                budget = std::chrono::milliseconds(
+                    std::max(requestedMs, minTimeBudgetMs));
+            }
+            else
+            {
+                BMCWEB_LOG_DEBUG << "Ignoring time budget " << requested;
+            }
+        }
+        if (budget.count() == 0)
+        {
+            return;
+        }
+        token->setDeadline(CancellationToken::Clock::now() + budget);
+
+        std::function<void(Response&)> next =
+            asyncResp->res.releaseCompleteRequestHandler();
+        asyncResp->res.setCompleteRequestHandler(
+            [token, next{std::move(next)}](Response& res) {
+            if (token->deadlineExceeded() && token->workSkipped())
+            {
+                markTimeBudgetExceeded(res);
+            }
+            if (next)
+            {
+                next(res);
+            }
+        });
+    }
+
+    // Sends what was gathered before the budget ran out, saying it is
+    // incomplete, or a 504 if nothing was.  Errors stand as they are, except
+    // internal errors, which are what handlers make of the calls that were
+    // cut short.
+    static void markTimeBudgetExceeded(Response& res)
+    {
+        if (res.result() == boost::beast::http::status::internal_server_error)
+        {
+            BMCWEB_LOG_WARNING << "Time budget ran out, calls were cut short";
+            redfish::messages::operationTimeout(res);
+            res.result(boost::beast::http::status::gateway_timeout);
+            return;
+        }
+        if (res.resultInt() >= 300)
+        {
+            return;
+        }
+        if (res.jsonValue.empty())
+        {
+            BMCWEB_LOG_WARNING << "Time budget ran out with nothing to send";
+            redfish::messages::operationTimeout(res);
+            res.result(boost::beast::http::status::gateway_timeout);
+            return;
+        }
+        if (!res.jsonValue.is_object())
+        {
+            return;
+        }
+        BMCWEB_LOG_WARNING << "Time budget ran out, sending partial response";
+        res.jsonValue["@Message.ExtendedInfo"].push_back(
+            redfish::messages::operationTimeout());
+    }
+
+    // D-Bus calls to a service that isn't responding fail fast, and mark the
+    // cancellation token of the request.  The internal error handlers make of
+    // that becomes a 503, with when the service will be tried again.
+    static void reportUnavailableServices(
+        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        std::shared_ptr<CancellationToken> token =
+            asyncResp->res.getCancellationToken();
+        if (token == nullptr)
+        {
+            return;
+        }
+        std::function<void(Response&)> next =
+            asyncResp->res.releaseCompleteRequestHandler();
+        asyncResp->res.setCompleteRequestHandler(
+            [token, next{std::move(next)}](Response& res) {
+            const std::optional<std::chrono::seconds>& retryAfter =
+                token->serviceUnavailable();
+            if (retryAfter &&
+                res.result() ==
+                    boost::beast::http::status::internal_server_error)
+            {
+                BMCWEB_LOG_WARNING << "D-Bus service not responding";
+                redfish::messages::serviceTemporarilyUnavailable(
+                    res, std::to_string(retryAfter->count()));
+            }
+            if (next)
+            {
+                next(res);
+            }
+        });
+    }
+
+    // Shortest and longest budget a client can ask for.  Shorter budgets
+    // are raised to the minimum, as they can only produce timeouts.
+    static constexpr uint64_t minTimeBudgetMs = 1000;
+    static constexpr uint64_t maxTimeBudgetMs = 600000;
+
     struct PerMethod
     {
         std::vector<BaseRule*> rules;
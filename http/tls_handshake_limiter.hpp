@@ -0,0 +1,165 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+
+namespace crow
+{
+
+struct TlsHandshakeStats
+{
+    uint64_t started = 0;
+    uint64_t succeeded = 0;
+    uint64_t failed = 0;
+    // Handshakes that had to wait for a free slot before starting
+    uint64_t deferred = 0;
+    size_t maxQueueDepth = 0;
+    std::chrono::microseconds totalQueueWait{0};
+    std::chrono::microseconds maxQueueWait{0};
+    std::chrono::microseconds totalDuration{0};
+    std::chrono::microseconds maxDuration{0};
+};
+
+/**
+ * @brief Bounds how many TLS handshakes are in flight at once.
+ *
+ * The private key operation of a full handshake runs synchronously on the io
+ * thread.  When a burst of new connections arrives, letting every handshake
+ * proceed at once queues all of those operations ahead of the completion
+ * handlers of requests that are already being served.  Connections beyond
+ * the limit wait here, with their ClientHello left in the socket buffer, so
+ * existing requests only ever wait behind a handful of key operations.
+ * Connections only ask for a slot once their ClientHello has arrived, and
+ * must complete the handshake within a few seconds of getting one, so idle
+ * or slow clients can't keep the slots from everyone else.
+ */
+class TlsHandshakeLimiter
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // 0 means unlimited
+    explicit TlsHandshakeLimiter(size_t maxActiveIn) : maxActive(maxActiveIn)
+    {}
+
+    TlsHandshakeLimiter(const TlsHandshakeLimiter&) = delete;
+    TlsHandshakeLimiter(TlsHandshakeLimiter&&) = delete;
+    TlsHandshakeLimiter& operator=(const TlsHandshakeLimiter&) = delete;
+    TlsHandshakeLimiter& operator=(TlsHandshakeLimiter&&) = delete;
+    ~TlsHandshakeLimiter() = default;
+
+    static TlsHandshakeLimiter& getInstance()
+    {
+        static TlsHandshakeLimiter limiter(bmcwebTlsHandshakeConcurrency);
+        return limiter;
+    }
+
+    /**
+     * @brief Runs startHandshake now if a slot is free, otherwise once one is
+     * released.  The handshake owner must call release() exactly once when
+     * the handshake completes, successfully or not.
+     */
+    void acquire(std::function<void(Clock::time_point)>&& startHandshake)
+    {
+        if (maxActive == 0 || active < maxActive)
+        {
+            start(Clock::now(), std::move(startHandshake));
+            return;
+        }
+        stats.deferred++;
+        waiting.emplace_back(Clock::now(), std::move(startHandshake));
+        if (waiting.size() > stats.maxQueueDepth)
+        {
+            stats.maxQueueDepth = waiting.size();
+        }
+        BMCWEB_LOG_DEBUG << "TLS handshake deferred, " << waiting.size()
+                         << " waiting";
+    }
+
+    void release(Clock::time_point startedAt, bool success)
+    {
+        std::chrono::microseconds duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - startedAt);
+        stats.totalDuration += duration;
+        if (duration > stats.maxDuration)
+        {
+            stats.maxDuration = duration;
+        }
+        if (success)
+        {
+            stats.succeeded++;
+        }
+        else
+        {
+            stats.failed++;
+        }
+
+        if (active > 0)
+        {
+            active--;
+        }
+        if (waiting.empty())
+        {
+            return;
+        }
+        auto [queuedAt, startHandshake] = std::move(waiting.front());
+        waiting.pop_front();
+        start(queuedAt, std::move(startHandshake));
+    }
+
+    size_t queueDepth() const
+    {
+        return waiting.size();
+    }
+
+    size_t activeCount() const
+    {
+        return active;
+    }
+
+    size_t concurrencyLimit() const
+    {
+        return maxActive;
+    }
+
+    const TlsHandshakeStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    void start(Clock::time_point queuedAt,
+               std::function<void(Clock::time_point)>&& startHandshake)
+    {
+        Clock::time_point now = Clock::now();
+        std::chrono::microseconds wait =
+            std::chrono::duration_cast<std::chrono::microseconds>(now -
+                                                                  queuedAt);
+        stats.totalQueueWait += wait;
+        if (wait > stats.maxQueueWait)
+        {
+            stats.maxQueueWait = wait;
+        }
+        stats.started++;
+        active++;
+        startHandshake(now);
+    }
+
+    size_t maxActive;
+    size_t active = 0;
+    std::deque<
+        std::pair<Clock::time_point, std::function<void(Clock::time_point)>>>
+        waiting;
+    TlsHandshakeStats stats;
+};
+
+} // namespace crow
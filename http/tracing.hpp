@@ -0,0 +1,405 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include <nlohmann/json.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+
+/**
+ * @brief Identifies the span that work is being done under.  A zero traceId
+ * means the work isn't part of a traced request.
+ */
+struct TraceContext
+{
+    uint64_t traceId = 0;
+    uint64_t spanId = 0;
+
+    bool isValid() const
+    {
+        return traceId != 0;
+    }
+};
+
+struct SpanRecord
+{
+    uint64_t traceId = 0;
+    uint64_t spanId = 0;
+    uint64_t parentSpanId = 0;
+    std::string name;
+    std::chrono::system_clock::time_point start;
+    std::chrono::microseconds duration{0};
+    std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+/**
+ * @brief Keeps the most recent spans of traced requests in a ring, and
+ * exports them as Chrome trace event or OTLP JSON.
+ *
+ * Tracing is off unless built with request-trace-spans above 0, which is
+ * how many spans are kept; once full, the oldest are overwritten.  When on,
+ * every request gets a trace, with spans for routing, the user lookup,
+ * every D-Bus call made through dbus::utility, $expand sub-requests and
+ * serializing the response.
+ */
+class Tracer
+{
+  public:
+    explicit Tracer(size_t capacityIn) :
+        capacity(capacityIn), idGenerator(std::random_device()())
+    {}
+
+    Tracer(const Tracer&) = delete;
+    Tracer(Tracer&&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+    Tracer& operator=(Tracer&&) = delete;
+    ~Tracer() = default;
+
+    static Tracer& getInstance()
+    {
+        static Tracer tracer(bmcwebRequestTraceSpans);
+        return tracer;
+    }
+
+    bool isEnabled() const
+    {
+        return capacity > 0;
+    }
+
+    uint64_t newId()
+    {
+        uint64_t id = 0;
+        while (id == 0)
+        {
+            id = idGenerator();
+        }
+        return id;
+    }
+
+    void record(SpanRecord&& span)
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+        if (spans.size() < capacity)
+        {
+            spans.emplace_back(std::move(span));
+            return;
+        }
+        spans[next] = std::move(span);
+        next = (next + 1) % capacity;
+    }
+
+    // The recorded spans, oldest first, of one trace or of all of them
+    std::vector<const SpanRecord*>
+        getSpans(std::optional<uint64_t> traceId = std::nullopt) const
+    {
+        std::vector<const SpanRecord*> ret;
+        for (size_t i = 0; i < spans.size(); i++)
+        {
+            const SpanRecord& span = spans[(next + i) % spans.size()];
+            if (!traceId || span.traceId == *traceId)
+            {
+                ret.emplace_back(&span);
+            }
+        }
+        return ret;
+    }
+
+    static std::string hexId(uint64_t id)
+    {
+        std::ostringstream out;
+        out << std::hex << std::setw(16) << std::setfill('0') << id;
+        return out.str();
+    }
+
+    // The inverse of hexId
+    static std::optional<uint64_t> parseId(std::string_view hex)
+    {
+        uint64_t id = 0;
+        const char* end = hex.data() + hex.size();
+        auto [ptr, ec] = std::from_chars(hex.data(), end, id, 16);
+        if (hex.empty() || ec != std::errc() || ptr != end)
+        {
+            return std::nullopt;
+        }
+        return id;
+    }
+
+    // Chrome trace event format, as complete ("X") events, loadable in
+    // chrome://tracing or Perfetto.  Each trace gets its own row.
+    nlohmann::json
+        toChromeTrace(std::optional<uint64_t> traceId = std::nullopt) const
+    {
+        nlohmann::json::array_t events;
+        for (const SpanRecord* span : getSpans(traceId))
+        {
+            nlohmann::json::object_t args;
+            args["span_id"] = hexId(span->spanId);
+            if (span->parentSpanId != 0)
+            {
+                args["parent_span_id"] = hexId(span->parentSpanId);
+            }
+            for (const auto& [key, value] : span->attributes)
+            {
+                args[key] = value;
+            }
+            nlohmann::json::object_t event;
+            event["name"] = span->name;
+            event["cat"] = "bmcweb";
+            event["ph"] = "X";
+            event["ts"] = std::chrono::duration_cast<std::chrono::microseconds>(
+                              span->start.time_since_epoch())
+                              .count();
+            event["dur"] = span->duration.count();
+            event["pid"] = 1;
+            event["tid"] = hexId(span->traceId);
+            event["args"] = std::move(args);
+            events.emplace_back(std::move(event));
+        }
+        nlohmann::json::object_t trace;
+        trace["traceEvents"] = std::move(events);
+        trace["displayTimeUnit"] = "ms";
+        return trace;
+    }
+
+    // OTLP/JSON, as accepted by the OpenTelemetry collector on /v1/traces.
+    // Trace ids are 128 bits there; ours fill the low half.
+    nlohmann::json toOtlp(std::optional<uint64_t> traceId = std::nullopt) const
+    {
+        nlohmann::json::array_t otlpSpans;
+        for (const SpanRecord* span : getSpans(traceId))
+        {
+            uint64_t startNs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    span->start.time_since_epoch())
+                    .count());
+            uint64_t endNs =
+                startNs + static_cast<uint64_t>(span->duration.count()) * 1000;
+
+            nlohmann::json::array_t attributes;
+            for (const auto& [key, value] : span->attributes)
+            {
+                nlohmann::json::object_t attribute;
+                attribute["key"] = key;
+                attribute["value"]["stringValue"] = value;
+                attributes.emplace_back(std::move(attribute));
+            }
+
+            nlohmann::json::object_t otlpSpan;
+            otlpSpan["traceId"] = hexId(0) + hexId(span->traceId);
+            otlpSpan["spanId"] = hexId(span->spanId);
+            if (span->parentSpanId != 0)
+            {
+                otlpSpan["parentSpanId"] = hexId(span->parentSpanId);
+            }
+            otlpSpan["name"] = span->name;
+            // SPAN_KIND_SERVER for requests, SPAN_KIND_INTERNAL otherwise
+            otlpSpan["kind"] = span->parentSpanId == 0 ? 2 : 1;
+            otlpSpan["startTimeUnixNano"] = std::to_string(startNs);
+            otlpSpan["endTimeUnixNano"] = std::to_string(endNs);
+            otlpSpan["attributes"] = std::move(attributes);
+            otlpSpans.emplace_back(std::move(otlpSpan));
+        }
+
+        nlohmann::json::object_t serviceName;
+        serviceName["key"] = "service.name";
+        serviceName["value"]["stringValue"] = "bmcweb";
+
+        nlohmann::json::object_t scopeSpans;
+        scopeSpans["scope"]["name"] = "bmcweb";
+        scopeSpans["spans"] = std::move(otlpSpans);
+
+        nlohmann::json::object_t resourceSpans;
+        resourceSpans["resource"]["attributes"] =
+            nlohmann::json::array_t{std::move(serviceName)};
+        resourceSpans["scopeSpans"] =
+            nlohmann::json::array_t{std::move(scopeSpans)};
+
+        nlohmann::json::object_t ret;
+        ret["resourceSpans"] =
+            nlohmann::json::array_t{std::move(resourceSpans)};
+        return ret;
+    }
+
+  private:
+    size_t capacity;
+    std::vector<SpanRecord> spans;
+    // Where the next span goes once the ring is full
+    size_t next = 0;
+    std::mt19937_64 idGenerator;
+};
+
+/**
+ * @brief Makes a trace context the current one for as long as the scope
+ * lives, so spans started from there are children of it.
+ */
+class TraceScope
+{
+  public:
+    explicit TraceScope(TraceContext context) :
+        previous(std::exchange(currentContext(), context))
+    {}
+
+    ~TraceScope()
+    {
+        currentContext() = previous;
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+    static TraceContext current()
+    {
+        return currentContext();
+    }
+
+  private:
+    static TraceContext& currentContext()
+    {
+        static TraceContext context;
+        return context;
+    }
+
+    TraceContext previous;
+};
+
+/**
+ * @brief A span of work, recorded when it ends or is destroyed.  Spans are
+ * only started under a valid parent, or by startTrace, so work done outside
+ * of a traced request costs nothing.
+ */
+class Span
+{
+  public:
+    Span() = default;
+
+    explicit Span(std::string_view name,
+                  TraceContext parent = TraceScope::current())
+    {
+        if (!parent.isValid() || !Tracer::getInstance().isEnabled())
+        {
+            return;
+        }
+        begin(name, parent.traceId, parent.spanId);
+    }
+
+    static Span startTrace(std::string_view name)
+    {
+        Span span;
+        if (Tracer::getInstance().isEnabled())
+        {
+            span.begin(name, Tracer::getInstance().newId(), 0);
+        }
+        return span;
+    }
+
+    // For spans that end in a callback, which have to be copyable
+    static std::shared_ptr<Span>
+        startShared(std::string_view name,
+                    TraceContext parent = TraceScope::current())
+    {
+        if (!parent.isValid() || !Tracer::getInstance().isEnabled())
+        {
+            return nullptr;
+        }
+        return std::make_shared<Span>(name, parent);
+    }
+
+    ~Span()
+    {
+        end();
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    Span(Span&& other) noexcept :
+        record(std::move(other.record)), startedAt(other.startedAt)
+    {
+        other.record.reset();
+    }
+
+    Span& operator=(Span&& other) noexcept
+    {
+        if (this != &other)
+        {
+            end();
+            record = std::move(other.record);
+            startedAt = other.startedAt;
+            other.record.reset();
+        }
+        return *this;
+    }
+
+    bool isActive() const
+    {
+        return record.has_value();
+    }
+
+    TraceContext context() const
+    {
+        if (!record)
+        {
+            return {};
+        }
+        return {record->traceId, record->spanId};
+    }
+
+    void setAttribute(std::string_view key, std::string_view value)
+    {
+        if (record)
+        {
+            record->attributes.emplace_back(key, value);
+        }
+    }
+
+    void end()
+    {
+        if (!record)
+        {
+            return;
+        }
+        record->duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startedAt);
+        Tracer::getInstance().record(std::move(*record));
+        record.reset();
+    }
+
+  private:
+    void begin(std::string_view name, uint64_t traceId, uint64_t parentSpanId)
+    {
+        record.emplace();
+        record->traceId = traceId;
+        record->spanId = Tracer::getInstance().newId();
+        record->parentSpanId = parentSpanId;
+        record->name = name;
+        record->start = std::chrono::system_clock::now();
+        startedAt = std::chrono::steady_clock::now();
+    }
+
+    std::optional<SpanRecord> record;
+    std::chrono::steady_clock::time_point startedAt;
+};
+
+} // namespace crow
@@ -1,5 +1,7 @@
 #pragma once
 #include "http_request.hpp"
+#include "memory_accounting.hpp"
+#include "probes.hpp"
 
 #include <async_resp.hpp>
 #include <boost/asio/buffer.hpp>
@@ -28,11 +30,11 @@ struct Connection : std::enable_shared_from_this<Connection>
 {
   public:
     explicit Connection(const crow::Request& reqIn) :
-        req(reqIn.req), userdataPtr(nullptr)
+        req(reqIn), userdataPtr(nullptr)
     {}
 
     explicit Connection(const crow::Request& reqIn, std::string user) :
-        req(reqIn.req), userName{std::move(user)}, userdataPtr(nullptr)
+        req(reqIn), userName{std::move(user)}, userdataPtr(nullptr)
     {}
 
     Connection(const Connection&) = delete;
@@ -66,7 +68,8 @@ struct Connection : std::enable_shared_from_this<Connection>
         return userName;
     }
 
-    boost::beast::http::request<boost::beast::http::string_body> req;
+    // Shares the upgrade request's headers and body
+    crow::Request req;
     crow::Response res;
 
   private:
@@ -116,7 +119,8 @@ class ConnectionImpl : public Connection
 
         using bf = boost::beast::http::field;
 
-        std::string_view protocol = req[bf::sec_websocket_protocol];
+        std::string_view protocol =
+            req.getHeaderValue(bf::sec_websocket_protocol);
 
         ws.set_option(boost::beast::websocket::stream_base::decorator(
             [session{session}, protocol{std::string(protocol)}](
@@ -152,8 +156,8 @@ class ConnectionImpl : public Connection
         }));
 
         // Perform the websocket upgrade
-        ws.async_accept(req, [this, self(shared_from_this())](
-                                 boost::system::error_code ec) {
+        ws.async_accept(req.req(), [this, self(shared_from_this())](
+                                       boost::system::error_code ec) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "Error in ws.async_accept " << ec;
@@ -165,7 +169,10 @@ class ConnectionImpl : public Connection
 
     void sendBinary(const std::string_view msg) override
     {
+        BMCWEB_PROBE(websocket_send, this, msg.size(), true);
         ws.binary(true);
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("Websocket"));
         outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
                                                   boost::asio::buffer(msg)));
         doWrite();
@@ -182,6 +189,8 @@ class ConnectionImpl : public Connection
             return;
         }
         ws.binary(type == MessageType::Binary);
+        BMCWEB_PROBE(websocket_send, this, msg.size(),
+                     type == MessageType::Binary);
 
         ws.async_write(boost::asio::buffer(msg),
                        [weak(weak_from_this()), onDone{std::move(onDone)}](
@@ -202,7 +211,10 @@ class ConnectionImpl : public Connection
 
     void sendBinary(std::string&& msg) override
     {
+        BMCWEB_PROBE(websocket_send, this, msg.size(), true);
         ws.binary(true);
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("Websocket"));
         outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
                                                   boost::asio::buffer(msg)));
         doWrite();
@@ -210,7 +222,10 @@ class ConnectionImpl : public Connection
 
     void sendText(const std::string_view msg) override
     {
+        BMCWEB_PROBE(websocket_send, this, msg.size(), false);
         ws.text(true);
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("Websocket"));
         outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
                                                   boost::asio::buffer(msg)));
         doWrite();
@@ -218,7 +233,10 @@ class ConnectionImpl : public Connection
 
     void sendText(std::string&& msg) override
     {
+        BMCWEB_PROBE(websocket_send, this, msg.size(), false);
         ws.text(true);
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("Websocket"));
         outBuffer.commit(boost::asio::buffer_copy(outBuffer.prepare(msg.size()),
                                                   boost::asio::buffer(msg)));
         doWrite();
@@ -277,9 +295,13 @@ class ConnectionImpl : public Connection
         {
             return;
         }
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("Websocket"));
         ws.async_read(inBuffer, [this, self(shared_from_this())](
                                     const boost::beast::error_code& ec,
                                     size_t bytesRead) {
+            bmcweb::memory::Scope readScope(
+                bmcweb::memory::subsystem("Websocket"));
             if (ec)
             {
                 if (ec != boost::beast::websocket::error::closed)
@@ -336,6 +358,7 @@ class ConnectionImpl : public Connection
   private:
     void handleMessage(size_t bytesRead)
     {
+        BMCWEB_PROBE(websocket_receive, this, bytesRead, ws.got_binary());
         if (messageExHandler)
         {
             // Note, because of the interactions with the read buffers,
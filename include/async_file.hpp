@@ -0,0 +1,364 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/errc.hpp>
+#include <boost/system/error_code.hpp>
+#ifdef BOOST_ASIO_HAS_IO_URING
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/random_access_file.hpp>
+#include <boost/asio/read_at.hpp>
+#include <boost/asio/write_at.hpp>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace bmcweb
+{
+
+/**
+ * Reading and writing whole files without holding up the io context.
+ *
+ * When built with io_uring support (the io-uring option), the I/O is handed
+ * to the kernel and completes on the io context like any socket operation.
+ * Otherwise, the file is read or written in chunks, each one run as its own
+ * step on the io context, so other connections get served between them on
+ * slow flash instead of waiting for the whole file.  bmcweb is built without
+ * asio thread support, so there is no thread pool to hand the I/O to.
+ *
+ * Handlers are always called from the io context, never from within the
+ * call that started the operation.
+ */
+
+using ReadFileHandler =
+    std::function<void(const boost::system::error_code&, std::string&&)>;
+using WriteFileHandler = std::function<void(const boost::system::error_code&)>;
+
+namespace async_file
+{
+
+// How much the chunked fallback reads or writes per step
+constexpr size_t chunkSize = 65536;
+
+inline boost::system::error_code lastError()
+{
+    return {errno != 0 ? errno : EIO, boost::system::generic_category()};
+}
+
+// Writes go to a file next to the target, which then replaces it, so
+// readers never see a partly written file
+inline std::filesystem::path temporaryPath(const std::filesystem::path& path)
+{
+    static uint64_t counter = 0;
+    std::filesystem::path tmp = path;
+    tmp += ".tmp" + std::to_string(counter++);
+    return tmp;
+}
+
+// Whether path is one written to by temporaryPath, rather than a file of its
+// own
+inline bool isTemporaryPath(const std::filesystem::path& path)
+{
+    return path.extension().string().starts_with(".tmp");
+}
+
+// The temporary file of one write, removed again if the write never
+// finishes, such as when it is still in flight as the io context goes away
+class TemporaryFile
+{
+  public:
+    explicit TemporaryFile(const std::filesystem::path& target) :
+        path(temporaryPath(target))
+    {}
+
+    ~TemporaryFile()
+    {
+        // Already gone once the write renamed it over the target
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    TemporaryFile(const TemporaryFile&) = delete;
+    TemporaryFile(TemporaryFile&&) = delete;
+    TemporaryFile& operator=(const TemporaryFile&) = delete;
+    TemporaryFile& operator=(TemporaryFile&&) = delete;
+
+    std::filesystem::path path;
+};
+
+inline boost::system::error_code
+    finishWrite(const std::filesystem::path& tmp,
+                const std::filesystem::path& path,
+                boost::system::error_code ec)
+{
+    std::error_code fsEc;
+    if (!ec)
+    {
+        std::filesystem::rename(tmp, path, fsEc);
+        if (!fsEc)
+        {
+            return ec;
+        }
+        ec = boost::system::error_code(fsEc.value(),
+                                       boost::system::generic_category());
+    }
+    std::filesystem::remove(tmp, fsEc);
+    return ec;
+}
+
+#ifndef BOOST_ASIO_HAS_IO_URING
+class ChunkedReader : public std::enable_shared_from_this<ChunkedReader>
+{
+  public:
+    ChunkedReader(boost::asio::io_context& iocIn,
+                  const std::filesystem::path& path, uint64_t maxSizeIn,
+                  ReadFileHandler&& handlerIn) :
+        ioc(iocIn),
+        file(path, std::ios::in | std::ios::binary), maxSize(maxSizeIn),
+        handler(std::move(handlerIn))
+    {}
+
+    void start()
+    {
+        if (!file.is_open())
+        {
+            fail(lastError());
+            return;
+        }
+        step();
+    }
+
+  private:
+    void step()
+    {
+        boost::asio::post(ioc,
+                          [self(shared_from_this())] { self->readChunk(); });
+    }
+
+    void readChunk()
+    {
+        size_t oldSize = data.size();
+        data.resize(oldSize + chunkSize);
+        file.read(&data[oldSize], static_cast<std::streamsize>(chunkSize));
+        data.resize(oldSize + static_cast<size_t>(file.gcount()));
+        if (file.bad())
+        {
+            fail(lastError());
+            return;
+        }
+        if (data.size() > maxSize)
+        {
+            fail(boost::system::errc::make_error_code(
+                boost::system::errc::file_too_large));
+            return;
+        }
+        if (file.eof())
+        {
+            handler(boost::system::error_code(), std::move(data));
+            return;
+        }
+        step();
+    }
+
+    void fail(const boost::system::error_code& ec)
+    {
+        boost::asio::post(ioc, [handler{std::move(handler)}, ec] {
+            handler(ec, std::string());
+        });
+    }
+
+    boost::asio::io_context& ioc;
+    std::ifstream file;
+    uint64_t maxSize;
+    std::string data;
+    ReadFileHandler handler;
+};
+
+class ChunkedWriter : public std::enable_shared_from_this<ChunkedWriter>
+{
+  public:
+    ChunkedWriter(boost::asio::io_context& iocIn,
+                  const std::filesystem::path& pathIn, std::string&& dataIn,
+                  WriteFileHandler&& handlerIn) :
+        ioc(iocIn),
+        path(pathIn), tmp(pathIn), data(std::move(dataIn)),
+        handler(std::move(handlerIn))
+    {}
+
+    void start(std::optional<std::filesystem::perms> permissions)
+    {
+        file.open(tmp.path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            finish(lastError());
+            return;
+        }
+        if (permissions)
+        {
+            std::error_code ec;
+            std::filesystem::permissions(tmp.path, *permissions, ec);
+        }
+        step();
+    }
+
+  private:
+    void step()
+    {
+        boost::asio::post(ioc,
+                          [self(shared_from_this())] { self->writeChunk(); });
+    }
+
+    void writeChunk()
+    {
+        size_t chunk = std::min(chunkSize, data.size() - written);
+        file.write(&data[written], static_cast<std::streamsize>(chunk));
+        written += chunk;
+        if (!file.good())
+        {
+            finish(lastError());
+            return;
+        }
+        if (written < data.size())
+        {
+            step();
+            return;
+        }
+        file.close();
+        finish(file.fail() ? lastError() : boost::system::error_code());
+    }
+
+    void finish(const boost::system::error_code& ec)
+    {
+        if (file.is_open())
+        {
+            file.close();
+        }
+        boost::asio::post(
+            ioc, [handler{std::move(handler)},
+                  ec{finishWrite(tmp.path, path, ec)}] { handler(ec); });
+    }
+
+    boost::asio::io_context& ioc;
+    std::filesystem::path path;
+    TemporaryFile tmp;
+    std::ofstream file;
+    std::string data;
+    size_t written = 0;
+    WriteFileHandler handler;
+};
+#endif
+
+} // namespace async_file
+
+/**
+ * @brief Reads all of the file at path, and calls handler with its contents.
+ * Files larger than maxSize fail with file_too_large.
+ */
+inline void asyncReadFile(boost::asio::io_context& ioc,
+                          const std::filesystem::path& path, uint64_t maxSize,
+                          ReadFileHandler&& handler)
+{
+#ifdef BOOST_ASIO_HAS_IO_URING
+    boost::system::error_code ec;
+    auto file = std::make_shared<boost::asio::random_access_file>(ioc);
+    file->open(path.string(), boost::asio::file_base::read_only, ec);
+    uint64_t size = 0;
+    if (!ec)
+    {
+        size = file->size(ec);
+    }
+    if (!ec && size > maxSize)
+    {
+        ec = boost::system::errc::make_error_code(
+            boost::system::errc::file_too_large);
+    }
+    if (ec)
+    {
+        boost::asio::post(ioc, [handler{std::move(handler)}, ec] {
+            handler(ec, std::string());
+        });
+        return;
+    }
+    auto data = std::make_shared<std::string>(static_cast<size_t>(size), '\0');
+    boost::asio::async_read_at(
+        *file, 0, boost::asio::buffer(*data),
+        [file, data, handler{std::move(handler)}](
+            boost::system::error_code readEc, size_t bytesRead) {
+        // The file got shorter since it was opened
+        if (readEc == boost::asio::error::eof)
+        {
+            readEc = {};
+        }
+        data->resize(bytesRead);
+        handler(readEc, std::move(*data));
+    });
+#else
+    std::make_shared<async_file::ChunkedReader>(ioc, path, maxSize,
+                                                std::move(handler))
+        ->start();
+#endif
+}
+
+/**
+ * @brief Replaces the file at path with data, and calls handler once done.
+ * The new file is given permissions, if set, before any data is written.
+ */
+inline void
+    asyncWriteFile(boost::asio::io_context& ioc,
+                   const std::filesystem::path& path, std::string&& data,
+                   std::optional<std::filesystem::perms> permissions,
+                   WriteFileHandler&& handler)
+{
+    BMCWEB_LOG_DEBUG << "Writing " << data.size() << " bytes to " << path;
+#ifdef BOOST_ASIO_HAS_IO_URING
+    auto tmp = std::make_shared<async_file::TemporaryFile>(path);
+    boost::system::error_code ec;
+    auto file = std::make_shared<boost::asio::random_access_file>(ioc);
+    file->open(tmp->path.string(),
+               boost::asio::file_base::write_only |
+                   boost::asio::file_base::create |
+                   boost::asio::file_base::truncate,
+               ec);
+    if (!ec && permissions)
+    {
+        std::error_code fsEc;
+        std::filesystem::permissions(tmp->path, *permissions, fsEc);
+    }
+    if (ec)
+    {
+        ec = async_file::finishWrite(tmp->path, path, ec);
+        boost::asio::post(ioc,
+                          [handler{std::move(handler)}, ec] { handler(ec); });
+        return;
+    }
+    auto buffer = std::make_shared<std::string>(std::move(data));
+    boost::asio::async_write_at(
+        *file, 0, boost::asio::buffer(*buffer),
+        [file, buffer, path, tmp, handler{std::move(handler)}](
+            const boost::system::error_code& writeEc, size_t /*written*/) {
+        boost::system::error_code closeEc;
+        file->close(closeEc);
+        handler(async_file::finishWrite(tmp->path, path,
+                                        writeEc ? writeEc : closeEc));
+    });
+#else
+    std::make_shared<async_file::ChunkedWriter>(ioc, path, std::move(data),
+                                                std::move(handler))
+        ->start(permissions);
+#endif
+}
+
+} // namespace bmcweb
@@ -229,7 +229,7 @@ inline void auditEvent(const crow::Request& req, const std::string& userName,
     std::string detail;
     if (wantDetail(req))
     {
-        detail = req.body.substr(0, maxBuf) + " ";
+        detail = req.body().substr(0, maxBuf) + " ";
     }
 
     if (!detail.empty())
@@ -78,15 +78,12 @@ static std::shared_ptr<persistent_data::UserSession>
         return nullptr;
     }
 
-    // TODO(ed) generateUserSession is a little expensive for basic
-    // auth, as it generates some random identifiers that will never be
-    // used.  This should have a "fast" path for when user tokens aren't
-    // needed.
-    // This whole flow needs to be revisited anyway, as we can't be
+    // Basic auth never hands out tokens, so only an ephemeral identity is
+    // needed for the lifetime of this request.
+    // TODO(ed) This whole flow needs to be revisited anyway, as we can't be
     // calling directly into pam for every request
-    return persistent_data::SessionStore::getInstance().generateUserSession(
-        user, clientIp, std::nullopt,
-        persistent_data::PersistenceType::SINGLE_REQUEST, isConfigureSelfOnly);
+    return persistent_data::SessionStore::generateEphemeralSession(
+        user, clientIp, isConfigureSelfOnly);
 }
 #endif
 
@@ -266,6 +263,20 @@ static std::shared_ptr<persistent_data::UserSession>
     return false;
 }
 
+// Whether a request brings credentials of its own, which are then the only
+// ones it can be authenticated with
+inline bool
+    carriesCredentials(const boost::beast::http::header<true>& reqHeader)
+{
+    if (!reqHeader[boost::beast::http::field::authorization].empty() ||
+        !reqHeader["X-Auth-Token"].empty())
+    {
+        return true;
+    }
+    std::string_view cookie = reqHeader[boost::beast::http::field::cookie];
+    return cookie.find("SESSION=") != std::string_view::npos;
+}
+
 [[maybe_unused]] static std::shared_ptr<persistent_data::UserSession>
     authenticate(
         const boost::asio::ip::address& ipAddress [[maybe_unused]],
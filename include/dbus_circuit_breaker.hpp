@@ -0,0 +1,198 @@
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "logging.hpp"
+
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bmcweb
+{
+
+/**
+ * @brief Tracks which D-Bus services stopped answering, and fails calls to
+ * them fast instead of letting each wait out the method call timeout.
+ *
+ * After bmcwebDbusCircuitBreakerThreshold consecutive timed out calls to a
+ * service its circuit opens: calls to it fail immediately, and handlers
+ * reporting the failure answer 503 with a Retry-After of the time left.
+ * Once that time has passed, a single call is let through as a probe.  If
+ * it gets any reply the circuit closes, otherwise it opens again.
+ */
+class DbusCircuitBreaker
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::seconds openDuration{30};
+
+    DbusCircuitBreaker(const DbusCircuitBreaker&) = delete;
+    DbusCircuitBreaker(DbusCircuitBreaker&&) = delete;
+    DbusCircuitBreaker& operator=(const DbusCircuitBreaker&) = delete;
+    DbusCircuitBreaker& operator=(DbusCircuitBreaker&&) = delete;
+    ~DbusCircuitBreaker() = default;
+
+    static DbusCircuitBreaker& getInstance()
+    {
+        static DbusCircuitBreaker breaker;
+        return breaker;
+    }
+
+    static constexpr uint64_t callTimeoutUs()
+    {
+        return static_cast<uint64_t>(bmcwebDbusCallTimeoutSeconds) *
+               1000000U;
+    }
+
+    /**
+     * @brief Whether a call to service may be made now.  While the circuit
+     * is half open this hands out the one probe call.
+     */
+    bool allowCall(const std::string& service,
+                   Clock::time_point now = Clock::now())
+    {
+        auto it = services.find(service);
+        if (it == services.end() || !it->second.openUntil)
+        {
+            return true;
+        }
+        State& state = it->second;
+        if (now < *state.openUntil || state.probeInFlight)
+        {
+            fastFailures++;
+            return false;
+        }
+        BMCWEB_LOG_INFO << "Probing unresponsive D-Bus service " << service;
+        state.probeInFlight = true;
+        return true;
+    }
+
+    /**
+     * @brief Whether the probe of service has been handed out and not yet
+     * answered
+     */
+    bool probing(const std::string& service) const
+    {
+        auto it = services.find(service);
+        return it != services.end() && it->second.probeInFlight;
+    }
+
+    /**
+     * @brief Hands the probe of service back unanswered, without counting
+     * against the service, so that the next call probes it instead.  For a
+     * probe whose timeout was cut short by the caller running out of time.
+     */
+    void cancelProbe(const std::string& service)
+    {
+        auto it = services.find(service);
+        if (it != services.end())
+        {
+            it->second.probeInFlight = false;
+        }
+    }
+
+    void recordResult(const std::string& service,
+                      const boost::system::error_code& ec,
+                      Clock::time_point now = Clock::now())
+    {
+        if (bmcwebDbusCircuitBreakerThreshold == 0)
+        {
+            return;
+        }
+        if (ec != boost::system::errc::timed_out)
+        {
+            // Any reply, even an error, means the service is responsive
+            auto it = services.find(service);
+            if (it != services.end())
+            {
+                if (it->second.openUntil)
+                {
+                    BMCWEB_LOG_INFO << "D-Bus service " << service
+                                    << " is responsive again";
+                }
+                services.erase(it);
+            }
+            return;
+        }
+
+        State& state = services[service];
+        state.consecutiveTimeouts++;
+        if (state.probeInFlight ||
+            state.consecutiveTimeouts >= bmcwebDbusCircuitBreakerThreshold)
+        {
+            if (!state.openUntil || state.probeInFlight)
+            {
+                BMCWEB_LOG_ERROR << "D-Bus service " << service
+                                 << " is not responding, failing calls to it"
+                                 << " for " << openDuration.count() << "s";
+                timesOpened++;
+            }
+            state.openUntil = now + openDuration;
+            state.probeInFlight = false;
+        }
+    }
+
+    /**
+     * @brief Seconds until the next probe of service, for Retry-After
+     */
+    std::chrono::seconds retryAfter(const std::string& service) const
+    {
+        auto it = services.find(service);
+        if (it == services.end() || !it->second.openUntil)
+        {
+            return std::chrono::seconds(1);
+        }
+        auto left = std::chrono::ceil<std::chrono::seconds>(
+            *it->second.openUntil - Clock::now());
+        return std::max(left, std::chrono::seconds(1));
+    }
+
+    std::vector<std::string> openCircuits() const
+    {
+        std::vector<std::string> open;
+        for (const auto& [service, state] : services)
+        {
+            if (state.openUntil)
+            {
+                open.emplace_back(service);
+            }
+        }
+        std::ranges::sort(open);
+        return open;
+    }
+
+    uint64_t fastFailureCount() const
+    {
+        return fastFailures;
+    }
+
+    uint64_t openCount() const
+    {
+        return timesOpened;
+    }
+
+  private:
+    DbusCircuitBreaker() = default;
+
+    struct State
+    {
+        size_t consecutiveTimeouts = 0;
+        // Set while the circuit is open
+        std::optional<Clock::time_point> openUntil;
+        bool probeInFlight = false;
+    };
+
+    std::unordered_map<std::string, State> services;
+    uint64_t fastFailures = 0;
+    uint64_t timesOpened = 0;
+};
+
+} // namespace bmcweb
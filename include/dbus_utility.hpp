@@ -15,18 +15,29 @@
  */
 #pragma once
 
+#include "cancellation.hpp"
+#include "dbus_circuit_breaker.hpp"
 #include "dbus_singleton.hpp"
 #include "logging.hpp"
+#include "memory_accounting.hpp"
+#include "probes.hpp"
+#include "tracing.hpp"
 
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/system/error_code.hpp> // IWYU pragma: keep
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <regex>
 #include <span>
 #include <sstream>
@@ -148,12 +159,198 @@ inline bool getNthStringFromPath(const std::string& path, int index,
     return count >= index;
 }
 
+/**
+ * @brief async_method_call, guarded by the D-Bus circuit breaker
+ *
+ * The call times out after bmcwebDbusCallTimeoutSeconds.  While service is
+ * not responding, no call is made: callback is run from the io context with
+ * resource_unavailable_try_again, and the cancellation token of the request
+ * is marked, so that routing turns the error reported for it into a 503.
+ *
+ * If the client of the request the call is made for has gone away, the call
+ * isn't made, and callback is run with operation_aborted instead.  The same
+ * happens once the time budget of the request runs out; calls made before
+ * then time out no later than it does, without counting against service.
+ */
+template <typename ResponseType, typename... Args>
+inline void asyncMethodCall(
+    std::function<void(const boost::system::error_code&,
+                       const ResponseType&)>&& callback,
+    const std::string& service, const std::string& path,
+    const std::string& interface, const std::string& method,
+    const Args&... args)
+{
+    std::shared_ptr<crow::CancellationToken> cancellation =
+        crow::CancellationScope::current();
+    bmcweb::memory::Tag memoryTag = bmcweb::memory::Scope::current();
+    crow::TraceContext traceContext = crow::TraceScope::current();
+    if (cancellation && cancellation->isCancelled())
+    {
+        BMCWEB_LOG_DEBUG << "Request is cancelled, not calling " << method
+                         << " on " << service;
+        cancellation->markWorkSkipped();
+        // Callers still hear back, so that whatever waits on the call
+        // doesn't take no answer for an empty one
+        boost::asio::post(crow::connections::systemBus->get_io_context(),
+                          [callback{std::move(callback)}, cancellation,
+                           memoryTag, traceContext]() {
+            crow::CancellationScope cancellationScope(cancellation);
+            bmcweb::memory::Scope memoryScope(memoryTag);
+            crow::TraceScope traceScope(traceContext);
+            callback(boost::asio::error::operation_aborted, ResponseType{});
+        });
+        return;
+    }
+    std::shared_ptr<crow::Span> span = crow::Span::startShared("dbus " +
+                                                               method);
+    if (span)
+    {
+        span->setAttribute("dbus.destination", service);
+        span->setAttribute("dbus.path", path);
+        span->setAttribute("dbus.interface", interface);
+        span->setAttribute("dbus.member", method);
+    }
+    if (!bmcweb::DbusCircuitBreaker::getInstance().allowCall(service))
+    {
+        if (span)
+        {
+            span->setAttribute("error", "circuit open");
+            span->end();
+        }
+        boost::asio::post(crow::connections::systemBus->get_io_context(),
+                          [callback{std::move(callback)}, service,
+                           cancellation, memoryTag, traceContext]() {
+            crow::CancellationScope cancellationScope(cancellation);
+            bmcweb::memory::Scope memoryScope(memoryTag);
+            crow::TraceScope traceScope(traceContext);
+            if (cancellation && cancellation->isCancelled())
+            {
+                cancellation->markWorkSkipped();
+                callback(boost::asio::error::operation_aborted,
+                         ResponseType{});
+                return;
+            }
+            if (cancellation)
+            {
+                cancellation->markServiceUnavailable(
+                    bmcweb::DbusCircuitBreaker::getInstance().retryAfter(
+                        service));
+            }
+            callback(boost::system::errc::make_error_code(
+                         boost::system::errc::resource_unavailable_try_again),
+                     ResponseType{});
+        });
+        return;
+    }
+    bool isProbe = bmcweb::DbusCircuitBreaker::getInstance().probing(service);
+    uint64_t timeoutUs = bmcweb::DbusCircuitBreaker::callTimeoutUs();
+    bool timeoutShortened = false;
+    if (cancellation)
+    {
+        std::optional<crow::CancellationToken::Clock::duration> timeLeft =
+            cancellation->timeLeft();
+        if (timeLeft)
+        {
+            uint64_t timeLeftUs = static_cast<uint64_t>(
+                std::chrono::ceil<std::chrono::microseconds>(*timeLeft)
+                    .count());
+            if (timeLeftUs < timeoutUs)
+            {
+                timeoutUs = std::max<uint64_t>(timeLeftUs, 1);
+                timeoutShortened = true;
+            }
+        }
+    }
+    uint64_t callId = bmcweb::probes::nextCallId();
+    BMCWEB_PROBE(dbus_call_start, callId, service.c_str(), path.c_str(),
+                 interface.c_str(), method.c_str());
+    crow::connections::systemBus->async_method_call_timed(
+        [callback{std::move(callback)}, service, cancellation, memoryTag,
+         traceContext, span, isProbe, timeoutShortened,
+         callId](const boost::system::error_code& ec,
+                 const ResponseType& response) {
+        BMCWEB_PROBE(dbus_call_reply, callId, ec.value());
+        if (span)
+        {
+            if (ec)
+            {
+                span->setAttribute("error", ec.message());
+            }
+            span->end();
+        }
+        // Running out of time budget says nothing about the service, but a
+        // probe has to be handed back for another call to make
+        bmcweb::DbusCircuitBreaker& breaker =
+            bmcweb::DbusCircuitBreaker::getInstance();
+        if (!timeoutShortened || ec != boost::system::errc::timed_out)
+        {
+            breaker.recordResult(service, ec);
+        }
+        else if (isProbe)
+        {
+            breaker.cancelProbe(service);
+        }
+        crow::CancellationScope cancellationScope(cancellation);
+        bmcweb::memory::Scope memoryScope(memoryTag);
+        crow::TraceScope traceScope(traceContext);
+        if (cancellation && cancellation->isCancelled())
+        {
+            cancellation->markWorkSkipped();
+            callback(boost::asio::error::operation_aborted, ResponseType{});
+            return;
+        }
+        callback(ec, response);
+    },
+        service, path, interface, method, timeoutUs, args...);
+}
+
+template <typename PropertyType>
+inline void getProperty(const std::string& service, const std::string& path,
+                        const std::string& interface,
+                        const std::string& property,
+                        std::function<void(const boost::system::error_code&,
+                                           const PropertyType&)>&& callback)
+{
+    asyncMethodCall<std::variant<PropertyType>>(
+        [callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const std::variant<PropertyType>& value) {
+        if (ec)
+        {
+            callback(ec, PropertyType{});
+            return;
+        }
+        const PropertyType* typed = std::get_if<PropertyType>(&value);
+        if (typed == nullptr)
+        {
+            callback(boost::system::errc::make_error_code(
+                         boost::system::errc::invalid_argument),
+                     PropertyType{});
+            return;
+        }
+        callback(ec, *typed);
+    },
+        service, path, "org.freedesktop.DBus.Properties", "Get", interface,
+        property);
+}
+
+inline void getAllProperties(
+    const std::string& service, const std::string& path,
+    const std::string& interface,
+    std::function<void(const boost::system::error_code&,
+                       const DBusPropertiesMap&)>&& callback)
+{
+    asyncMethodCall<DBusPropertiesMap>(std::move(callback), service, path,
+                                       "org.freedesktop.DBus.Properties",
+                                       "GetAll", interface);
+}
+
 template <typename Callback>
 inline void checkDbusPathExists(const std::string& path, Callback&& callback)
 {
-    crow::connections::systemBus->async_method_call(
+    asyncMethodCall<MapperGetObject>(
         [callback{std::forward<Callback>(callback)}](
-            const boost::system::error_code ec,
+            const boost::system::error_code& ec,
             const dbus::utility::MapperGetObject& objectNames) {
         callback(!ec && !objectNames.empty());
     },
@@ -169,11 +366,8 @@ inline void
                std::function<void(const boost::system::error_code&,
                                   const MapperGetSubTreeResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code ec,
-            const MapperGetSubTreeResponse& subtree) { callback(ec, subtree); },
-        "xyz.openbmc_project.ObjectMapper",
+    asyncMethodCall<MapperGetSubTreeResponse>(
+        std::move(callback), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetSubTree", path, depth,
         interfaces);
@@ -185,13 +379,8 @@ inline void getSubTreePaths(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code ec,
-            const MapperGetSubTreePathsResponse& subtreePaths) {
-        callback(ec, subtreePaths);
-    },
-        "xyz.openbmc_project.ObjectMapper",
+    asyncMethodCall<MapperGetSubTreePathsResponse>(
+        std::move(callback), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths", path, depth,
         interfaces);
@@ -202,13 +391,9 @@ inline void getAssociationEndPoints(
     std::function<void(const boost::system::error_code&,
                        const MapperEndPoints&)>&& callback)
 {
-    sdbusplus::asio::getProperty<MapperEndPoints>(
-        *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper", path,
-        "xyz.openbmc_project.Association", "endpoints",
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const MapperEndPoints& endpoints) {
-        callback(ec, endpoints);
-    });
+    getProperty<MapperEndPoints>("xyz.openbmc_project.ObjectMapper", path,
+                                 "xyz.openbmc_project.Association",
+                                 "endpoints", std::move(callback));
 }
 
 inline void getAssociatedSubTree(
@@ -218,11 +403,8 @@ inline void getAssociatedSubTree(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreeResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const MapperGetSubTreeResponse& subtree) { callback(ec, subtree); },
-        "xyz.openbmc_project.ObjectMapper",
+    asyncMethodCall<MapperGetSubTreeResponse>(
+        std::move(callback), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetAssociatedSubTree",
         associatedPath, path, depth, interfaces);
@@ -235,13 +417,8 @@ inline void getAssociatedSubTreePaths(
     std::function<void(const boost::system::error_code&,
                        const MapperGetSubTreePathsResponse&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const MapperGetSubTreePathsResponse& subtreePaths) {
-        callback(ec, subtreePaths);
-    },
-        "xyz.openbmc_project.ObjectMapper",
+    asyncMethodCall<MapperGetSubTreePathsResponse>(
+        std::move(callback), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetAssociatedSubTreePaths",
         associatedPath, path, depth, interfaces);
@@ -253,12 +430,8 @@ inline void
                   std::function<void(const boost::system::error_code&,
                                      const MapperGetObject&)>&& callback)
 {
-    crow::connections::systemBus->async_method_call(
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const MapperGetObject& object) {
-        callback(ec, object);
-    },
-        "xyz.openbmc_project.ObjectMapper",
+    asyncMethodCall<MapperGetObject>(
+        std::move(callback), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetObject", path, interfaces);
 }
@@ -268,13 +441,9 @@ inline void
                        std::function<void(const boost::system::error_code&,
                                           const AssociationList&)>&& callback)
 {
-    sdbusplus::asio::getProperty<AssociationList>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Association.Definitions", "Associations",
-        [callback{std::move(callback)}](const boost::system::error_code& ec,
-                                        const AssociationList& associations) {
-        callback(ec, associations);
-    });
+    getProperty<AssociationList>(service, path,
+                                 "xyz.openbmc_project.Association.Definitions",
+                                 "Associations", std::move(callback));
 }
 
 } // namespace utility
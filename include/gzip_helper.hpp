@@ -2,64 +2,147 @@
 
 #include <zlib.h>
 
-#include <cstring>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
-inline bool gzipInflate(const std::string& compressedBytes,
-                        std::string& uncompressedBytes)
+namespace bmcweb
 {
-    if (compressedBytes.empty())
-    {
-        uncompressedBytes = compressedBytes;
-        return true;
-    }
-
-    uncompressedBytes.clear();
-
-    unsigned half_length = compressedBytes.size() / 2;
-
-    z_stream strm{};
 
-    // The following line is nolint because we're declaring away constness.
-    // It's not clear why the input buffers on zlib aren't const, so this is a
-    // bit of a cheat for the moment
-    strm.next_in = (Bytef*)compressedBytes.data(); // NOLINT
-    strm.avail_in = compressedBytes.size();
-    strm.total_out = 0;
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-
-    bool done = false;
+/**
+ * @brief Incrementally inflates a gzip or zlib (HTTP "deflate") stream.
+ *
+ * Compressed data can be handed over in pieces of any size, as it arrives;
+ * each piece is inflated onto the end of the output before write returns.
+ */
+class Inflater
+{
+  public:
+    enum class Format
+    {
+        Gzip,
+        Deflate,
+    };
 
-    if (inflateInit2(&strm, (16 + MAX_WBITS)) != Z_OK)
+    explicit Inflater(Format format)
     {
-        return false;
+        int windowBits = format == Format::Gzip ? 16 + MAX_WBITS : MAX_WBITS;
+        initialized = inflateInit2(&strm, windowBits) == Z_OK;
     }
 
-    while (!done)
+    ~Inflater()
     {
-        // If our output buffer is too small
-        if (strm.total_out >= uncompressedBytes.size())
+        if (initialized)
         {
-            uncompressedBytes.resize(uncompressedBytes.size() + half_length);
+            inflateEnd(&strm);
         }
+    }
 
-        strm.next_out =
-            (Bytef*)(uncompressedBytes.data() + strm.total_out); // NOLINT
-        strm.avail_out =
-            ((uLong)uncompressedBytes.size() - strm.total_out);  // NOLINT
+    Inflater(const Inflater&) = delete;
+    Inflater(Inflater&&) = delete;
+    Inflater& operator=(const Inflater&) = delete;
+    Inflater& operator=(Inflater&&) = delete;
 
-        // Inflate another chunk.
-        int err = inflate(&strm, Z_SYNC_FLUSH);
-        if (err == Z_STREAM_END)
+    /**
+     * @brief Inflates compressed onto the end of out.
+     *
+     * @return false if the data is corrupt, continues past the end of the
+     * stream, or out would grow beyond maxSize.
+     */
+    bool write(std::string_view compressed, std::string& out, size_t maxSize)
+    {
+        if (!initialized || failed)
         {
-            done = true;
+            return false;
         }
-        else if (err != Z_OK)
+        if (compressed.empty())
         {
-            break;
+            return true;
         }
+        if (finished())
+        {
+            failed = true;
+            return false;
+        }
+
+        // The input buffers on zlib aren't const, but inflate doesn't write
+        // to them
+        strm.next_in = (Bytef*)compressed.data(); // NOLINT
+        strm.avail_in = static_cast<uInt>(compressed.size());
+
+        while (strm.avail_in > 0)
+        {
+            size_t oldSize = out.size();
+            // Room for one byte more than allowed, so input that only holds
+            // the trailer of the stream can still be taken at maxSize
+            size_t chunk = std::min(chunkSize, maxSize - oldSize + 1);
+            out.resize(oldSize + chunk);
+            strm.next_out = (Bytef*)&out[oldSize]; // NOLINT
+            strm.avail_out = static_cast<uInt>(chunk);
+
+            int err = inflate(&strm, Z_NO_FLUSH);
+            out.resize(oldSize + chunk - strm.avail_out);
+            if (out.size() > maxSize)
+            {
+                out.resize(maxSize);
+                failed = true;
+                return false;
+            }
+            if (err == Z_STREAM_END)
+            {
+                streamEnded = true;
+                if (strm.avail_in > 0)
+                {
+                    // Trailing data after the end of the stream
+                    failed = true;
+                    return false;
+                }
+                break;
+            }
+            if (err != Z_OK)
+            {
+                failed = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether the whole stream, including its trailer, has been seen
+    bool finished() const
+    {
+        return streamEnded;
+    }
+
+    uint64_t totalIn() const
+    {
+        return strm.total_in;
+    }
+
+  private:
+    static constexpr size_t chunkSize = 16384;
+
+    z_stream strm{};
+    bool initialized = false;
+    bool failed = false;
+    bool streamEnded = false;
+};
+
+} // namespace bmcweb
+
+inline bool gzipInflate(const std::string& compressedBytes,
+                        std::string& uncompressedBytes)
+{
+    uncompressedBytes.clear();
+    if (compressedBytes.empty())
+    {
+        return true;
     }
 
-    return inflateEnd(&strm) == Z_OK;
+    bmcweb::Inflater inflater(bmcweb::Inflater::Format::Gzip);
+    return inflater.write(compressedBytes, uncompressedBytes,
+                          uncompressedBytes.max_size()) &&
+           inflater.finished();
 }
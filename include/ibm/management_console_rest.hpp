@@ -1,5 +1,7 @@
 #pragma once
 
+#include "async_file.hpp"
+#include "dbus_singleton.hpp"
 #include "multipart_parser.hpp"
 
 #include <app.hpp>
@@ -114,7 +116,6 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
             "File size exceeds maximum allowed size[25MB]";
         return false;
     }
-    std::ofstream file;
     std::filesystem::path loc(configFilePath);
 
     // Get the current size of the savearea directory
@@ -132,6 +133,12 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
     std::uintmax_t saveAreaDirSize = 0;
     for (const auto& it : iter)
     {
+        // Files of uploads still being written aren't counted until they are
+        // in place
+        if (bmcweb::async_file::isTemporaryPath(it.path()))
+        {
+            continue;
+        }
         if (!std::filesystem::is_directory(it, ec))
         {
             if (ec)
@@ -220,41 +227,42 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
         return false;
     }
 
-    file.open(loc, std::ofstream::out);
-
     // set the permission of the file to 600
     std::filesystem::perms permission = std::filesystem::perms::owner_write |
                                         std::filesystem::perms::owner_read;
-    std::filesystem::permissions(loc, permission);
-
-    if (file.fail())
-    {
-        BMCWEB_LOG_DEBUG << "Error while opening the file for writing";
-        asyncResp->res.result(
-            boost::beast::http::status::internal_server_error);
-        asyncResp->res.jsonValue["Description"] =
-            "Error while creating the file";
-        return false;
-    }
-    file << data;
-    std::string origin = "/ibm/v1/Host/ConfigFiles/" + fileID;
-    // Push an event
-    if (fileExists)
-    {
-        BMCWEB_LOG_DEBUG << "config file is updated";
-        asyncResp->res.jsonValue["Description"] = "File Updated";
+    bmcweb::asyncWriteFile(
+        crow::connections::systemBus->get_io_context(), loc, std::string(data),
+        permission,
+        [asyncResp, fileID,
+         fileExists](const boost::system::error_code& writeEc) {
+        if (writeEc)
+        {
+            BMCWEB_LOG_DEBUG << "Error while writing the file: " << writeEc;
+            asyncResp->res.result(
+                boost::beast::http::status::internal_server_error);
+            asyncResp->res.jsonValue["Description"] =
+                "Error while creating the file";
+            return;
+        }
+        std::string origin = "/ibm/v1/Host/ConfigFiles/" + fileID;
+        // Push an event
+        if (fileExists)
+        {
+            BMCWEB_LOG_DEBUG << "config file is updated";
+            asyncResp->res.jsonValue["Description"] = "File Updated";
 
-        redfish::EventServiceManager::getInstance().sendEvent(
-            redfish::messages::resourceChanged(), origin, "IBMConfigFile");
-    }
-    else
-    {
-        BMCWEB_LOG_DEBUG << "config file is created";
-        asyncResp->res.jsonValue["Description"] = "File Created";
+            redfish::EventServiceManager::getInstance().sendEvent(
+                redfish::messages::resourceChanged(), origin, "IBMConfigFile");
+        }
+        else
+        {
+            BMCWEB_LOG_DEBUG << "config file is created";
+            asyncResp->res.jsonValue["Description"] = "File Created";
 
-        redfish::EventServiceManager::getInstance().sendEvent(
-            redfish::messages::resourceCreated(), origin, "IBMConfigFile");
-    }
+            redfish::EventServiceManager::getInstance().sendEvent(
+                redfish::messages::resourceCreated(), origin, "IBMConfigFile");
+        }
+    });
     return true;
 }
 
@@ -367,7 +375,7 @@ inline void
     else
     {
         // Single file upload
-        const std::string& data = req.body;
+        const std::string& data = req.body();
         uploadStatus = saveConfigFile(data, fileID, asyncResp);
         if (!uploadStatus)
         {
@@ -388,7 +396,8 @@ inline void
         for (const auto& file : std::filesystem::directory_iterator(loc))
         {
             const std::filesystem::path& pathObj = file.path();
-            if (std::filesystem::is_regular_file(pathObj))
+            if (std::filesystem::is_regular_file(pathObj) &&
+                !bmcweb::async_file::isTemporaryPath(pathObj))
             {
                 pathObjList.push_back("/ibm/v1/Host/ConfigFiles/" +
                                       pathObj.filename().string());
@@ -462,23 +471,26 @@ inline void handleFileGet(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         return;
     }
 
-    std::ifstream readfile(loc.string());
-    if (!readfile)
-    {
-        BMCWEB_LOG_ERROR << loc.string() << " Not found";
-        asyncResp->res.result(boost::beast::http::status::not_found);
-        asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
-        return;
-    }
+    bmcweb::asyncReadFile(
+        crow::connections::systemBus->get_io_context(), loc,
+        maxSaveareaFileSize,
+        [asyncResp, loc, fileID](const boost::system::error_code& ec,
+                                 std::string&& fileData) {
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << loc.string() << " Not found: " << ec;
+            asyncResp->res.result(boost::beast::http::status::not_found);
+            asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
+            return;
+        }
 
-    std::string contentDispositionParam = "attachment; filename=\"" + fileID +
-                                          "\"";
-    asyncResp->res.addHeader(boost::beast::http::field::content_disposition,
-                             contentDispositionParam);
-    std::string fileData;
-    fileData = {std::istreambuf_iterator<char>(readfile),
-                std::istreambuf_iterator<char>()};
-    asyncResp->res.jsonValue["Data"] = fileData;
+        std::string contentDispositionParam = "attachment; filename=\"" +
+                                              fileID + "\"";
+        asyncResp->res.addHeader(
+            boost::beast::http::field::content_disposition,
+            contentDispositionParam);
+        asyncResp->res.jsonValue["Data"] = std::move(fileData);
+    });
 }
 
 inline void
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+namespace bmcweb
+{
+namespace memory
+{
+
+/**
+ * Heap accounting, to find out what the memory of a long running bmcweb is
+ * spent on.
+ *
+ * When built with the memory-accounting option, operator new and delete are
+ * replaced (see src/memory_accounting.cpp), and every allocation is charged
+ * to the account that is current when it is made: that of the route being
+ * handled, or of a subsystem such as the event service or the session
+ * store.  Allocations remember their account, so frees are credited back to
+ * it, and the live bytes of an account are what it is holding on to now.
+ *
+ * Allocations made while handling a request are also summed per request,
+ * for the average and peak bytes each route allocates per request.  Callbacks
+ * of D-Bus calls made through dbus::utility run in the account of the code
+ * that made the call.
+ *
+ * bmcweb is single threaded, so the counters are not atomic.
+ */
+#ifdef BMCWEB_ENABLE_MEMORY_ACCOUNTING
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+struct Account
+{
+    uint64_t liveBytes = 0;
+    uint64_t peakLiveBytes = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t allocations = 0;
+};
+
+// Bytes allocated on behalf of one request, over its whole life
+struct RequestUsage
+{
+    uint64_t allocatedBytes = 0;
+};
+
+struct Tag
+{
+    Account* account = nullptr;
+    std::shared_ptr<RequestUsage> request;
+};
+
+struct RouteStats
+{
+    uint64_t requests = 0;
+    uint64_t totalBytes = 0;
+    uint64_t peakBytes = 0;
+};
+
+/**
+ * @brief Makes a tag current for as long as the scope lives.
+ */
+class Scope
+{
+  public:
+    explicit Scope(Tag tag) : previous(std::move(currentTag()))
+    {
+        currentTag() = std::move(tag);
+    }
+
+    ~Scope()
+    {
+        currentTag() = std::move(previous);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope& operator=(Scope&&) = delete;
+
+    static const Tag& current()
+    {
+        return currentTag();
+    }
+
+  private:
+    // Never destroyed, as static destructors that run after it still
+    // allocate and free.  Built in static storage, as operator new would
+    // come back here for the current tag.
+    static Tag& currentTag()
+    {
+        alignas(Tag) static unsigned char storage[sizeof(Tag)];
+        static Tag* tag = new (storage) Tag();
+        return *tag;
+    }
+
+    Tag previous;
+};
+
+// The accounts are never destroyed, as memory freed by static destructors
+// at exit is still credited to the account it was charged to.  The maps are
+// leaked for that; an Account has nothing to destroy.
+
+// Allocations made with no account current
+inline Account& untagged()
+{
+    static Account account;
+    return account;
+}
+
+inline std::map<std::string, Account, std::less<>>& subsystemAccounts()
+{
+    static auto* accounts = new std::map<std::string, Account, std::less<>>();
+    return *accounts;
+}
+
+inline std::map<std::string, Account, std::less<>>& routeAccounts()
+{
+    static auto* accounts = new std::map<std::string, Account, std::less<>>();
+    return *accounts;
+}
+
+inline std::map<std::string, RouteStats, std::less<>>& routeStats()
+{
+    static auto* stats = new std::map<std::string, RouteStats, std::less<>>();
+    return *stats;
+}
+
+// Accounts are never removed, so allocations can point at theirs for as
+// long as they live
+inline Account& findAccount(std::map<std::string, Account, std::less<>>& map,
+                            std::string_view name)
+{
+    auto it = map.find(name);
+    if (it == map.end())
+    {
+        it = map.emplace(std::string(name), Account()).first;
+    }
+    return it->second;
+}
+
+/**
+ * @brief A tag for work done by a subsystem rather than for a request
+ */
+inline Tag subsystem(std::string_view name)
+{
+    if constexpr (!enabled)
+    {
+        return {};
+    }
+    return {&findAccount(subsystemAccounts(), name), nullptr};
+}
+
+/**
+ * @brief A tag for handling one request to route.  Its usage is added to the
+ * statistics of the route by finishRequest.
+ */
+inline Tag request(std::string_view route)
+{
+    if constexpr (!enabled)
+    {
+        return {};
+    }
+    return {&findAccount(routeAccounts(), route),
+            std::make_shared<RequestUsage>()};
+}
+
+inline void finishRequest(std::string_view route, const RequestUsage& usage)
+{
+    auto it = routeStats().find(route);
+    if (it == routeStats().end())
+    {
+        it = routeStats().emplace(std::string(route), RouteStats()).first;
+    }
+    RouteStats& stats = it->second;
+    stats.requests++;
+    stats.totalBytes += usage.allocatedBytes;
+    stats.peakBytes = std::max(stats.peakBytes, usage.allocatedBytes);
+}
+
+/**
+ * @brief Charges an allocation to the current tag.
+ *
+ * @return The account to credit when it is freed.
+ */
+inline Account* onAllocate(size_t size)
+{
+    const Tag& tag = Scope::current();
+    Account* account = tag.account != nullptr ? tag.account : &untagged();
+    account->liveBytes += size;
+    account->peakLiveBytes = std::max(account->peakLiveBytes,
+                                      account->liveBytes);
+    account->allocatedBytes += size;
+    account->allocations++;
+    if (tag.request != nullptr)
+    {
+        tag.request->allocatedBytes += size;
+    }
+    return account;
+}
+
+inline void onFree(Account* account, size_t size)
+{
+    account->liveBytes -= std::min(account->liveBytes,
+                                   static_cast<uint64_t>(size));
+}
+
+} // namespace memory
+} // namespace bmcweb
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "logging.hpp"
+#include "sessions.hpp"
+#include "ssl_key_handler.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+namespace persistent_data
+{
+
+/**
+ * @brief Remembers which session a client certificate maps to.
+ *
+ * Once a client certificate has been verified, its key usages checked and
+ * its CommonName mapped to a user, the result is stored under the SHA-256
+ * fingerprint of the certificate.  Later connections presenting the same
+ * certificate, including resumed TLS sessions where OpenSSL does not call
+ * the verify callback at all, reuse that session instead of parsing the
+ * certificate and minting a new one.
+ *
+ * The sessions are ephemeral ones, never stored in the SessionStore, so
+ * they are not listed as Redfish sessions nor persisted; the cache applies
+ * the session idle timeout to them itself.  Entries are dropped when the
+ * certificate expires, when the session goes idle, when the user is removed
+ * and, all at once, whenever the trust store directory changes, so removing
+ * a CA immediately stops identities it vouched for from being reused.
+ * Dropping an entry removes its session, releasing what it held.
+ */
+class MutualTlsIdentityCache
+{
+  public:
+    using Fingerprint = std::array<unsigned char, 32>;
+
+    MutualTlsIdentityCache(const MutualTlsIdentityCache&) = delete;
+    MutualTlsIdentityCache(MutualTlsIdentityCache&&) = delete;
+    MutualTlsIdentityCache& operator=(const MutualTlsIdentityCache&) = delete;
+    MutualTlsIdentityCache& operator=(MutualTlsIdentityCache&&) = delete;
+    ~MutualTlsIdentityCache() = default;
+
+    static MutualTlsIdentityCache& getInstance()
+    {
+        static MutualTlsIdentityCache cache;
+        return cache;
+    }
+
+    static std::optional<Fingerprint> getFingerprint(X509* cert)
+    {
+        Fingerprint fingerprint{};
+        unsigned int length = 0;
+        if (X509_digest(cert, EVP_sha256(), fingerprint.data(), &length) !=
+                1 ||
+            length != fingerprint.size())
+        {
+            return std::nullopt;
+        }
+        return fingerprint;
+    }
+
+    std::shared_ptr<UserSession> lookup(const Fingerprint& fingerprint)
+    {
+        checkTrustStore();
+
+        auto it = entries.find(toKey(fingerprint));
+        if (it == entries.end())
+        {
+            return nullptr;
+        }
+        if (std::chrono::system_clock::now() >= it->second.notAfter)
+        {
+            BMCWEB_LOG_DEBUG << "Cached TLS identity expired";
+            drop(it);
+            return nullptr;
+        }
+        std::shared_ptr<UserSession> session = it->second.session;
+        auto now = std::chrono::steady_clock::now();
+        if (now - session->lastUpdated >=
+            std::chrono::seconds(
+                SessionStore::getInstance().getTimeoutInSeconds()))
+        {
+            BMCWEB_LOG_DEBUG << "Cached TLS identity session timed out";
+            drop(it);
+            return nullptr;
+        }
+        session->lastUpdated = now;
+        hits++;
+        return session;
+    }
+
+    void insert(const Fingerprint& fingerprint, X509* cert,
+                const std::shared_ptr<UserSession>& session)
+    {
+        checkTrustStore();
+
+        std::optional<std::chrono::system_clock::time_point> notAfter =
+            getNotAfter(cert);
+        if (!notAfter)
+        {
+            return;
+        }
+        if (entries.size() >= maxEntries)
+        {
+            evictOne();
+        }
+        entries.insert_or_assign(toKey(fingerprint),
+                                 Entry{session, *notAfter});
+    }
+
+    bool contains(const std::shared_ptr<UserSession>& session) const
+    {
+        return std::ranges::any_of(entries, [&session](const auto& entry) {
+            return entry.second.session == session;
+        });
+    }
+
+    // The user is gone, so certificates naming them no longer log in
+    void removeUser(std::string_view username)
+    {
+        std::erase_if(entries, [username](const auto& entry) {
+            if (entry.second.session->username != username)
+            {
+                return false;
+            }
+            SessionStore::getInstance().removeSession(entry.second.session);
+            return true;
+        });
+    }
+
+    void clear()
+    {
+        for (const auto& entry : entries)
+        {
+            SessionStore::getInstance().removeSession(entry.second.session);
+        }
+        entries.clear();
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    uint64_t hitCount() const
+    {
+        return hits;
+    }
+
+    /**
+     * @brief When a change to the trust store was last noticed.  Resumed TLS
+     * sessions established before this were verified against a set of CAs
+     * that may no longer be trusted.
+     */
+    std::chrono::system_clock::time_point trustStoreChangedAt()
+    {
+        checkTrustStore();
+        return trustStoreChanged;
+    }
+
+  private:
+    MutualTlsIdentityCache() = default;
+
+    struct Entry
+    {
+        std::shared_ptr<UserSession> session;
+        std::chrono::system_clock::time_point notAfter;
+    };
+
+    static std::string toKey(const Fingerprint& fingerprint)
+    {
+        return {fingerprint.begin(), fingerprint.end()};
+    }
+
+    static std::optional<std::chrono::system_clock::time_point>
+        getNotAfter(X509* cert)
+    {
+        const ASN1_TIME* notAfter = X509_get0_notAfter(cert);
+        tm notAfterTm{};
+        if (notAfter == nullptr || ASN1_TIME_to_tm(notAfter, &notAfterTm) != 1)
+        {
+            return std::nullopt;
+        }
+        return std::chrono::system_clock::from_time_t(timegm(&notAfterTm));
+    }
+
+    void evictOne()
+    {
+        // Drop the identity whose session was used least recently
+        auto victim = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); it++)
+        {
+            if (it->second.session->lastUpdated <
+                victim->second.session->lastUpdated)
+            {
+                victim = it;
+            }
+        }
+        if (victim != entries.end())
+        {
+            drop(victim);
+        }
+    }
+
+    void drop(std::unordered_map<std::string, Entry>::iterator it)
+    {
+        SessionStore::getInstance().removeSession(it->second.session);
+        entries.erase(it);
+    }
+
+    void checkTrustStore()
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastTrustStoreCheck < std::chrono::seconds(1))
+        {
+            return;
+        }
+        lastTrustStoreCheck = now;
+
+        std::error_code ec;
+        std::filesystem::file_time_type modified =
+            std::filesystem::last_write_time(ensuressl::trustStorePath, ec);
+        if (ec)
+        {
+            modified = std::filesystem::file_time_type::min();
+        }
+        if (modified != trustStoreModified)
+        {
+            if (!entries.empty())
+            {
+                BMCWEB_LOG_INFO << "Trust store changed, dropping "
+                                << entries.size() << " cached TLS identities";
+            }
+            clear();
+            trustStoreModified = modified;
+            trustStoreChanged = std::chrono::system_clock::now();
+        }
+    }
+
+    // Sessions are small, but each is tied to a long lived client; keep
+    // this bounded so a stream of distinct certificates can't grow it.
+    static constexpr size_t maxEntries = 64;
+
+    std::unordered_map<std::string, Entry> entries;
+    std::chrono::steady_clock::time_point lastTrustStoreCheck;
+    std::filesystem::file_time_type trustStoreModified =
+        std::filesystem::file_time_type::min();
+    std::chrono::system_clock::time_point trustStoreChanged;
+    uint64_t hits = 0;
+};
+
+} // namespace persistent_data
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include "async_file.hpp"
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
@@ -185,8 +186,8 @@ inline void getPropertiesForEnumerate(
     BMCWEB_LOG_DEBUG << "getPropertiesForEnumerate " << objectPath << " "
                      << service << " " << interface;
 
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objectPath, interface,
+    dbus::utility::getAllProperties(
+        service, objectPath, interface,
         [asyncResp, objectPath, service,
          interface](const boost::system::error_code ec,
                     const dbus::utility::DBusPropertiesMap& propertiesList) {
@@ -1537,7 +1538,7 @@ inline void handleAction(const crow::Request& req,
 {
     BMCWEB_LOG_DEBUG << "handleAction on path: " << objectPath << " and method "
                      << methodName;
-    nlohmann::json requestDbusData = nlohmann::json::parse(req.body, nullptr,
+    nlohmann::json requestDbusData = nlohmann::json::parse(req.body(), nullptr,
                                                            false);
 
     if (requestDbusData.is_discarded())
@@ -1852,7 +1853,7 @@ inline void handlePut(const crow::Request& req,
         return;
     }
 
-    nlohmann::json requestDbusData = nlohmann::json::parse(req.body, nullptr,
+    nlohmann::json requestDbusData = nlohmann::json::parse(req.body(), nullptr,
                                                            false);
 
     if (requestDbusData.is_discarded())
@@ -2390,7 +2391,7 @@ inline void
             return;
         }
 
-        nlohmann::json requestDbusData = nlohmann::json::parse(req.body,
+        nlohmann::json requestDbusData = nlohmann::json::parse(req.body(),
                                                                nullptr, false);
 
         if (requestDbusData.is_discarded())
@@ -2565,8 +2566,20 @@ inline void requestRoutes(App& app)
                 boost::beast::http::field::content_disposition,
                 contentDispositionParam);
 
-            asyncResp->res.body() = {std::istreambuf_iterator<char>(readFile),
-                                     std::istreambuf_iterator<char>()};
+            bmcweb::asyncReadFile(
+                crow::connections::systemBus->get_io_context(), file.path(),
+                std::numeric_limits<uint64_t>::max(),
+                [asyncResp](const boost::system::error_code& ec,
+                            std::string&& data) {
+                if (ec)
+                {
+                    BMCWEB_LOG_ERROR << "Failed to read dump file: " << ec;
+                    asyncResp->res.result(
+                        boost::beast::http::status::internal_server_error);
+                    return;
+                }
+                asyncResp->res.body() = std::move(data);
+            });
             return;
         }
         asyncResp->res.result(boost::beast::http::status::not_found);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "async_file.hpp"
+#include "dbus_singleton.hpp"
+
 #include <app.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -37,9 +40,12 @@ class ConfigFile
     {
         // Make sure we aren't writing stale sessions
         persistent_data::SessionStore::getInstance().applySessionTimeouts();
-        if (persistent_data::SessionStore::getInstance().needsWrite())
+        // A write still in flight never completes, as the io context is gone
+        // by now, and one waiting for it would never start
+        if (persistent_data::SessionStore::getInstance().needsWrite() ||
+            writeInProgress || writePending)
         {
-            writeData();
+            writeDataNow();
         }
     }
 
@@ -278,16 +284,58 @@ class ConfigFile
     }
 #endif
 
+    /**
+     * @brief Saves the current state.  Once the server is running, the file
+     * is written without holding up the io context, and changes made while
+     * a write is in flight are saved together once it completes.
+     */
     void writeData()
+    {
+        if (crow::connections::systemBus == nullptr)
+        {
+            writeDataNow();
+            return;
+        }
+        if (writeInProgress)
+        {
+            writePending = true;
+            return;
+        }
+        writeInProgress = true;
+        bmcweb::asyncWriteFile(crow::connections::systemBus->get_io_context(),
+                               filename, serialize().dump(), permissions,
+                               [this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Failed to write persistent data: " << ec;
+            }
+            writeInProgress = false;
+            if (writePending)
+            {
+                writePending = false;
+                writeData();
+            }
+        });
+    }
+
+    std::string systemUuid;
+
+  private:
+    // set the permission of the file to 640
+    static constexpr std::filesystem::perms permissions =
+        std::filesystem::perms::owner_read |
+        std::filesystem::perms::owner_write |
+        std::filesystem::perms::group_read;
+
+    void writeDataNow()
     {
         std::ofstream persistentFile(filename);
+        std::filesystem::permissions(filename, permissions);
+        persistentFile << serialize();
+    }
 
-        // set the permission of the file to 640
-        std::filesystem::perms permission =
-            std::filesystem::perms::owner_read |
-            std::filesystem::perms::owner_write |
-            std::filesystem::perms::group_read;
-        std::filesystem::permissions(filename, permission);
+    nlohmann::json serialize() const
+    {
         const auto& c = SessionStore::getInstance().getAuthMethodsConfig();
         const auto& eventServiceConfig =
             EventServiceStore::getInstance().getEventServiceConfig();
@@ -373,10 +421,11 @@ class ConfigFile
 
             subscriptions.push_back(std::move(subscription));
         }
-        persistentFile << data;
+        return data;
     }
 
-    std::string systemUuid;
+    bool writeInProgress = false;
+    bool writePending = false;
 };
 
 inline ConfigFile& getConfig()
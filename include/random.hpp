@@ -2,6 +2,14 @@
 
 #include <openssl/rand.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string_view>
+
 namespace bmcweb
 {
 
@@ -43,4 +51,110 @@ struct OpenSSLGenerator
     bool err = false;
 };
 
+/**
+ * @brief Same interface as OpenSSLGenerator, but pulls random bytes from
+ * OpenSSL in blocks instead of one RAND_bytes() call per byte.
+ *
+ * Each byte is handed out exactly once; the remainder of the block is wiped
+ * when the generator goes out of scope.
+ */
+class BufferedOpenSSLGenerator
+{
+  public:
+    BufferedOpenSSLGenerator() = default;
+    ~BufferedOpenSSLGenerator()
+    {
+        OPENSSL_cleanse(buffer.data(), buffer.size());
+    }
+
+    BufferedOpenSSLGenerator(const BufferedOpenSSLGenerator&) = delete;
+    BufferedOpenSSLGenerator(BufferedOpenSSLGenerator&&) = delete;
+    BufferedOpenSSLGenerator&
+        operator=(const BufferedOpenSSLGenerator&) = delete;
+    BufferedOpenSSLGenerator& operator=(BufferedOpenSSLGenerator&&) = delete;
+
+    uint8_t operator()()
+    {
+        if (offset >= buffer.size())
+        {
+            refill();
+        }
+        uint8_t value = buffer[offset];
+        buffer[offset] = 0;
+        offset++;
+        return value;
+    }
+
+    static constexpr uint8_t max()
+    {
+        return std::numeric_limits<uint8_t>::max();
+    }
+    static constexpr uint8_t min()
+    {
+        return std::numeric_limits<uint8_t>::min();
+    }
+
+    bool error() const
+    {
+        return err;
+    }
+
+    // all generators require this variable
+    using result_type = uint8_t;
+
+  private:
+    void refill()
+    {
+        offset = 0;
+        int rc = RAND_bytes(buffer.data(), static_cast<int>(buffer.size()));
+        if (rc != opensslSuccess)
+        {
+            std::cerr << "Cannot get random number\n";
+            err = true;
+        }
+    }
+
+    // RAND_bytes() returns 1 on success, 0 otherwise. -1 if bad function
+    static constexpr int opensslSuccess = 1;
+    // Large enough to generate a full session (two tokens and a unique id)
+    // in one or two draws, even after rejection sampling.
+    std::array<uint8_t, 64> buffer{};
+    size_t offset = buffer.size();
+    bool err = false;
+};
+
+constexpr std::string_view alphanumCharacters =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+/**
+ * @brief Fills output with characters drawn uniformly from alphanumCharacters
+ *
+ * Bytes that would bias the modulo (>= 248, the largest multiple of 62 that
+ * fits in a byte) are rejected and redrawn.
+ *
+ * @return true on success, false if the generator failed to return entropy
+ */
+template <typename Generator>
+inline bool fillRandomAlphanum(Generator& gen, std::span<char> output)
+{
+    constexpr size_t numChars = alphanumCharacters.size();
+    constexpr size_t rejectAbove =
+        (static_cast<size_t>(Generator::max()) + 1) / numChars * numChars;
+
+    for (char& outChar : output)
+    {
+        size_t value = 0;
+        do
+        {
+            value = gen();
+            if (gen.error())
+            {
+                return false;
+            }
+        } while (value >= rejectAbove);
+        outChar = alphanumCharacters[value % numChars];
+    }
+    return true;
+}
+
 } // namespace bmcweb
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "logging.hpp"
+#include "memory_accounting.hpp"
 #include "random.hpp"
 #include "utility.hpp"
 
@@ -10,7 +11,6 @@
 #include <algorithm>
 #include <csignal>
 #include <optional>
-#include <random>
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
 #include <ibm/locks.hpp>
 #endif
@@ -23,6 +23,10 @@ namespace persistent_data
 // https://cheatsheetseries.owasp.org/cheatsheets/Session_Management_Cheat_Sheet.html#session-id-entropy
 constexpr std::size_t sessionTokenSize = 20;
 
+// Unique ids are only used to address an existing session, and are never
+// accepted as a credential.
+constexpr std::size_t uniqueIdSize = 10;
+
 enum class PersistenceType
 {
     TIMEOUT, // User session times out after a predetermined amount of time
@@ -207,50 +211,35 @@ class SessionStore
         PersistenceType persistence = PersistenceType::TIMEOUT,
         bool isConfigureSelfOnly = false)
     {
-        // TODO(ed) find a secure way to not generate session identifiers if
-        // persistence is set to SINGLE_REQUEST
-        static constexpr std::array<char, 62> alphanum = {
-            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C',
-            'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-            'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c',
-            'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
-            'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'};
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("SessionStore"));
+        if (persistence == PersistenceType::SINGLE_REQUEST)
+        {
+            return generateEphemeralSession(username, clientIp,
+                                            isConfigureSelfOnly);
+        }
+
+        bmcweb::BufferedOpenSSLGenerator gen;
 
         std::string sessionToken;
         sessionToken.resize(sessionTokenSize, '0');
-        std::uniform_int_distribution<size_t> dist(0, alphanum.size() - 1);
-
-        bmcweb::OpenSSLGenerator gen;
-
-        for (char& sessionChar : sessionToken)
+        if (!bmcweb::fillRandomAlphanum(gen, sessionToken))
         {
-            sessionChar = alphanum[dist(gen)];
-            if (gen.error())
-            {
-                return nullptr;
-            }
+            return nullptr;
         }
         // Only need csrf tokens for cookie based auth, token doesn't matter
         std::string csrfToken;
         csrfToken.resize(sessionTokenSize, '0');
-        for (char& csrfChar : csrfToken)
+        if (!bmcweb::fillRandomAlphanum(gen, csrfToken))
         {
-            csrfChar = alphanum[dist(gen)];
-            if (gen.error())
-            {
-                return nullptr;
-            }
+            return nullptr;
         }
 
         std::string uniqueId;
-        uniqueId.resize(10, '0');
-        for (char& uidChar : uniqueId)
+        uniqueId.resize(uniqueIdSize, '0');
+        if (!bmcweb::fillRandomAlphanum(gen, uniqueId))
         {
-            uidChar = alphanum[dist(gen)];
-            if (gen.error())
-            {
-                return nullptr;
-            }
+            return nullptr;
         }
 
         auto session = std::make_shared<UserSession>(UserSession{
@@ -259,11 +248,40 @@ class SessionStore
             std::chrono::steady_clock::now(), persistence,
             isConfigureSelfOnly});
         auto it = authTokens.emplace(sessionToken, session);
-        // Only need to write to disk if session isn't about to be destroyed.
-        needWrite = persistence == PersistenceType::TIMEOUT;
+        needWrite = true;
         return it.first->second;
     }
 
+    /**
+     * @brief Creates the identity used for a single authenticated request
+     * (Basic auth).
+     *
+     * The returned session has no session or CSRF token and is never added
+     * to authTokens, so it can't be looked up, listed or persisted; it only
+     * lives as long as the request holding it.  A short unique id is still
+     * generated, as the IBM lock table keys its locks on it.
+     */
+    static std::shared_ptr<UserSession>
+        generateEphemeralSession(const std::string_view username,
+                                 const boost::asio::ip::address& clientIp,
+                                 bool isConfigureSelfOnly = false)
+    {
+        bmcweb::BufferedOpenSSLGenerator gen;
+
+        std::string uniqueId;
+        uniqueId.resize(uniqueIdSize, '0');
+        if (!bmcweb::fillRandomAlphanum(gen, uniqueId))
+        {
+            return nullptr;
+        }
+
+        return std::make_shared<UserSession>(UserSession{
+            std::move(uniqueId), std::string(), std::string(username),
+            std::string(), std::nullopt, redfish::ip_util::toString(clientIp),
+            std::chrono::steady_clock::now(), PersistenceType::SINGLE_REQUEST,
+            isConfigureSelfOnly});
+    }
+
     std::shared_ptr<UserSession>
         loginSessionByToken(const std::string_view token)
     {
@@ -303,6 +321,12 @@ class SessionStore
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
         crow::ibm_mc_lock::Lock::getInstance().releaseLock(session->uniqueId);
 #endif
+        // Ephemeral sessions were never stored, so there is nothing to erase
+        // or write back.
+        if (session->sessionToken.empty())
+        {
+            return;
+        }
         authTokens.erase(session->sessionToken);
         needWrite = true;
     }
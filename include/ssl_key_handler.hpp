@@ -13,14 +13,17 @@
 #include <boost/asio/ssl/context.hpp>
 #include <random.hpp>
 
+#include <array>
 #include <random>
+#include <string>
 
 namespace ensuressl
 {
 constexpr const char* trustStorePath = "/etc/ssl/certs/authority";
 constexpr const char* x509Comment = "Generated from OpenBMC service";
+constexpr const char* ecdsaCertFileName = "server-ecdsa.pem";
 static void initOpenssl();
-static EVP_PKEY* createEcKey();
+static EVP_PKEY* createEcKey(int curveNid);
 
 // Trust chain related errors.`
 inline bool isTrustChainError(int errnum)
@@ -241,14 +244,15 @@ inline int addExt(X509* cert, int nid, const char* value)
 }
 
 inline void generateSslCertificate(const std::string& filepath,
-                                   const std::string& cn)
+                                   const std::string& cn,
+                                   int curveNid = NID_secp384r1)
 {
     FILE* pFile = nullptr;
     std::cout << "Generating new keys\n";
     initOpenssl();
 
     std::cerr << "Generating EC key\n";
-    EVP_PKEY* pPrivKey = createEcKey();
+    EVP_PKEY* pPrivKey = createEcKey(curveNid);
     if (pPrivKey != nullptr)
     {
         std::cerr << "Generating x509 Certificate\n";
@@ -329,15 +333,12 @@ inline void generateSslCertificate(const std::string& filepath,
     // cleanup_openssl();
 }
 
-EVP_PKEY* createEcKey()
+EVP_PKEY* createEcKey(int curveNid)
 {
     EVP_PKEY* pKey = nullptr;
 
 #if (OPENSSL_VERSION_NUMBER < 0x30000000L)
-    int eccgrp = 0;
-    eccgrp = OBJ_txt2nid("secp384r1");
-
-    EC_KEY* myecc = EC_KEY_new_by_curve_name(eccgrp);
+    EC_KEY* myecc = EC_KEY_new_by_curve_name(curveNid);
     if (myecc != nullptr)
     {
         EC_KEY_set_asn1_flag(myecc, OPENSSL_EC_NAMED_CURVE);
@@ -369,8 +370,7 @@ EVP_PKEY* createEcKey()
     if ((EVP_PKEY_paramgen_init(ctx.get()) <= 0) ||
         (EVP_PKEY_CTX_set_ec_param_enc(ctx.get(), OPENSSL_EC_NAMED_CURVE) <=
          0) ||
-        (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx.get(), NID_secp384r1) <=
-         0) ||
+        (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx.get(), curveNid) <= 0) ||
         (EVP_PKEY_paramgen(ctx.get(), &params) <= 0))
     {
         return nullptr;
@@ -419,8 +419,117 @@ inline void ensureOpensslKeyPresentAndValid(const std::string& filepath)
     }
 }
 
+/**
+ * @brief Returns the EVP_PKEY type (EVP_PKEY_RSA, EVP_PKEY_EC, ...) of the
+ * private key stored in a PEM file, or EVP_PKEY_NONE if none could be read.
+ */
+inline int getPrivateKeyType(const std::string& filepath)
+{
+    FILE* file = fopen(filepath.c_str(), "r");
+    if (file == nullptr)
+    {
+        return EVP_PKEY_NONE;
+    }
+    int keyType = EVP_PKEY_NONE;
+    EVP_PKEY* pkey = PEM_read_PrivateKey(file, nullptr, nullptr, nullptr);
+    if (pkey != nullptr)
+    {
+        keyType = EVP_PKEY_base_id(pkey);
+        EVP_PKEY_free(pkey);
+    }
+    fclose(file);
+    return keyType;
+}
+
+inline std::string getCertificateCommonName(const std::string& filepath)
+{
+    X509* cert = loadCert(filepath);
+    if (cert == nullptr)
+    {
+        return "";
+    }
+    std::array<char, 256> cnBuffer{};
+    int cnLength = X509_NAME_get_text_by_NID(X509_get_subject_name(cert),
+                                             NID_commonName, cnBuffer.data(),
+                                             cnBuffer.size());
+    X509_free(cert);
+    if (cnLength <= 0)
+    {
+        return "";
+    }
+    return {cnBuffer.data(), static_cast<size_t>(cnLength)};
+}
+
+inline bool isSelfSignedCertificate(const std::string& filepath)
+{
+    X509* cert = loadCert(filepath);
+    if (cert == nullptr)
+    {
+        return false;
+    }
+    bool selfSigned = false;
+    EVP_PKEY* pPubKey = X509_get_pubkey(cert);
+    if (pPubKey != nullptr)
+    {
+        selfSigned = X509_verify(cert, pPubKey) == 1;
+        EVP_PKEY_free(pPubKey);
+    }
+    X509_free(cert);
+    return selfSigned;
+}
+
+/**
+ * @brief Makes sure an ECDSA P-256 certificate is available next to an RSA
+ * server certificate.
+ *
+ * Full handshakes signed with ECDSA P-256 are several times cheaper than
+ * RSA on BMC class cores.  When the primary certificate already uses an EC
+ * key there is nothing to add.  An ECDSA pair installed by the administrator
+ * is used as is.  One is only generated when the RSA certificate is self
+ * signed itself, as a self signed ECDSA certificate served next to a CA
+ * signed RSA one would fail verification on exactly the clients that prefer
+ * it.
+ *
+ * @return true if ecdsaPemFile holds a certificate to load alongside
+ * sslPemFile
+ */
+inline bool ensureEcdsaKeyPresentAndValid(const std::string& sslPemFile,
+                                          const std::string& ecdsaPemFile)
+{
+    if (getPrivateKeyType(sslPemFile) != EVP_PKEY_RSA)
+    {
+        return false;
+    }
+
+    bool ecdsaValid = getPrivateKeyType(ecdsaPemFile) == EVP_PKEY_EC &&
+                      verifyOpensslKeyCert(ecdsaPemFile);
+    bool ecdsaSelfSigned = ecdsaValid && isSelfSignedCertificate(ecdsaPemFile);
+    if (ecdsaValid && !ecdsaSelfSigned)
+    {
+        return true;
+    }
+
+    if (!isSelfSignedCertificate(sslPemFile))
+    {
+        return false;
+    }
+
+    std::string cn = getCertificateCommonName(sslPemFile);
+    if (cn.empty())
+    {
+        cn = "testhost";
+    }
+    if (!ecdsaValid || getCertificateCommonName(ecdsaPemFile) != cn)
+    {
+        std::cerr << "Generating ECDSA certificate for " << cn << "\n";
+        generateSslCertificate(ecdsaPemFile, cn, NID_X9_62_prime256v1);
+    }
+    return getPrivateKeyType(ecdsaPemFile) == EVP_PKEY_EC;
+}
+
 inline std::shared_ptr<boost::asio::ssl::context>
-    getSslContext(const std::string& sslPemFile)
+    getSslContext(const std::string& sslPemFile,
+                  const std::string& ecdsaPemFile = "")
 {
     std::shared_ptr<boost::asio::ssl::context> mSslContext =
         std::make_shared<boost::asio::ssl::context>(
@@ -438,6 +547,14 @@ inline std::shared_ptr<boost::asio::ssl::context>
 
     SSL_CTX_set_options(mSslContext->native_handle(), SSL_OP_NO_RENEGOTIATION);
 
+    // Let returning clients resume their session instead of paying for a
+    // full handshake, and for mutual TLS, certificate chain verification.
+    // OpenSSL's default cache holds ~20k sessions, each carrying the peer
+    // certificate, which is more memory than a BMC should spend on this.
+    SSL_CTX_set_session_cache_mode(mSslContext->native_handle(),
+                                   SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(mSslContext->native_handle(), 256);
+
     BMCWEB_LOG_DEBUG << "Using default TrustStore location: " << trustStorePath;
     mSslContext->add_verify_path(trustStorePath);
 
@@ -446,6 +563,30 @@ inline std::shared_ptr<boost::asio::ssl::context>
     mSslContext->use_private_key_file(sslPemFile,
                                       boost::asio::ssl::context::pem);
 
+    // OpenSSL keeps one certificate per key type, and picks the one matching
+    // the signature algorithms offered in each ClientHello.  Failing to load
+    // the secondary certificate is not fatal, RSA clients still work.
+    if (!ecdsaPemFile.empty())
+    {
+        boost::system::error_code ec;
+        mSslContext->use_certificate_file(ecdsaPemFile,
+                                          boost::asio::ssl::context::pem, ec);
+        if (!ec)
+        {
+            mSslContext->use_private_key_file(
+                ecdsaPemFile, boost::asio::ssl::context::pem, ec);
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to load ECDSA certificate "
+                             << ecdsaPemFile << ": " << ec.message();
+        }
+        else
+        {
+            BMCWEB_LOG_INFO << "Loaded ECDSA certificate " << ecdsaPemFile;
+        }
+    }
+
     // Set up EC curves to auto (boost asio doesn't have a method for this)
     // There is a pull request to add this.  Once this is included in an asio
     // drop, use the right way
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "app.hpp"
+#include "async_resp.hpp"
+#include "dbus_circuit_breaker.hpp"
+#include "http_request.hpp"
+#include "memory_accounting.hpp"
+#include "rate_limiter.hpp"
+#include "tls_handshake_limiter.hpp"
+
+#include <boost/beast/http/verb.hpp>
+#include <nlohmann/json.hpp>
+
+#include <memory>
+
+namespace crow
+{
+namespace stats_routes
+{
+
+// Counters of bmcweb internals, for bmcweb developers and for tuning the
+// build options behind them.  They aren't Redfish resources, and have no
+// schema.
+
+inline void
+    handleTlsHandshakesGet(const crow::Request& /*req*/,
+                           const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    const TlsHandshakeLimiter& limiter = TlsHandshakeLimiter::getInstance();
+    const TlsHandshakeStats& stats = limiter.getStats();
+
+    nlohmann::json& json = asyncResp->res.jsonValue;
+    json["ConcurrencyLimit"] = limiter.concurrencyLimit();
+    json["InProgress"] = limiter.activeCount();
+    json["Queued"] = limiter.queueDepth();
+    json["MaxQueued"] = stats.maxQueueDepth;
+    json["Started"] = stats.started;
+    json["Succeeded"] = stats.succeeded;
+    json["Failed"] = stats.failed;
+    json["Deferred"] = stats.deferred;
+    json["TotalQueueWaitMicroseconds"] = stats.totalQueueWait.count();
+    json["MaxQueueWaitMicroseconds"] = stats.maxQueueWait.count();
+    json["TotalDurationMicroseconds"] = stats.totalDuration.count();
+    json["MaxDurationMicroseconds"] = stats.maxDuration.count();
+}
+
+inline void handleDbusCircuitBreakerGet(
+    const crow::Request& /*req*/,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    const bmcweb::DbusCircuitBreaker& breaker =
+        bmcweb::DbusCircuitBreaker::getInstance();
+
+    nlohmann::json& json = asyncResp->res.jsonValue;
+    json["UnresponsiveServices"] = breaker.openCircuits();
+    json["TimesOpened"] = breaker.openCount();
+    json["FastFailedCalls"] = breaker.fastFailureCount();
+}
+
+inline void
+    handleRateLimitsGet(const crow::Request& /*req*/,
+                        const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    const RateLimiter& limiter = RateLimiter::getInstance();
+    const RateLimitStats& stats = limiter.getStats();
+
+    nlohmann::json& json = asyncResp->res.jsonValue;
+    json["RequestsPerSecond"] = limiter.normalLimit().perSecond;
+    json["Burst"] = limiter.normalLimit().burst;
+    json["ExpensiveRequestsPerSecond"] = limiter.expensiveLimit().perSecond;
+    json["TrackedClients"] = limiter.clientCount();
+    json["ThrottledByUser"] = stats.throttledByUser;
+    json["ThrottledByAddress"] = stats.throttledByAddress;
+    json["ThrottledExpensive"] = stats.throttledExpensive;
+    json["UntrackedClients"] = stats.untracked;
+}
+
+// The per-route figures show what other users are requesting, so like the
+// rest this needs ConfigureManager rather than Login
+inline void
+    handleMemoryGet(const crow::Request& /*req*/,
+                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    nlohmann::json& json = asyncResp->res.jsonValue;
+
+    auto accountJson = [](const bmcweb::memory::Account& account) {
+        nlohmann::json::object_t item;
+        item["LiveBytes"] = account.liveBytes;
+        item["PeakLiveBytes"] = account.peakLiveBytes;
+        item["AllocatedBytes"] = account.allocatedBytes;
+        item["Allocations"] = account.allocations;
+        return item;
+    };
+
+    nlohmann::json::array_t subsystems;
+    for (const auto& [name, account] : bmcweb::memory::subsystemAccounts())
+    {
+        nlohmann::json::object_t item = accountJson(account);
+        item["Name"] = name;
+        subsystems.emplace_back(std::move(item));
+    }
+    json["Subsystems"] = std::move(subsystems);
+
+    nlohmann::json::array_t routes;
+    for (const auto& [route, account] : bmcweb::memory::routeAccounts())
+    {
+        nlohmann::json::object_t item = accountJson(account);
+        item["Route"] = route;
+        auto stats = bmcweb::memory::routeStats().find(route);
+        if (stats != bmcweb::memory::routeStats().end() &&
+            stats->second.requests > 0)
+        {
+            item["Requests"] = stats->second.requests;
+            item["AverageBytesPerRequest"] = stats->second.totalBytes /
+                                             stats->second.requests;
+            item["PeakBytesPerRequest"] = stats->second.peakBytes;
+        }
+        routes.emplace_back(std::move(item));
+    }
+    json["Routes"] = std::move(routes);
+
+    json["Untagged"] = accountJson(bmcweb::memory::untagged());
+}
+
+inline void requestRoutes(App& app)
+{
+    BMCWEB_ROUTE(app, "/debug/v1/tls/handshakes")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(handleTlsHandshakesGet);
+
+    BMCWEB_ROUTE(app, "/debug/v1/dbus/circuit-breaker")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(handleDbusCircuitBreakerGet);
+
+    BMCWEB_ROUTE(app, "/debug/v1/rate-limits")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(handleRateLimitsGet);
+
+    if constexpr (bmcweb::memory::enabled)
+    {
+        BMCWEB_ROUTE(app, "/debug/v1/memory")
+            .privileges({{"ConfigureManager"}})
+            .methods(boost::beast::http::verb::get)(handleMemoryGet);
+    }
+}
+
+} // namespace stats_routes
+} // namespace crow
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "app.hpp"
+#include "async_resp.hpp"
+#include "http_request.hpp"
+#include "tracing.hpp"
+
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/url/params_view.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace crow
+{
+namespace trace_routes
+{
+
+/**
+ * @brief Exports the spans of recently traced requests.  Every response
+ * carries its trace id in X-Trace-Id; passing it as ?traceId= limits the
+ * export to that request.  ?format=otlp gives OTLP/JSON, and the default is
+ * the Chrome trace event format.
+ */
+inline void
+    handleTracesGet(const crow::Request& req,
+                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    std::optional<uint64_t> traceId;
+    std::string_view format = "chrome";
+    for (const boost::urls::params_view::value_type& param :
+         req.urlView.params())
+    {
+        if (param.key == "traceId")
+        {
+            traceId = Tracer::parseId(param.value);
+            if (!traceId)
+            {
+                asyncResp->res.result(boost::beast::http::status::bad_request);
+                return;
+            }
+        }
+        else if (param.key == "format")
+        {
+            format = param.value;
+        }
+    }
+
+    const Tracer& tracer = Tracer::getInstance();
+    if (format == "chrome")
+    {
+        asyncResp->res.jsonValue = tracer.toChromeTrace(traceId);
+    }
+    else if (format == "otlp")
+    {
+        asyncResp->res.jsonValue = tracer.toOtlp(traceId);
+    }
+    else
+    {
+        asyncResp->res.result(boost::beast::http::status::bad_request);
+    }
+}
+
+inline void requestRoutes(App& app)
+{
+    BMCWEB_ROUTE(app, "/debug/v1/traces")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(handleTracesGet);
+}
+
+} // namespace trace_routes
+} // namespace crow
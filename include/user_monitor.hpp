@@ -1,6 +1,7 @@
 #pragma once
 #include "dbus_singleton.hpp"
 #include "dbus_utility.hpp"
+#include "mtls_identity_cache.hpp"
 #include "persistent_data.hpp"
 
 #include <sdbusplus/bus/match.hpp>
@@ -16,6 +17,7 @@ inline void onUserRemoved(sdbusplus::message::message& msg)
     std::string username = p.filename();
     persistent_data::SessionStore::getInstance().removeSessionsByUsername(
         username);
+    persistent_data::MutualTlsIdentityCache::getInstance().removeUser(username);
 }
 
 inline void registerUserRemovedSignal()
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "async_file.hpp"
+#include "dbus_singleton.hpp"
 #include "webroutes.hpp"
 
 #include <app.hpp>
@@ -9,15 +11,19 @@
 #include <http_response.hpp>
 #include <routing.hpp>
 
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <string>
+#include <utility>
 
 namespace crow
 {
 namespace webassets
 {
 
+// Larger than any asset the web UI ships
+constexpr uint64_t maxAssetSize = 64U * 1024U * 1024U;
+
 struct CmpStr
 {
     bool operator()(const char* a, const char* b) const
@@ -164,17 +170,20 @@ inline void requestRoutes(App& app)
                 }
 
                 // res.set_header("Cache-Control", "public, max-age=86400");
-                std::ifstream inf(absolutePath);
-                if (!inf)
-                {
-                    BMCWEB_LOG_DEBUG << "failed to read file";
-                    asyncResp->res.result(
-                        boost::beast::http::status::internal_server_error);
-                    return;
-                }
-
-                asyncResp->res.body() = {std::istreambuf_iterator<char>(inf),
-                                         std::istreambuf_iterator<char>()};
+                bmcweb::asyncReadFile(
+                    connections::systemBus->get_io_context(), absolutePath,
+                    maxAssetSize,
+                    [asyncResp](const boost::system::error_code& ec,
+                                std::string&& data) {
+                    if (ec)
+                    {
+                        BMCWEB_LOG_DEBUG << "failed to read file: " << ec;
+                        asyncResp->res.result(
+                            boost::beast::http::status::internal_server_error);
+                        return;
+                    }
+                    asyncResp->res.body() = std::move(data);
+                });
             });
         }
     }
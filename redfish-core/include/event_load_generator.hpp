@@ -0,0 +1,307 @@
+#pragma once
+
+#include "dbus_singleton.hpp"
+#include "event_service_manager.hpp"
+#include "http_client.hpp"
+#include "logging.hpp"
+#include "utils/time_utils.hpp"
+
+#include <sys/resource.h>
+
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief Injects synthetic events into the EventServiceManager at a fixed
+ * rate, to measure how many events per second it can deliver to its
+ * subscribers.
+ *
+ * Events go through EventServiceManager::sendEvent, or, with viaEventLog,
+ * through the same filterAndSendEventLogs path as entries read from the
+ * Redfish event log.  The first MessageArg of each event is a marker,
+ * "LoadTest:<sequence>:<microseconds since the epoch when sent>", from
+ * which a sink can work out delivery latency and missing events; the second
+ * pads the event out to the requested payload size.  Delivery counts come
+ * from the subscription HttpClient.  scripts/event_load_benchmark.py runs a
+ * sink and drives the generator.
+ */
+class EventLoadGenerator
+{
+  public:
+    struct Params
+    {
+        uint64_t eventsPerSecond = 0;
+        uint64_t count = 0;
+        size_t payloadBytes = 0;
+        bool viaEventLog = false;
+    };
+
+    static constexpr uint64_t maxEventsPerSecond = 100000;
+    static constexpr uint64_t maxCount = 10000000;
+    static constexpr size_t maxPayloadBytes = 65536;
+
+    // MessageId of the synthetic events; it takes two string arguments
+    static constexpr std::string_view messageId =
+        "Base.1.13.PropertyValueModified";
+
+    EventLoadGenerator(const EventLoadGenerator&) = delete;
+    EventLoadGenerator& operator=(const EventLoadGenerator&) = delete;
+    EventLoadGenerator(EventLoadGenerator&&) = delete;
+    EventLoadGenerator& operator=(EventLoadGenerator&&) = delete;
+    ~EventLoadGenerator() = default;
+
+    static EventLoadGenerator& getInstance()
+    {
+        static EventLoadGenerator generator(
+            crow::connections::systemBus->get_io_context());
+        return generator;
+    }
+
+    bool isRunning() const
+    {
+        return running;
+    }
+
+    void start(const Params& paramsIn)
+    {
+        params = paramsIn;
+        running = true;
+        sent = 0;
+        padding.assign(params.payloadBytes, 'x');
+        startedAt = std::chrono::steady_clock::now();
+        finishedAt = startedAt;
+        cpuAtStart = cpuTime();
+        cpuAtFinish = cpuAtStart;
+        deliveryAtStart = getSubscriptionClient().getStats();
+        BMCWEB_LOG_INFO << "Starting event load test, "
+                        << params.eventsPerSecond << " events/s, "
+                        << params.count << " events of "
+                        << params.payloadBytes << " bytes";
+        onTick();
+    }
+
+    void stop()
+    {
+        if (!running)
+        {
+            return;
+        }
+        timer.cancel();
+        finish();
+    }
+
+    nlohmann::json::object_t getStatus() const
+    {
+        std::chrono::steady_clock::time_point end =
+            running ? std::chrono::steady_clock::now() : finishedAt;
+        double elapsed =
+            std::chrono::duration<double>(end - startedAt).count();
+        double cpu = std::chrono::duration<double>(
+                         (running ? cpuTime() : cpuAtFinish) - cpuAtStart)
+                         .count();
+        const crow::DeliveryStats& delivery =
+            getSubscriptionClient().getStats();
+
+        nlohmann::json::object_t status;
+        status["Running"] = running;
+        status["Path"] = params.viaEventLog ? "EventLog" : "SendEvent";
+        status["EventsPerSecond"] = params.eventsPerSecond;
+        status["PayloadBytes"] = params.payloadBytes;
+        status["Count"] = params.count;
+        status["EventsSent"] = sent;
+        status["ElapsedSeconds"] = elapsed;
+        status["AchievedEventsPerSecond"] =
+            elapsed > 0 ? static_cast<double>(sent) / elapsed : 0.0;
+        status["CpuSeconds"] = cpu;
+        status["CpuPercent"] = elapsed > 0 ? 100.0 * cpu / elapsed : 0.0;
+        // Counted over all subscriptions, and including any events not sent
+        // by the generator while it ran
+        status["Delivered"] = delivery.delivered - deliveryAtStart.delivered;
+        status["Failed"] = delivery.failed - deliveryAtStart.failed;
+        status["Dropped"] = delivery.dropped - deliveryAtStart.dropped;
+        status["Retries"] = delivery.retries - deliveryAtStart.retries;
+        return status;
+    }
+
+    // How many of count events should have been sent elapsed into a run at
+    // eventsPerSecond
+    static uint64_t eventsDue(std::chrono::steady_clock::duration elapsed,
+                              uint64_t eventsPerSecond, uint64_t count)
+    {
+        uint64_t elapsedUs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count());
+        // Split up so that a long run at a high rate can't overflow
+        uint64_t due = (elapsedUs / 1000000) * eventsPerSecond +
+                       (elapsedUs % 1000000) * eventsPerSecond / 1000000;
+        return std::min(due, count);
+    }
+
+    static std::string makeMarker(uint64_t sequence,
+                                  std::chrono::system_clock::time_point sentAt)
+    {
+        return "LoadTest:" + std::to_string(sequence) + ":" +
+               std::to_string(
+                   std::chrono::duration_cast<std::chrono::microseconds>(
+                       sentAt.time_since_epoch())
+                       .count());
+    }
+
+    struct Marker
+    {
+        uint64_t sequence = 0;
+        uint64_t sentAtUs = 0;
+    };
+
+    static std::optional<Marker> parseMarker(std::string_view marker)
+    {
+        constexpr std::string_view prefix = "LoadTest:";
+        if (!marker.starts_with(prefix))
+        {
+            return std::nullopt;
+        }
+        marker.remove_prefix(prefix.size());
+        Marker ret;
+        const char* end = marker.data() + marker.size();
+        auto [ptr, ec] = std::from_chars(marker.data(), end, ret.sequence);
+        if (ec != std::errc() || ptr == end || *ptr != ':')
+        {
+            return std::nullopt;
+        }
+        auto [ptr2, ec2] = std::from_chars(ptr + 1, end, ret.sentAtUs);
+        if (ec2 != std::errc() || ptr2 != end)
+        {
+            return std::nullopt;
+        }
+        return ret;
+    }
+
+  private:
+    explicit EventLoadGenerator(boost::asio::io_context& ioc) : timer(ioc) {}
+
+    // Events are sent in batches, as many as are due, on a fixed tick, so
+    // high rates don't need a timer per event
+    static constexpr std::chrono::milliseconds tick{10};
+
+    static std::chrono::microseconds cpuTime()
+    {
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return std::chrono::microseconds(0);
+        }
+        return std::chrono::seconds(usage.ru_utime.tv_sec) +
+               std::chrono::microseconds(usage.ru_utime.tv_usec) +
+               std::chrono::seconds(usage.ru_stime.tv_sec) +
+               std::chrono::microseconds(usage.ru_stime.tv_usec);
+    }
+
+    void onTick()
+    {
+        uint64_t due = eventsDue(std::chrono::steady_clock::now() - startedAt,
+                                 params.eventsPerSecond, params.count);
+        if (params.viaEventLog)
+        {
+            sendEventLogRecords(due);
+        }
+        else
+        {
+            while (sent < due)
+            {
+                sendOne();
+            }
+        }
+        if (sent >= params.count)
+        {
+            finish();
+            return;
+        }
+        timer.expires_after(tick);
+        timer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            onTick();
+        });
+    }
+
+    void sendOne()
+    {
+        sent++;
+        nlohmann::json::object_t event;
+        event["EventType"] = "Event";
+        event["MessageId"] = messageId;
+        event["Message"] = "Generated load test event";
+        event["Severity"] = "OK";
+        event["MessageArgs"] = nlohmann::json::array(
+            {makeMarker(sent, std::chrono::system_clock::now()), padding});
+        EventServiceManager::getInstance().sendEvent(
+            std::move(event), "/redfish/v1/EventService", "EventService");
+    }
+
+    void sendEventLogRecords([[maybe_unused]] uint64_t due)
+    {
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+        std::vector<EventLogObjectsType> records;
+        std::string timestamp =
+            redfish::time_utils::getDateTimeOffsetNow().first;
+        while (sent < due)
+        {
+            sent++;
+            records.emplace_back(
+                "LoadTest" + std::to_string(sent), timestamp,
+                std::string(messageId), "Base", "PropertyValueModified",
+                std::vector<std::string>{
+                    makeMarker(sent, std::chrono::system_clock::now()),
+                    padding});
+        }
+        if (!records.empty())
+        {
+            EventServiceManager::getInstance().sendEventLogRecords(records);
+        }
+#else
+        // Only the D-Bus event log is built in, so there is nothing to go
+        // through but sendEvent
+        while (sent < due)
+        {
+            sendOne();
+        }
+#endif
+    }
+
+    void finish()
+    {
+        running = false;
+        finishedAt = std::chrono::steady_clock::now();
+        cpuAtFinish = cpuTime();
+        BMCWEB_LOG_INFO << "Event load test finished after sending " << sent
+                        << " events";
+    }
+
+    boost::asio::steady_timer timer;
+    Params params;
+    bool running = false;
+    uint64_t sent = 0;
+    std::string padding;
+    std::chrono::steady_clock::time_point startedAt;
+    std::chrono::steady_clock::time_point finishedAt;
+    std::chrono::microseconds cpuAtStart{0};
+    std::chrono::microseconds cpuAtFinish{0};
+    crow::DeliveryStats deliveryAtStart;
+};
+
+} // namespace redfish
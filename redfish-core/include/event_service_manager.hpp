@@ -14,6 +14,7 @@
 // limitations under the License.
 */
 #pragma once
+#include "memory_accounting.hpp"
 #include "metric_report.hpp"
 #include "registries.hpp"
 #include "registries/base_message_registry.hpp"
@@ -362,6 +363,17 @@ inline bool
     return true;
 }
 
+// All subscriptions send through this one client, so subscriptions to the
+// same listener share its connection pool (sockets, TLS sessions and
+// queue) rather than each keeping their own.  Each subscription still
+// applies its own retry policy to its events, and queues them under its id,
+// so they can be dropped when it is deleted.
+inline crow::HttpClient& getSubscriptionClient()
+{
+    static crow::HttpClient client(std::make_shared<crow::ConnectionPolicy>());
+    return client;
+}
+
 class Subscription : public persistent_data::UserSubscription
 {
   public:
@@ -374,7 +386,7 @@ class Subscription : public persistent_data::UserSubscription
                  const std::string& inPath, const std::string& inUriProto) :
         host(inHost),
         port(inPort), policy(std::make_shared<crow::ConnectionPolicy>()),
-        client(policy), path(inPath), uriProto(inUriProto)
+        path(inPath), uriProto(inUriProto)
     {
         // Subscription constructor
         policy->invalidResp = retryRespHandler;
@@ -383,7 +395,6 @@ class Subscription : public persistent_data::UserSubscription
     explicit Subscription(
         const std::shared_ptr<boost::asio::ip::tcp::socket>& adaptor) :
         policy(std::make_shared<crow::ConnectionPolicy>()),
-        client(policy),
         sseConn(std::make_shared<crow::ServerSentEvents>(adaptor))
     {}
 
@@ -406,8 +417,10 @@ class Subscription : public persistent_data::UserSubscription
 
         bool useSSL = (uriProto == "https");
         // A connection pool will be created if one does not already exist
-        client.sendData(msg, host, port, path, useSSL, httpHeaders,
-                        boost::beast::http::verb::post);
+        getSubscriptionClient().sendData(msg, host, port, path, useSSL,
+                                         httpHeaders,
+                                         boost::beast::http::verb::post,
+                                         policy, id);
         eventSeqNum++;
 
         if (sseConn != nullptr)
@@ -570,7 +583,6 @@ class Subscription : public persistent_data::UserSubscription
     std::string host;
     uint16_t port = 0;
     std::shared_ptr<crow::ConnectionPolicy> policy;
-    crow::HttpClient client;
     std::string path;
     std::string uriProto;
     std::shared_ptr<crow::ServerSentEvents> sseConn = nullptr;
@@ -958,6 +970,8 @@ class EventServiceManager
         if (obj != subscriptionsMap.end())
         {
             subscriptionsMap.erase(obj);
+            // Events still queued for it are not wanted any more
+            getSubscriptionClient().removeOwner(id);
             auto obj2 = persistent_data::EventServiceStore::getInstance()
                             .subscriptionsConfigMap.find(id);
             persistent_data::EventServiceStore::getInstance()
@@ -1012,6 +1026,8 @@ class EventServiceManager
     void sendEvent(nlohmann::json eventMessage, const std::string& origin,
                    const std::string& resType)
     {
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("EventServiceManager"));
         if (!serviceEnabled || (noOfEventLogSubscribers == 0U))
         {
             BMCWEB_LOG_DEBUG << "EventService disabled or no Subscriptions.";
@@ -1109,6 +1125,8 @@ class EventServiceManager
 
     void readEventLogsFromFile()
     {
+        bmcweb::memory::Scope memoryScope(
+            bmcweb::memory::subsystem("EventServiceManager"));
         std::ifstream logStream(redfishEventLogFile);
         if (!logStream.good())
         {
@@ -1178,12 +1196,18 @@ class EventServiceManager
             return;
         }
 
+        sendEventLogRecords(eventRecords);
+    }
+
+    // Sends event log records to the subscriptions that want them
+    void sendEventLogRecords(const std::vector<EventLogObjectsType>& records)
+    {
         for (const auto& it : this->subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
             if (entry->eventFormatType == "Event")
             {
-                entry->filterAndSendEventLogs(eventRecords);
+                entry->filterAndSendEventLogs(records);
             }
         }
     }
@@ -46,7 +46,7 @@ inline void
         return;
     }
     // Restart the request without if-match
-    req.req.erase(boost::beast::http::field::if_match);
+    req.clearHeader(boost::beast::http::field::if_match);
     BMCWEB_LOG_DEBUG << "Restarting request";
     app.handle(req, asyncResp, true);
 }
@@ -68,9 +68,9 @@ inline bool handleIfMatch(crow::App& app, const crow::Request& req,
         // No If-Match header.  Nothing to do
         return true;
     }
-    if (req.req.method() != boost::beast::http::verb::patch &&
-        req.req.method() != boost::beast::http::verb::post &&
-        req.req.method() != boost::beast::http::verb::delete_)
+    if (req.method() != boost::beast::http::verb::patch &&
+        req.method() != boost::beast::http::verb::post &&
+        req.method() != boost::beast::http::verb::delete_)
     {
         messages::preconditionFailed(asyncResp->res);
         return false;
@@ -96,6 +96,7 @@ inline bool handleIfMatch(crow::App& app, const crow::Request& req,
 
     getReqAsyncResp->res.setCompleteRequestHandler(std::bind_front(
         afterIfMatchRequest, std::ref(app), asyncResp, req, ifMatch));
+    getReqAsyncResp->res.setTraceContext(asyncResp->res.getTraceContext());
 
     app.handle(newReq, getReqAsyncResp, true);
     return false;
@@ -269,6 +269,10 @@ class RedfishService
         requestRoutesPort(app);
         requestRoutesPortCollection(app);
         requestRoutesSubmitTestEvent(app);
+        requestRoutesEventDeliveryStats(app);
+#ifdef BMCWEB_ENABLE_EVENT_LOAD_GENERATOR
+        requestRoutesEventLoadGenerator(app);
+#endif
 
         hypervisor::requestRoutesHypervisorSystems(app);
         crow::obmc_dump::requestRoutes(app);
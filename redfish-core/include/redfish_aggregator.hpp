@@ -443,18 +443,9 @@ class RedfishAggregator
             return;
         }
 
-        // Create a copy of thisReq so we we can still locally process the req
-        std::error_code ec;
-        auto localReq = std::make_shared<crow::Request>(thisReq.req, ec);
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR << "Failed to create copy of request";
-            if (isCollection != AggregationType::Collection)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
+        // Create a copy of thisReq so we we can still locally process the req.
+        // The copy shares thisReq's headers and body.
+        auto localReq = std::make_shared<crow::Request>(thisReq);
 
         getSatelliteConfigs(std::bind_front(aggregateAndHandle, isCollection,
                                             localReq, asyncResp));
@@ -602,10 +593,11 @@ class RedfishAggregator
         std::function<void(crow::Response&)> cb =
             std::bind_front(processResponse, prefix, asyncResp);
 
-        std::string data = thisReq.req.body();
+        std::string data = thisReq.body();
         client.sendDataWithCallback(
             data, std::string(sat->second.host()), sat->second.port_number(),
-            targetURI, false /*useSSL*/, thisReq.fields, thisReq.method(), cb);
+            targetURI, false /*useSSL*/, thisReq.fields(), thisReq.method(),
+            cb);
     }
 
     // Forward a request for a collection URI to each known satellite BMC
@@ -620,10 +612,10 @@ class RedfishAggregator
                 processCollectionResponse, sat.first, asyncResp);
 
             std::string targetURI(thisReq.target());
-            std::string data = thisReq.req.body();
+            std::string data = thisReq.body();
             client.sendDataWithCallback(data, std::string(sat.second.host()),
                                         sat.second.port_number(), targetURI,
-                                        false /*useSSL*/, thisReq.fields,
+                                        false /*useSSL*/, thisReq.fields(),
                                         thisReq.method(), cb);
         }
     }
@@ -5,11 +5,15 @@
 #include "error_messages.hpp"
 #include "http/utility.hpp"
 #include "human_sort.hpp"
+#include "utils/query_param.hpp"
 
 #include <boost/url/url.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <span>
 #include <string>
 #include <string_view>
@@ -20,6 +24,70 @@ namespace redfish
 namespace collection_util
 {
 
+/**
+ * @brief Orders the ids of a collection's members as they are listed, but
+ * only as far as needed to find the page of at most top members that starts
+ * at skip.
+ *
+ * @return The ids on the page, in order
+ */
+inline std::span<std::string> sortPage(std::vector<std::string>& ids,
+                                       size_t skip, size_t top)
+{
+    skip = std::min(skip, ids.size());
+    top = std::min(top, ids.size() - skip);
+    auto first = ids.begin() + static_cast<std::ptrdiff_t>(skip);
+    auto last = first + static_cast<std::ptrdiff_t>(top);
+    AlphanumLess<std::string> less;
+    if (first != ids.begin())
+    {
+        // Everything before the page, in no particular order
+        std::nth_element(ids.begin(), first, ids.end(), less);
+    }
+    std::partial_sort(first, last, ids.end(), less);
+    return {first, last};
+}
+
+/**
+ * @brief Sets the Members of a collection to the page of ids that a query
+ * asks for.  Only the members on the page are turned into JSON, but
+ * Members@odata.count counts all of them, and Members@odata.nextLink points
+ * at the rest, if there are more.
+ */
+inline void setMembers(nlohmann::json& json,
+                       const boost::urls::url& collectionPath,
+                       std::vector<std::string>& ids, size_t skip, size_t top)
+{
+    size_t count = ids.size();
+    std::span<std::string> page = sortPage(ids, skip, top);
+
+    nlohmann::json::array_t members;
+    members.reserve(page.size());
+    for (const std::string& leaf : page)
+    {
+        boost::urls::url url = collectionPath;
+        crow::utility::appendUrlPieces(url, leaf);
+        nlohmann::json::object_t member;
+        member["@odata.id"] = std::move(url);
+        members.emplace_back(std::move(member));
+    }
+    json["Members"] = std::move(members);
+    json["Members@odata.count"] = count;
+
+    size_t pageEnd = std::min(skip, count) + page.size();
+    if (pageEnd < count)
+    {
+        // The next page is the same size as this one
+        std::string nextLink = std::string(collectionPath.buffer()) +
+                               "?$skip=" + std::to_string(pageEnd);
+        if (top != std::numeric_limits<size_t>::max())
+        {
+            nextLink += "&$top=" + std::to_string(top);
+        }
+        json["Members@odata.nextLink"] = std::move(nextLink);
+    }
+}
+
 /**
  * @brief Populate the collection "Members" from a GetSubTreePaths search of
  *        inventory
@@ -31,6 +99,8 @@ namespace collection_util
  * @param[i]   func getMembersFromPaths    Convert pathnames to member
  * objects
  * @param[in]  subtree     D-Bus base path to constrain search to.
+ * @param[in]  query       $top and $skip, delegated by the handler, to only
+ *             return that page of members.
  *
  * @return void
  */
@@ -41,14 +111,17 @@ inline void getCollectionMembersWithPathConversion(
     std::function<void(std::vector<std::string>&,
                        const dbus::utility::MapperGetSubTreePathsResponse&)>&&
         getMembersFromPaths,
-    const char* subtree = "/xyz/openbmc_project/inventory")
+    const char* subtree = "/xyz/openbmc_project/inventory",
+    const query_param::Query& query = {})
 {
     BMCWEB_LOG_DEBUG << "Get collection members for: "
                      << collectionPath.buffer();
     dbus::utility::getSubTreePaths(
         subtree, 0, interfaces,
         [collectionPath, aResp{std::move(aResp)},
-         getMembersFromPaths{std::move(getMembersFromPaths)}](
+         getMembersFromPaths{std::move(getMembersFromPaths)},
+         skip{query.skip.value_or(0)},
+         top{query.top.value_or(std::numeric_limits<size_t>::max())}](
             const boost::system::error_code& ec,
             const dbus::utility::MapperGetSubTreePathsResponse& objects) {
         if (ec == boost::system::errc::io_error)
@@ -67,21 +140,7 @@ inline void getCollectionMembersWithPathConversion(
 
         std::vector<std::string> pathNames;
         getMembersFromPaths(pathNames, objects);
-
-        std::sort(pathNames.begin(), pathNames.end(),
-                  AlphanumLess<std::string>());
-
-        nlohmann::json& members = aResp->res.jsonValue["Members"];
-        members = nlohmann::json::array();
-        for (const std::string& leaf : pathNames)
-        {
-            boost::urls::url url = collectionPath;
-            crow::utility::appendUrlPieces(url, leaf);
-            nlohmann::json::object_t member;
-            member["@odata.id"] = std::move(url);
-            members.push_back(std::move(member));
-        }
-        aResp->res.jsonValue["Members@odata.count"] = members.size();
+        setMembers(aResp->res.jsonValue, collectionPath, pathNames, skip, top);
     });
 }
 
@@ -94,6 +153,8 @@ inline void getCollectionMembersWithPathConversion(
  *             Members Redfish Path
  * @param[i]   interfaces  List of interfaces to constrain the GetSubTree search
  * @param[in]  subtree     D-Bus base path to constrain search to.
+ * @param[in]  query       $top and $skip, delegated by the handler, to only
+ *             return that page of members.
  *
  * @return void
  */
@@ -101,7 +162,8 @@ inline void
     getCollectionMembers(std::shared_ptr<bmcweb::AsyncResp> aResp,
                          const boost::urls::url& collectionPath,
                          std::span<const std::string_view> interfaces,
-                         const char* subtree = "/xyz/openbmc_project/inventory")
+                         const char* subtree = "/xyz/openbmc_project/inventory",
+                         const query_param::Query& query = {})
 {
     auto getMembersFromPaths =
         [](std::vector<std::string>& pathNames,
@@ -120,7 +182,7 @@ inline void
 
     getCollectionMembersWithPathConversion(
         std::move(aResp), collectionPath, interfaces,
-        std::move(getMembersFromPaths), subtree);
+        std::move(getMembersFromPaths), subtree, query);
 }
 
 } // namespace collection_util
@@ -0,0 +1,366 @@
+#pragma once
+
+#include "cancellation.hpp"
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message/native_types.hpp>
+#include <sdbusplus/unpack_properties.hpp>
+#include <utils/dbus_utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace sw_util
+{
+
+constexpr const char* softwareRoot = "/xyz/openbmc_project/software";
+
+/**
+ * @brief One object implementing xyz.openbmc_project.Software.Version
+ */
+struct SoftwareImage
+{
+    std::string id;
+    std::string path;
+    std::string service;
+    std::string version;
+    std::string purpose;
+    // Not every software object is updateable, so these may be missing
+    std::optional<std::string> activation;
+    std::optional<uint8_t> priority;
+    bool functional = false;
+    bool updateable = false;
+};
+
+using SoftwareImages = std::vector<SoftwareImage>;
+
+/**
+ * @brief In memory model of the software objects under softwareRoot.
+ *
+ * Manager, System, Bios and FirmwareInventory resources all need the same
+ * view of the installed images (versions, purposes, activation state,
+ * priority and functional/updateable associations).  Rather than have every
+ * GET re-walk the mapper and the software manager, the model is built once,
+ * and dropped whenever a software object or association under softwareRoot
+ * is added, removed or changes a property.  The next reader rebuilds it, and
+ * readers that arrive while a rebuild is in flight share its result.
+ */
+class FirmwareInventoryCache
+{
+  public:
+    using Callback = std::function<void(const boost::system::error_code&,
+                                        const SoftwareImages&)>;
+
+    FirmwareInventoryCache(const FirmwareInventoryCache&) = delete;
+    FirmwareInventoryCache(FirmwareInventoryCache&&) = delete;
+    FirmwareInventoryCache& operator=(const FirmwareInventoryCache&) = delete;
+    FirmwareInventoryCache& operator=(FirmwareInventoryCache&&) = delete;
+    ~FirmwareInventoryCache() = default;
+
+    static FirmwareInventoryCache& getInstance()
+    {
+        static FirmwareInventoryCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief Calls callback with the current software images, reading them
+     * from D-Bus first if the model is not populated.
+     */
+    void getImages(Callback&& callback)
+    {
+        if (images)
+        {
+            callback(boost::system::error_code(), *images);
+            return;
+        }
+        waiters.emplace_back(std::move(callback));
+        if (waiters.size() == 1)
+        {
+            refresh();
+        }
+    }
+
+    void invalidate()
+    {
+        BMCWEB_LOG_DEBUG << "Firmware inventory changed, dropping cache";
+        images.reset();
+        generation++;
+    }
+
+  private:
+    // Collects the results of one rebuild.  The model is published once all
+    // of the D-Bus calls it started have answered, when the last reference
+    // goes away.
+    struct Refresh
+    {
+        Refresh(FirmwareInventoryCache& cacheIn, uint64_t generationIn) :
+            cache(cacheIn), generation(generationIn)
+        {}
+
+        Refresh(const Refresh&) = delete;
+        Refresh(Refresh&&) = delete;
+        Refresh& operator=(const Refresh&) = delete;
+        Refresh& operator=(Refresh&&) = delete;
+
+        ~Refresh()
+        {
+            std::erase_if(found, [](const SoftwareImage& image) {
+                return image.version.empty() && image.purpose.empty();
+            });
+            cache.complete(generation, ec, std::move(found));
+        }
+
+        FirmwareInventoryCache& cache;
+        uint64_t generation;
+        boost::system::error_code ec;
+        SoftwareImages found;
+        std::vector<std::string> functionalPaths;
+        std::vector<std::string> updateablePaths;
+    };
+
+    FirmwareInventoryCache()
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        auto onChange = [this](sdbusplus::message_t&) { invalidate(); };
+
+        interfacesAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesAdded() +
+                rules::argNpath(0, std::string(softwareRoot) + "/"),
+            onChange);
+        interfacesRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesRemoved() +
+                rules::argNpath(0, std::string(softwareRoot) + "/"),
+            onChange);
+        // Covers Version, Activation and RedundancyPriority, as well as the
+        // functional and updateable association endpoints, which the mapper
+        // hosts under the same namespace.
+        propertiesChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',interface='org.freedesktop.DBus.Properties',"
+            "member='PropertiesChanged',path_namespace='" +
+                std::string(softwareRoot) + "'",
+            onChange);
+    }
+
+    void complete(uint64_t refreshGeneration,
+                  const boost::system::error_code& ec, SoftwareImages&& found)
+    {
+        std::vector<Callback> callbacks = std::move(waiters);
+        waiters.clear();
+
+        if (!ec && refreshGeneration == generation)
+        {
+            images = std::move(found);
+            for (Callback& callback : callbacks)
+            {
+                callback(ec, *images);
+            }
+            return;
+        }
+        if (ec)
+        {
+            for (Callback& callback : callbacks)
+            {
+                callback(ec, found);
+            }
+            return;
+        }
+
+        // Something changed while reading, and the result may be a mix of
+        // old and new state.  Hand it to the waiting readers, which are no
+        // worse off than if they had read D-Bus themselves, but don't keep
+        // it.
+        BMCWEB_LOG_DEBUG << "Firmware inventory changed during refresh";
+        for (Callback& callback : callbacks)
+        {
+            callback(ec, found);
+        }
+    }
+
+    static void readImageProperties(const std::shared_ptr<Refresh>& refresh,
+                                    size_t index,
+                                    const std::vector<std::string>& interfaces)
+    {
+        const SoftwareImage& image = refresh->found[index];
+        dbus::utility::getAllProperties(
+            image.service, image.path,
+            "xyz.openbmc_project.Software.Version",
+            [refresh, index](const boost::system::error_code& ec,
+                             const dbus::utility::DBusPropertiesMap& props) {
+            if (ec == boost::asio::error::operation_aborted)
+            {
+                // Not an answer, so the model would be missing the image
+                refresh->ec = ec;
+                return;
+            }
+            if (ec)
+            {
+                // Have seen the code update app delete the D-Bus object,
+                // during code update, between the call to mapper and here.
+                // Leave the image out.
+                BMCWEB_LOG_DEBUG << "Version read failed " << ec;
+                return;
+            }
+            const std::string* version = nullptr;
+            const std::string* purpose = nullptr;
+            if (!sdbusplus::unpackPropertiesNoThrow(
+                    dbus_utils::UnpackErrorPrinter(), props, "Purpose",
+                    purpose, "Version", version))
+            {
+                return;
+            }
+            SoftwareImage& found = refresh->found[index];
+            if (version != nullptr)
+            {
+                found.version = *version;
+            }
+            if (purpose != nullptr)
+            {
+                found.purpose = *purpose;
+            }
+        });
+
+        if (std::ranges::find(interfaces,
+                              "xyz.openbmc_project.Software.Activation") !=
+            interfaces.end())
+        {
+            sdbusplus::asio::getProperty<std::string>(
+                *crow::connections::systemBus, image.service, image.path,
+                "xyz.openbmc_project.Software.Activation", "Activation",
+                [refresh, index](const boost::system::error_code& ec,
+                                 const std::string& activation) {
+                if (!ec)
+                {
+                    refresh->found[index].activation = activation;
+                }
+            });
+        }
+        if (std::ranges::find(interfaces,
+                              "xyz.openbmc_project.Software."
+                              "RedundancyPriority") != interfaces.end())
+        {
+            sdbusplus::asio::getProperty<uint8_t>(
+                *crow::connections::systemBus, image.service, image.path,
+                "xyz.openbmc_project.Software.RedundancyPriority", "Priority",
+                [refresh, index](const boost::system::error_code& ec,
+                                 uint8_t priority) {
+                if (!ec)
+                {
+                    refresh->found[index].priority = priority;
+                }
+            });
+        }
+    }
+
+    void refresh()
+    {
+        // The model is shared, so the request that happens to start the
+        // rebuild, and its deadline, mustn't be able to cut it short
+        crow::CancellationScope noCancellation(nullptr);
+        auto refresh = std::make_shared<Refresh>(*this, generation);
+
+        constexpr std::array<std::string_view, 1> interfaces = {
+            "xyz.openbmc_project.Software.Version"};
+        dbus::utility::getSubTree(
+            softwareRoot, 0, interfaces,
+            [refresh](const boost::system::error_code& ec,
+                      const dbus::utility::MapperGetSubTreeResponse& subtree) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Software subtree read failed " << ec;
+                refresh->ec = ec;
+                return;
+            }
+            // An image missing from these lists is simply not functional
+            // or updateable, so errors are not fatal.
+            dbus::utility::getAssociationEndPoints(
+                std::string(softwareRoot) + "/functional",
+                [refresh, subtree](
+                    const boost::system::error_code& ec2,
+                    const dbus::utility::MapperEndPoints& functional) {
+                if (!ec2)
+                {
+                    refresh->functionalPaths = functional;
+                }
+                dbus::utility::getAssociationEndPoints(
+                    std::string(softwareRoot) + "/updateable",
+                    [refresh, subtree](
+                        const boost::system::error_code& ec3,
+                        const dbus::utility::MapperEndPoints& updateable) {
+                    if (!ec3)
+                    {
+                        refresh->updateablePaths = updateable;
+                    }
+                    readImages(refresh, subtree);
+                });
+            });
+        });
+    }
+
+    static void
+        readImages(const std::shared_ptr<Refresh>& refresh,
+                   const dbus::utility::MapperGetSubTreeResponse& subtree)
+    {
+        std::vector<const std::vector<std::string>*> interfaceLists;
+        refresh->found.reserve(subtree.size());
+        for (const auto& [path, serviceMap] : subtree)
+        {
+            sdbusplus::message::object_path objPath(path);
+            std::string swId = objPath.filename();
+            if (swId.empty() || serviceMap.empty())
+            {
+                BMCWEB_LOG_ERROR << "Invalid software object " << path;
+                continue;
+            }
+            SoftwareImage& image = refresh->found.emplace_back();
+            image.id = std::move(swId);
+            image.path = path;
+            image.service = serviceMap[0].first;
+            image.functional =
+                std::ranges::find(refresh->functionalPaths, path) !=
+                refresh->functionalPaths.end();
+            image.updateable =
+                std::ranges::find(refresh->updateablePaths, path) !=
+                refresh->updateablePaths.end();
+            interfaceLists.push_back(&serviceMap[0].second);
+        }
+        // found is fully built at this point, so the indexes handed to the
+        // property reads stay valid until they answer.
+        for (size_t index = 0; index < interfaceLists.size(); index++)
+        {
+            readImageProperties(refresh, index, *interfaceLists[index]);
+        }
+    }
+
+    std::optional<SoftwareImages> images;
+    // Bumped on every change signal, so a refresh that raced with a change
+    // is not cached.
+    uint64_t generation = 0;
+    std::vector<Callback> waiters;
+
+    std::unique_ptr<sdbusplus::bus::match_t> interfacesAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> interfacesRemovedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> propertiesChangedMatch;
+};
+
+} // namespace sw_util
+} // namespace redfish
@@ -636,8 +636,8 @@ inline void
             }
 
             // Get event properties and fill into status conditions
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, objType[0].first,
+            dbus::utility::getAllProperties(
+                objType[0].first,
                 hwStatusEventObj, "",
                 [aResp, hwStatusEventObj](
                     const boost::system::error_code ec2,
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "cancellation.hpp"
+#include "dbus_singleton.hpp"
+#include "dbus_utility.hpp"
+#include "logging.hpp"
+
+#include <boost/container/flat_map.hpp>
+#include <boost/system/error_code.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message/native_types.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+namespace led_util
+{
+
+constexpr const char* ledGroupManager = "xyz.openbmc_project.LED.GroupManager";
+constexpr const char* ledGroupsRoot = "/xyz/openbmc_project/led/groups";
+
+// LED group object path to its Asserted property
+using LedGroupStates = boost::container::flat_map<std::string, bool>;
+
+/**
+ * @brief In memory copy of the LED group states, and of which groups
+ * identify each inventory item.
+ *
+ * Reporting LocationIndicatorActive takes a mapper lookup of the item's
+ * identifying association, then a mapper lookup and a property read per LED
+ * group, which an $expand of a collection of DIMMs, fans or slots repeats
+ * for every member.  Instead, the states of all groups are read with one
+ * GetManagedObjects of the group manager, and shared until a group changes.
+ * Associations are looked up once per item, and kept until the mapper
+ * changes that item's identifying association.
+ */
+class LedStateCache
+{
+  public:
+    using StatesCallback = std::function<void(
+        const boost::system::error_code&, const LedGroupStates&)>;
+    using EndpointsCallback = std::function<void(
+        const boost::system::error_code&, const std::vector<std::string>&)>;
+
+    LedStateCache(const LedStateCache&) = delete;
+    LedStateCache(LedStateCache&&) = delete;
+    LedStateCache& operator=(const LedStateCache&) = delete;
+    LedStateCache& operator=(LedStateCache&&) = delete;
+    ~LedStateCache() = default;
+
+    static LedStateCache& getInstance()
+    {
+        static LedStateCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief Calls callback with the Asserted state of every LED group of
+     * the group manager, reading them from D-Bus first if not cached.
+     */
+    void getGroupStates(StatesCallback&& callback)
+    {
+        if (states)
+        {
+            callback(boost::system::error_code(), *states);
+            return;
+        }
+        waiters.emplace_back(std::move(callback));
+        if (waiters.size() == 1)
+        {
+            refreshStates();
+        }
+    }
+
+    /**
+     * @brief Calls callback with the LED groups that identify objPath, which
+     * is empty if the item has no identifying association.
+     */
+    void getIdentifyingLeds(const std::string& objPath,
+                            EndpointsCallback&& callback)
+    {
+        auto it = identifying.find(objPath);
+        if (it != identifying.end())
+        {
+            callback(boost::system::error_code(), it->second);
+            return;
+        }
+        // The answer is cached for everyone, so not cut short with the
+        // request that asked
+        crow::CancellationScope noCancellation(nullptr);
+        dbus::utility::getAssociationEndPoints(
+            objPath + "/identifying",
+            [this, objPath, callback{std::move(callback)},
+             lookupGeneration{associationGeneration}](
+                const boost::system::error_code& ec,
+                const dbus::utility::MapperEndPoints& endpoints) {
+            // EBADR means there is no such association, which is as worth
+            // remembering as the endpoints of one
+            if (ec && ec.value() != EBADR)
+            {
+                callback(ec, endpoints);
+                return;
+            }
+            if (lookupGeneration == associationGeneration)
+            {
+                identifying.insert_or_assign(objPath, endpoints);
+            }
+            callback(boost::system::error_code(), endpoints);
+        });
+    }
+
+    void invalidateStates()
+    {
+        BMCWEB_LOG_DEBUG << "LED groups changed, dropping cache";
+        states.reset();
+        generation++;
+    }
+
+  private:
+    LedStateCache()
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        auto onGroupChange = [this](sdbusplus::message_t&) {
+            invalidateStates();
+        };
+
+        groupChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',interface='org.freedesktop.DBus.Properties',"
+            "member='PropertiesChanged',path_namespace='" +
+                std::string(ledGroupsRoot) + "'",
+            onGroupChange);
+        groupAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesAdded() +
+                rules::argNpath(0, std::string(ledGroupsRoot) + "/"),
+            onGroupChange);
+        groupRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesRemoved() +
+                rules::argNpath(0, std::string(ledGroupsRoot) + "/"),
+            onGroupChange);
+
+        // The mapper hosts associations as <item>/identifying objects, and
+        // signals when their endpoints change or they come and go
+        std::string mapperSender =
+            rules::sender("xyz.openbmc_project.ObjectMapper");
+        associationChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',interface='org.freedesktop.DBus.Properties',"
+            "member='PropertiesChanged',"
+            "arg0='xyz.openbmc_project.Association'," +
+                mapperSender,
+            [this](sdbusplus::message_t& msg) {
+            forgetAssociation(msg.get_path());
+        });
+        auto onAssociationAddedOrRemoved = [this](sdbusplus::message_t& msg) {
+            sdbusplus::message::object_path path;
+            try
+            {
+                msg.read(path);
+            }
+            catch (const sdbusplus::exception_t& e)
+            {
+                BMCWEB_LOG_ERROR << "Bad association signal: " << e.what();
+                return;
+            }
+            forgetAssociation(path.str);
+        };
+        associationAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesAdded() + mapperSender,
+            onAssociationAddedOrRemoved);
+        associationRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesRemoved() + mapperSender,
+            onAssociationAddedOrRemoved);
+    }
+
+    void forgetAssociation(std::string_view associationPath)
+    {
+        constexpr std::string_view suffix = "/identifying";
+        if (!associationPath.ends_with(suffix))
+        {
+            return;
+        }
+        associationPath.remove_suffix(suffix.size());
+        identifying.erase(std::string(associationPath));
+        associationGeneration++;
+    }
+
+    void complete(uint64_t refreshGeneration,
+                  const boost::system::error_code& ec, LedGroupStates&& found)
+    {
+        std::vector<StatesCallback> callbacks = std::move(waiters);
+        waiters.clear();
+
+        if (!ec && refreshGeneration == generation)
+        {
+            states = std::move(found);
+            for (StatesCallback& callback : callbacks)
+            {
+                callback(ec, *states);
+            }
+            return;
+        }
+        // Failed, or raced with a change; hand it to the readers that
+        // waited, but don't keep it
+        for (StatesCallback& callback : callbacks)
+        {
+            callback(ec, found);
+        }
+    }
+
+    void refreshStates()
+    {
+        crow::connections::systemBus->async_method_call(
+            [this, refreshGeneration{generation}](
+                const boost::system::error_code& ec,
+                const dbus::utility::ManagedObjectType& objects) {
+            LedGroupStates found;
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "LED group read failed " << ec;
+                complete(refreshGeneration, ec, std::move(found));
+                return;
+            }
+            for (const auto& [path, interfaces] : objects)
+            {
+                for (const auto& [interface, properties] : interfaces)
+                {
+                    if (interface != "xyz.openbmc_project.Led.Group")
+                    {
+                        continue;
+                    }
+                    for (const auto& [name, value] : properties)
+                    {
+                        const bool* asserted = std::get_if<bool>(&value);
+                        if (name == "Asserted" && asserted != nullptr)
+                        {
+                            found.emplace(path.str, *asserted);
+                        }
+                    }
+                }
+            }
+            complete(refreshGeneration, ec, std::move(found));
+        },
+            ledGroupManager, ledGroupsRoot,
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+
+    std::optional<LedGroupStates> states;
+    // Bumped on every change signal, so a refresh that raced with a change
+    // is not cached
+    uint64_t generation = 0;
+    std::vector<StatesCallback> waiters;
+
+    // Inventory item path to the LED groups that identify it
+    std::map<std::string, std::vector<std::string>> identifying;
+    // Bumped whenever an association is forgotten, for the same reason
+    uint64_t associationGeneration = 0;
+
+    std::unique_ptr<sdbusplus::bus::match_t> groupChangedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> groupAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> groupRemovedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> associationChangedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> associationAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> associationRemovedMatch;
+};
+
+} // namespace led_util
+} // namespace redfish
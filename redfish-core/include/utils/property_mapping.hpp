@@ -0,0 +1,279 @@
+#pragma once
+
+#include "async_resp.hpp"
+#include "dbus_utility.hpp"
+#include "error_messages.hpp"
+#include "logging.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace redfish
+{
+namespace property_mapping
+{
+
+enum class MapResult
+{
+    Set,
+    // The value is valid, but isn't reported
+    Skip,
+    // The value has the wrong type, which is an internal error
+    TypeError,
+};
+
+// Converts a D-Bus value into what the response holds at a mapping's JSON
+// pointer.  Function pointers, rather than std::function, so that tables of
+// mappings can be constexpr.
+using Transform = MapResult (*)(const dbus::utility::DbusVariantType& value,
+                                nlohmann::json& out);
+
+/**
+ * @brief Where one D-Bus property goes in a Redfish response.
+ */
+struct PropertyMapping
+{
+    std::string_view interface;
+    std::string_view property;
+    // JSON pointer, relative to the response, to write the property to.
+    // Empty to only fetch the property for the completion callback, for
+    // fields that are worked out from more than one property.
+    std::string_view jsonPointer;
+    Transform transform = nullptr;
+};
+
+// The properties read for a fill, by interface
+using InterfaceProperties =
+    std::map<std::string, dbus::utility::DBusPropertiesMap, std::less<>>;
+
+namespace transforms
+{
+
+template <typename T>
+MapResult copy(const dbus::utility::DbusVariantType& value,
+               nlohmann::json& out)
+{
+    const T* typed = std::get_if<T>(&value);
+    if (typed == nullptr)
+    {
+        return MapResult::TypeError;
+    }
+    out = *typed;
+    return MapResult::Set;
+}
+
+// For properties that are optional, but can't be left out on D-Bus
+inline MapResult nonEmptyString(const dbus::utility::DbusVariantType& value,
+                                nlohmann::json& out)
+{
+    const std::string* typed = std::get_if<std::string>(&value);
+    if (typed == nullptr)
+    {
+        return MapResult::TypeError;
+    }
+    if (typed->empty())
+    {
+        return MapResult::Skip;
+    }
+    out = *typed;
+    return MapResult::Set;
+}
+
+} // namespace transforms
+
+/**
+ * @brief Finds a property read by a fill, or nullptr if it wasn't read or
+ * has another type.
+ */
+template <typename T>
+const T* findProperty(const InterfaceProperties& properties,
+                      std::string_view interface, std::string_view property)
+{
+    auto iface = properties.find(interface);
+    if (iface == properties.end())
+    {
+        return nullptr;
+    }
+    for (const auto& [name, value] : iface->second)
+    {
+        if (name == property)
+        {
+            return std::get_if<T>(&value);
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief The interfaces to read for a table, each once, in the order they
+ * first appear.  If implemented isn't empty, interfaces not in it are left
+ * out, as reading them can only fail.
+ */
+inline std::vector<std::string_view>
+    planInterfaces(std::span<const PropertyMapping> table,
+                   const std::vector<std::string>& implemented)
+{
+    std::vector<std::string_view> interfaces;
+    for (const PropertyMapping& mapping : table)
+    {
+        if (std::ranges::find(interfaces, mapping.interface) !=
+            interfaces.end())
+        {
+            continue;
+        }
+        if (!implemented.empty() &&
+            std::ranges::find(implemented, mapping.interface) ==
+                implemented.end())
+        {
+            continue;
+        }
+        interfaces.emplace_back(mapping.interface);
+    }
+    return interfaces;
+}
+
+/**
+ * @brief Writes the properties of one interface to json, as the table says.
+ *
+ * @return False if a property had the wrong type.  The others are still
+ * written.
+ */
+inline bool applyMappings(std::span<const PropertyMapping> table,
+                          std::string_view interface,
+                          const dbus::utility::DBusPropertiesMap& properties,
+                          nlohmann::json& json)
+{
+    bool success = true;
+    for (const PropertyMapping& mapping : table)
+    {
+        if (mapping.interface != interface || mapping.jsonPointer.empty() ||
+            mapping.transform == nullptr)
+        {
+            continue;
+        }
+        for (const auto& [name, value] : properties)
+        {
+            if (name != mapping.property)
+            {
+                continue;
+            }
+            nlohmann::json converted;
+            MapResult result = mapping.transform(value, converted);
+            if (result == MapResult::TypeError)
+            {
+                BMCWEB_LOG_ERROR << "Unexpected type for " << interface << "."
+                                 << name;
+                success = false;
+            }
+            else if (result == MapResult::Set)
+            {
+                json[nlohmann::json::json_pointer(
+                    std::string(mapping.jsonPointer))] = std::move(converted);
+            }
+            break;
+        }
+    }
+    return success;
+}
+
+using CompletionCallback = std::function<void(const InterfaceProperties&)>;
+
+namespace details
+{
+
+// Gathers the replies of one fill, and runs the completion callback once
+// all of them are in, when the last reference goes away
+struct Fill
+{
+    Fill(const std::shared_ptr<bmcweb::AsyncResp>& asyncRespIn,
+         std::span<const PropertyMapping> tableIn,
+         CompletionCallback&& doneIn) :
+        asyncResp(asyncRespIn),
+        table(tableIn), done(std::move(doneIn))
+    {}
+
+    Fill(const Fill&) = delete;
+    Fill(Fill&&) = delete;
+    Fill& operator=(const Fill&) = delete;
+    Fill& operator=(Fill&&) = delete;
+
+    ~Fill()
+    {
+        if (done)
+        {
+            done(properties);
+        }
+    }
+
+    std::shared_ptr<bmcweb::AsyncResp> asyncResp;
+    std::span<const PropertyMapping> table;
+    CompletionCallback done;
+    InterfaceProperties properties;
+};
+
+} // namespace details
+
+/**
+ * @brief Fills asyncResp from the properties of one D-Bus object, as
+ * declared by table.
+ *
+ * Reads each interface the table names with one GetAll, all of them at
+ * once, instead of one call per property, and writes every mapped property
+ * as its reply comes in.  done, if given, runs once all of the replies are
+ * in, with every property read, for fields that depend on more than one.
+ * Interfaces the object doesn't have are skipped, as for hand written
+ * handlers; other errors are internal errors.
+ *
+ * @param[in] table        The mappings; kept by reference until the fill
+ *                         completes, so normally a constexpr table.
+ * @param[in] implemented  The object's interfaces, as the mapper gave them,
+ *                         to avoid reading the ones it doesn't have.  May be
+ *                         empty, to read all of them.
+ */
+inline void fillProperties(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           const std::string& service, const std::string& path,
+                           std::span<const PropertyMapping> table,
+                           const std::vector<std::string>& implemented = {},
+                           CompletionCallback&& done = nullptr)
+{
+    auto fill =
+        std::make_shared<details::Fill>(asyncResp, table, std::move(done));
+    for (std::string_view interface : planInterfaces(table, implemented))
+    {
+        dbus::utility::getAllProperties(
+            service, path, std::string(interface),
+            [fill, interface{std::string(interface)}](
+                const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
+            if (ec)
+            {
+                if (ec.value() != EBADR)
+                {
+                    BMCWEB_LOG_ERROR << "DBUS response error " << ec;
+                    messages::internalError(fill->asyncResp->res);
+                }
+                return;
+            }
+            if (!applyMappings(fill->table, interface, properties,
+                               fill->asyncResp->res.jsonValue))
+            {
+                messages::internalError(fill->asyncResp->res);
+            }
+            fill->properties.insert_or_assign(interface, properties);
+        });
+    }
+}
+
+} // namespace property_mapping
+} // namespace redfish
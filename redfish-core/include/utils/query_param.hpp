@@ -7,6 +7,7 @@
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
+#include "tracing.hpp"
 
 #include <sys/types.h>
 
@@ -513,6 +514,8 @@ inline bool processOnly(crow::App& app, crow::Response& res,
     BMCWEB_LOG_DEBUG << "setting completion handler on " << &asyncResp->res;
     asyncResp->res.setCompleteRequestHandler(std::move(completionHandler));
     asyncResp->res.setIsAliveHelper(res.releaseIsAliveHelper());
+    asyncResp->res.setCancellationToken(res.getCancellationToken());
+    asyncResp->res.setTraceContext(res.getTraceContext());
     app.handle(newReq, asyncResp);
     return true;
 }
@@ -776,10 +779,12 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
 
     void addAwaitingResponse(
         const std::shared_ptr<bmcweb::AsyncResp>& res,
-        const nlohmann::json::json_pointer& finalExpandLocation)
+        const nlohmann::json::json_pointer& finalExpandLocation,
+        const std::shared_ptr<crow::Span>& span = nullptr)
     {
-        res->res.setCompleteRequestHandler(std::bind_front(
-            placeResultStatic, shared_from_this(), finalExpandLocation));
+        res->res.setCompleteRequestHandler(
+            std::bind_front(placeResultStatic, shared_from_this(),
+                            finalExpandLocation, span));
     }
 
     void placeResult(const nlohmann::json::json_pointer& locationToPlace,
@@ -810,6 +815,12 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
         }
         for (const ExpandNode& node : nodes)
         {
+            if (finalRes->res.isCancelled())
+            {
+                BMCWEB_LOG_DEBUG << "Request is cancelled, stopping expand";
+                finalRes->res.getCancellationToken()->markWorkSkipped();
+                return;
+            }
             const std::string subQuery = node.uri + *queryStr;
             BMCWEB_LOG_DEBUG << "URL of subquery:  " << subQuery;
             std::error_code ec;
@@ -825,7 +836,16 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
             BMCWEB_LOG_DEBUG << "setting completion handler on "
                              << &asyncResp->res;
 
-            addAwaitingResponse(asyncResp, node.location);
+            asyncResp->res.setCancellationToken(
+                finalRes->res.getCancellationToken());
+            std::shared_ptr<crow::Span> span = crow::Span::startShared(
+                "expand", finalRes->res.getTraceContext());
+            if (span)
+            {
+                span->setAttribute("http.target", subQuery);
+                asyncResp->res.setTraceContext(span->context());
+            }
+            addAwaitingResponse(asyncResp, node.location, span);
             app.handle(newReq, asyncResp);
         }
     }
@@ -834,8 +854,15 @@ class MultiAsyncResp : public std::enable_shared_from_this<MultiAsyncResp>
     static void
         placeResultStatic(const std::shared_ptr<MultiAsyncResp>& multi,
                           const nlohmann::json::json_pointer& locationToPlace,
+                          const std::shared_ptr<crow::Span>& span,
                           crow::Response& res)
     {
+        if (span)
+        {
+            span->setAttribute("http.status_code",
+                               std::to_string(res.resultInt()));
+            span->end();
+        }
         multi->placeResult(locationToPlace, res);
     }
 
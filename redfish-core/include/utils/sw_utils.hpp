@@ -5,6 +5,7 @@
 #include <sdbusplus/asio/property.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 #include <utils/dbus_utils.hpp>
+#include <utils/firmware_inventory_cache.hpp>
 
 #include <algorithm>
 #include <string>
@@ -41,12 +42,10 @@ inline void
                                 const std::string& activeVersionPropName,
                                 const bool populateLinkToImages)
 {
-    // Used later to determine running (known on Redfish as active) Sw images
-    dbus::utility::getAssociationEndPoints(
-        "/xyz/openbmc_project/software/functional",
-        [aResp, swVersionPurpose, activeVersionPropName, populateLinkToImages](
-            const boost::system::error_code& ec,
-            const dbus::utility::MapperEndPoints& functionalSw) {
+    FirmwareInventoryCache::getInstance().getImages(
+        [aResp, swVersionPurpose, activeVersionPropName,
+         populateLinkToImages](const boost::system::error_code& ec,
+                               const SoftwareImages& images) {
         BMCWEB_LOG_DEBUG << "populateSoftwareInformation enter";
         if (ec)
         {
@@ -56,7 +55,7 @@ inline void
             return;
         }
 
-        if (functionalSw.empty())
+        if (std::ranges::none_of(images, &SoftwareImage::functional))
         {
             // Could keep going and try to populate SoftwareImages but
             // something is seriously wrong, so just fail
@@ -65,161 +64,55 @@ inline void
             return;
         }
 
-        std::vector<std::string> functionalSwIds;
-        // example functionalSw:
-        // v as 2 "/xyz/openbmc_project/software/ace821ef"
-        //        "/xyz/openbmc_project/software/230fb078"
-        for (const auto& sw : functionalSw)
-        {
-            sdbusplus::message::object_path path(sw);
-            std::string leaf = path.filename();
-            if (leaf.empty())
-            {
-                continue;
-            }
+        BMCWEB_LOG_DEBUG << "Found " << images.size() << " images";
 
-            functionalSwIds.push_back(leaf);
-        }
-
-        crow::connections::systemBus->async_method_call(
-            [aResp, swVersionPurpose, activeVersionPropName,
-             populateLinkToImages, functionalSwIds](
-                const boost::system::error_code ec2,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
-            if (ec2)
+        for (const SoftwareImage& image : images)
+        {
+            if (image.version.empty())
             {
-                BMCWEB_LOG_ERROR << "error_code = " << ec2;
-                BMCWEB_LOG_ERROR << "error msg = " << ec2.message();
                 messages::internalError(aResp->res);
                 return;
             }
-
-            BMCWEB_LOG_DEBUG << "Found " << subtree.size() << " images";
-
-            for (const std::pair<std::string,
-                                 std::vector<std::pair<
-                                     std::string, std::vector<std::string>>>>&
-                     obj : subtree)
+            if (image.purpose != swVersionPurpose)
             {
-                sdbusplus::message::object_path path(obj.first);
-                std::string swId = path.filename();
-                if (swId.empty())
-                {
-                    messages::internalError(aResp->res);
-                    BMCWEB_LOG_ERROR << "Invalid software ID";
+                // Not purpose we're looking for
+                continue;
+            }
 
-                    return;
-                }
+            BMCWEB_LOG_DEBUG << "Image ID: " << image.id;
+            BMCWEB_LOG_DEBUG << "Running image: " << image.functional;
+            BMCWEB_LOG_DEBUG << "Image purpose: " << image.purpose;
 
-                bool runningImage = false;
-                // Look at Ids from
-                // /xyz/openbmc_project/software/functional
-                // to determine if this is a running image
-                if (std::find(functionalSwIds.begin(), functionalSwIds.end(),
-                              swId) != functionalSwIds.end())
+            if (populateLinkToImages)
+            {
+                nlohmann::json& softwareImageMembers =
+                    aResp->res.jsonValue["Links"]["SoftwareImages"];
+                // Firmware images are at
+                // /redfish/v1/UpdateService/FirmwareInventory/<Id>
+                // e.g. .../FirmwareInventory/82d3ec86
+                nlohmann::json::object_t member;
+                member["@odata.id"] =
+                    "/redfish/v1/UpdateService/FirmwareInventory/" + image.id;
+                softwareImageMembers.push_back(std::move(member));
+                aResp->res.jsonValue["Links"]["SoftwareImages@odata.count"] =
+                    softwareImageMembers.size();
+
+                if (image.functional)
                 {
-                    runningImage = true;
+                    nlohmann::json::object_t runningMember;
+                    runningMember["@odata.id"] =
+                        "/redfish/v1/UpdateService/FirmwareInventory/" +
+                        image.id;
+                    // Create the link to the running image
+                    aResp->res.jsonValue["Links"]["ActiveSoftwareImage"] =
+                        std::move(runningMember);
                 }
-
-                // Now grab its version info
-                sdbusplus::asio::getAllProperties(
-                    *crow::connections::systemBus, obj.second[0].first,
-                    obj.first, "xyz.openbmc_project.Software.Version",
-                    [aResp, swId, runningImage, swVersionPurpose,
-                     activeVersionPropName, populateLinkToImages](
-                        const boost::system::error_code ec3,
-                        const dbus::utility::DBusPropertiesMap&
-                            propertiesList) {
-                    if (ec3)
-                    {
-                        BMCWEB_LOG_ERROR << "error_code = " << ec3;
-                        BMCWEB_LOG_ERROR << "error msg = " << ec3.message();
-                        // Have seen the code update app delete the D-Bus
-                        // object, during code update, between the call to
-                        // mapper and here. Just leave these properties off if
-                        // resource not found.
-                        if (ec3.value() == EBADR)
-                        {
-                            return;
-                        }
-                        messages::internalError(aResp->res);
-                        return;
-                    }
-                    // example propertiesList
-                    // a{sv} 2 "Version" s
-                    // "IBM-witherspoon-OP9-v2.0.10-2.22" "Purpose"
-                    // s
-                    // "xyz.openbmc_project.Software.Version.VersionPurpose.Host"
-                    const std::string* version = nullptr;
-                    const std::string* swInvPurpose = nullptr;
-
-                    const bool success = sdbusplus::unpackPropertiesNoThrow(
-                        dbus_utils::UnpackErrorPrinter(), propertiesList,
-                        "Purpose", swInvPurpose, "Version", version);
-
-                    if (!success)
-                    {
-                        messages::internalError(aResp->res);
-                        return;
-                    }
-
-                    if (version == nullptr || version->empty())
-                    {
-                        messages::internalError(aResp->res);
-                        return;
-                    }
-                    if (swInvPurpose == nullptr ||
-                        *swInvPurpose != swVersionPurpose)
-                    {
-                        // Not purpose we're looking for
-                        return;
-                    }
-
-                    BMCWEB_LOG_DEBUG << "Image ID: " << swId;
-                    BMCWEB_LOG_DEBUG << "Running image: " << runningImage;
-                    BMCWEB_LOG_DEBUG << "Image purpose: " << *swInvPurpose;
-
-                    if (populateLinkToImages)
-                    {
-                        nlohmann::json& softwareImageMembers =
-                            aResp->res.jsonValue["Links"]["SoftwareImages"];
-                        // Firmware images are at
-                        // /redfish/v1/UpdateService/FirmwareInventory/<Id>
-                        // e.g. .../FirmwareInventory/82d3ec86
-                        nlohmann::json::object_t member;
-                        member["@odata.id"] = "/redfish/v1/UpdateService/"
-                                              "FirmwareInventory/" +
-                                              swId;
-                        softwareImageMembers.push_back(std::move(member));
-                        aResp->res
-                            .jsonValue["Links"]["SoftwareImages@odata.count"] =
-                            softwareImageMembers.size();
-
-                        if (runningImage)
-                        {
-                            nlohmann::json::object_t runningMember;
-                            runningMember["@odata.id"] =
-                                "/redfish/v1/UpdateService/"
-                                "FirmwareInventory/" +
-                                swId;
-                            // Create the link to the running image
-                            aResp->res
-                                .jsonValue["Links"]["ActiveSoftwareImage"] =
-                                std::move(runningMember);
-                        }
-                    }
-                    if (!activeVersionPropName.empty() && runningImage)
-                    {
-                        aResp->res.jsonValue[activeVersionPropName] = *version;
-                    }
-                });
             }
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/software", static_cast<int32_t>(0),
-            std::array<const char*, 1>{"xyz.openbmc_project.Software.Version"});
+            if (!activeVersionPropName.empty() && image.functional)
+            {
+                aResp->res.jsonValue[activeVersionPropName] = image.version;
+            }
+        }
     });
 }
 
@@ -277,100 +170,32 @@ inline std::string getRedfishSwHealth(const std::string& swState)
 }
 
 /**
- * @brief Put status of input swId into json response
+ * @brief Put status of a software image into json response
  *
- * This function will put the appropriate Redfish state of the input
- * software id to ["Status"]["State"] within the json response
+ * This function will put the appropriate Redfish state of the image to
+ * ["Status"]["State"] and ["Status"]["Health"] within the json response
  *
- * @param[i,o] aResp    Async response object
- * @param[i]   swId     The software ID to get status for
- * @param[i]   dbusSvc  The dbus service implementing the software object
+ * @param[i,o] asyncResp  Async response object
+ * @param[i]   image      The software image to report the status of
  *
  * @return void
  */
 inline void getSwStatus(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::shared_ptr<std::string>& swId,
-                        const std::string& dbusSvc)
-{
-    BMCWEB_LOG_DEBUG << "getSwStatus: swId " << *swId << " svc " << dbusSvc;
-
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, dbusSvc,
-        "/xyz/openbmc_project/software/" + *swId,
-        "xyz.openbmc_project.Software.Activation",
-        [asyncResp,
-         swId](const boost::system::error_code errorCode,
-               const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (errorCode)
-        {
-            // not all swtypes are updateable, this is ok
-            asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
-            return;
-        }
-
-        const std::string* swInvActivation = nullptr;
-
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "Activation",
-            swInvActivation);
-
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (swInvActivation == nullptr)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        BMCWEB_LOG_DEBUG << "getSwStatus: Activation " << *swInvActivation;
-        asyncResp->res.jsonValue["Status"]["State"] =
-            getRedfishSwState(*swInvActivation);
-        asyncResp->res.jsonValue["Status"]["Health"] =
-            getRedfishSwHealth(*swInvActivation);
-    });
-}
-
-/**
- * @brief Updates programmable status of input swId into json response
- *
- * This function checks whether software inventory component
- * can be programmable or not and fill's the "Updatable"
- * Property.
- *
- * @param[i,o] asyncResp  Async response object
- * @param[i]   swId       The software ID
- */
-inline void
-    getSwUpdatableStatus(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                         const std::shared_ptr<std::string>& swId)
+                        const SoftwareImage& image)
 {
-    sdbusplus::asio::getProperty<std::vector<std::string>>(
-        *crow::connections::systemBus, "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/software/updateable",
-        "xyz.openbmc_project.Association", "endpoints",
-        [asyncResp, swId](const boost::system::error_code ec,
-                          const std::vector<std::string>& objPaths) {
-        if (ec)
-        {
-            BMCWEB_LOG_DEBUG << " error_code = " << ec
-                             << " error msg =  " << ec.message();
-            // System can exist with no updateable software,
-            // so don't throw error here.
-            return;
-        }
-        std::string reqSwObjPath = "/xyz/openbmc_project/software/" + *swId;
+    BMCWEB_LOG_DEBUG << "getSwStatus: swId " << image.id;
+    if (!image.activation)
+    {
+        // not all swtypes are updateable, this is ok
+        asyncResp->res.jsonValue["Status"]["State"] = "Enabled";
+        return;
+    }
 
-        if (std::find(objPaths.begin(), objPaths.end(), reqSwObjPath) !=
-            objPaths.end())
-        {
-            asyncResp->res.jsonValue["Updateable"] = true;
-            return;
-        }
-    });
+    BMCWEB_LOG_DEBUG << "getSwStatus: Activation " << *image.activation;
+    asyncResp->res.jsonValue["Status"]["State"] =
+        getRedfishSwState(*image.activation);
+    asyncResp->res.jsonValue["Status"]["Health"] =
+        getRedfishSwHealth(*image.activation);
 }
 
 } // namespace sw_util
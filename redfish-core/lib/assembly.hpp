@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dbus_utility.hpp"
 #include "led.hpp"
 
 #include <sdbusplus/unpack_properties.hpp>
@@ -169,8 +170,8 @@ inline void
                     if (interface ==
                         "xyz.openbmc_project.Inventory.Decorator.Asset")
                     {
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, serviceName,
+                        dbus::utility::getAllProperties(
+                            serviceName,
                             assembly, interface,
                             [aResp, assemblyIndex,
                              assembly](const boost::system::error_code ec2,
@@ -140,7 +140,13 @@ inline void handleChassisCollectionGet(
     App& app, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::QueryCapabilities capabilities = {
+        .canDelegateTop = true,
+        .canDelegateSkip = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -152,7 +158,8 @@ inline void handleChassisCollectionGet(
     constexpr std::array<std::string_view, 1> interfaces{
         "xyz.openbmc_project.Inventory.Item.Chassis"};
     collection_util::getCollectionMembers(
-        asyncResp, boost::urls::url("/redfish/v1/Chassis"), interfaces);
+        asyncResp, boost::urls::url("/redfish/v1/Chassis"), interfaces,
+        "/xyz/openbmc_project/inventory", delegatedQuery);
 }
 
 /**
@@ -411,8 +418,8 @@ inline void
                 });
             }
 
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, connectionName, path,
+            dbus::utility::getAllProperties(
+                connectionName, path,
                 "xyz.openbmc_project.Inventory.Decorator.Asset",
                 [asyncResp, chassisId(std::string(chassisId))](
                     const boost::system::error_code /*ec2*/,
@@ -15,6 +15,9 @@
 */
 #pragma once
 #include "event_service_manager.hpp"
+#ifdef BMCWEB_ENABLE_EVENT_LOAD_GENERATOR
+#include "event_load_generator.hpp"
+#endif
 #include "snmp_trap_event_clients.hpp"
 
 #include <app.hpp>
@@ -186,6 +189,143 @@ inline void requestRoutesSubmitTestEvent(App& app)
     });
 }
 
+// Counters of event delivery, and the health of each destination, for
+// bmcweb developers.  Not a Redfish resource, so there is no schema.
+inline void handleEventDeliveryGet(
+    const crow::Request& /*req*/,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    const crow::HttpClient& client = getSubscriptionClient();
+    const crow::DeliveryStats& stats = client.getStats();
+
+    nlohmann::json& json = asyncResp->res.jsonValue;
+    json["Delivered"] = stats.delivered;
+    json["Failed"] = stats.failed;
+    json["Dropped"] = stats.dropped;
+    json["Retries"] = stats.retries;
+    json["Queued"] = stats.queued;
+
+    nlohmann::json::array_t destinations;
+    for (const crow::DestinationStatus& status : client.getDestinations())
+    {
+        nlohmann::json::object_t item;
+        item["Destination"] = status.destination;
+        item["HealthScore"] = status.health.score;
+        item["FailureStreak"] = status.health.failureStreak;
+        item["HoldingOff"] = status.holdingOff;
+        item["Queued"] = status.queued;
+        item["Delivered"] = status.health.delivered;
+        item["Failed"] = status.health.failed;
+        item["Retries"] = status.health.retries;
+        destinations.emplace_back(std::move(item));
+    }
+    json["Destinations"] = std::move(destinations);
+}
+
+inline void requestRoutesEventDeliveryStats(App& app)
+{
+    BMCWEB_ROUTE(app, "/debug/v1/events/delivery")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(handleEventDeliveryGet);
+}
+
+#ifdef BMCWEB_ENABLE_EVENT_LOAD_GENERATOR
+inline void handleEventLoadPost(
+    const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    EventLoadGenerator& generator = EventLoadGenerator::getInstance();
+    if (generator.isRunning())
+    {
+        messages::resourceInUse(asyncResp->res);
+        return;
+    }
+    uint64_t eventsPerSecond = 0;
+    uint64_t count = 0;
+    std::optional<uint64_t> payloadBytes;
+    std::optional<std::string> path;
+    if (!json_util::readJsonPatch(req, asyncResp->res, "EventsPerSecond",
+                                  eventsPerSecond, "Count", count,
+                                  "PayloadBytes", payloadBytes, "Path", path))
+    {
+        return;
+    }
+    if (eventsPerSecond == 0 ||
+        eventsPerSecond > EventLoadGenerator::maxEventsPerSecond)
+    {
+        messages::propertyValueOutOfRange(
+            asyncResp->res, std::to_string(eventsPerSecond), "EventsPerSecond");
+        return;
+    }
+    if (count == 0 || count > EventLoadGenerator::maxCount)
+    {
+        messages::propertyValueOutOfRange(asyncResp->res,
+                                          std::to_string(count), "Count");
+        return;
+    }
+    EventLoadGenerator::Params params;
+    params.eventsPerSecond = eventsPerSecond;
+    params.count = count;
+    if (payloadBytes)
+    {
+        if (*payloadBytes > EventLoadGenerator::maxPayloadBytes)
+        {
+            messages::propertyValueOutOfRange(
+                asyncResp->res, std::to_string(*payloadBytes), "PayloadBytes");
+            return;
+        }
+        params.payloadBytes = static_cast<size_t>(*payloadBytes);
+    }
+    if (path)
+    {
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+        constexpr bool haveEventLog = true;
+#else
+        constexpr bool haveEventLog = false;
+#endif
+        if (*path == "EventLog" && haveEventLog)
+        {
+            params.viaEventLog = true;
+        }
+        else if (*path != "SendEvent")
+        {
+            messages::propertyValueNotInList(asyncResp->res, *path, "Path");
+            return;
+        }
+    }
+    generator.start(params);
+    asyncResp->res.jsonValue = generator.getStatus();
+}
+
+// Load testing of event delivery, for bmcweb developers; see
+// scripts/event_load_benchmark.py
+inline void requestRoutesEventLoadGenerator(App& app)
+{
+    BMCWEB_ROUTE(app, "/debug/v1/events/load")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(
+            [](const crow::Request& /*req*/,
+               const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+        asyncResp->res.jsonValue =
+            EventLoadGenerator::getInstance().getStatus();
+    });
+
+    BMCWEB_ROUTE(app, "/debug/v1/events/load")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::post)(handleEventLoadPost);
+
+    BMCWEB_ROUTE(app, "/debug/v1/events/load")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::delete_)(
+            [](const crow::Request& /*req*/,
+               const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
+        EventLoadGenerator::getInstance().stop();
+        asyncResp->res.jsonValue =
+            EventLoadGenerator::getInstance().getStatus();
+    });
+}
+#endif
+
 inline void doSubscriptionCollection(
     const boost::system::error_code ec,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -69,8 +69,8 @@ inline void
                           const std::string& serviceName,
                           const std::string& fabricAdapterPath)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, serviceName, fabricAdapterPath,
+    dbus::utility::getAllProperties(
+        serviceName, fabricAdapterPath,
         "xyz.openbmc_project.Inventory.Decorator.Asset",
         [fabricAdapterPath,
          aResp{aResp}](const boost::system::error_code ec,
@@ -434,7 +434,13 @@ inline void handleFabricAdapterCollectionGet(
     const std::shared_ptr<bmcweb::AsyncResp>& aResp,
     const std::string& systemName)
 {
-    if (!redfish::setUpRedfishRoute(app, req, aResp))
+    query_param::QueryCapabilities capabilities = {
+        .canDelegateTop = true,
+        .canDelegateSkip = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, aResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -471,7 +477,8 @@ inline void handleFabricAdapterCollectionGet(
         "xyz.openbmc_project.Inventory.Item.FabricAdapter"};
     collection_util::getCollectionMembersWithPathConversion(
         aResp, boost::urls::url("/redfish/v1/Systems/system/FabricAdapters"),
-        interfaces, std::move(getMembersFromPaths));
+        interfaces, std::move(getMembersFromPaths),
+        "/xyz/openbmc_project/inventory", delegatedQuery);
 }
 
 inline void handleFabricAdapterCollectionHead(
@@ -5,12 +5,15 @@
 #include "error_messages.hpp"
 #include "led.hpp"
 #include "utils/chassis_utils.hpp"
+#include "utils/property_mapping.hpp"
 
 #include <utils/json_utils.hpp>
 
+#include <array>
 #include <memory>
 #include <optional>
 #include <string>
+#include <variant>
 
 namespace redfish
 {
@@ -172,134 +175,59 @@ inline void
     });
 }
 
-inline void getFanHealth(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                         const std::string& service, const std::string& path)
+inline property_mapping::MapResult
+    fanHealth(const dbus::utility::DbusVariantType& functional,
+              nlohmann::json& out)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
-        [asyncResp](const boost::system::error_code& ec, bool value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        if (!value)
-        {
-            asyncResp->res.jsonValue["Status"]["Health"] = "Critical";
-        }
-    });
-}
-
-inline void getFanState(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Item", "Present",
-        [asyncResp](const boost::system::error_code& ec, bool value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        if (!value)
-        {
-            asyncResp->res.jsonValue["Status"]["State"] = "Absent";
-        }
-    });
+    const bool* value = std::get_if<bool>(&functional);
+    if (value == nullptr)
+    {
+        return property_mapping::MapResult::TypeError;
+    }
+    if (*value)
+    {
+        return property_mapping::MapResult::Skip;
+    }
+    out = "Critical";
+    return property_mapping::MapResult::Set;
 }
 
-inline void getFanAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::string& service, const std::string& path)
+inline property_mapping::MapResult
+    fanState(const dbus::utility::DbusVariantType& present,
+             nlohmann::json& out)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Decorator.Asset",
-        [asyncResp](const boost::system::error_code& ec,
-                    const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        const std::string* partNumber = nullptr;
-        const std::string* serialNumber = nullptr;
-        const std::string* manufacturer = nullptr;
-        const std::string* model = nullptr;
-        const std::string* sparePartNumber = nullptr;
-
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "PartNumber",
-            partNumber, "SerialNumber", serialNumber, "Manufacturer",
-            manufacturer, "Model", model, "SparePartNumber", sparePartNumber);
-
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (partNumber != nullptr)
-        {
-            asyncResp->res.jsonValue["PartNumber"] = *partNumber;
-        }
-
-        if (serialNumber != nullptr)
-        {
-            asyncResp->res.jsonValue["SerialNumber"] = *serialNumber;
-        }
-
-        if (manufacturer != nullptr)
-        {
-            asyncResp->res.jsonValue["Manufacturer"] = *manufacturer;
-        }
-
-        if (model != nullptr)
-        {
-            asyncResp->res.jsonValue["Model"] = *model;
-        }
-
-        if (sparePartNumber != nullptr)
-        {
-            asyncResp->res.jsonValue["SparePartNumber"] = *sparePartNumber;
-        }
-    });
+    const bool* value = std::get_if<bool>(&present);
+    if (value == nullptr)
+    {
+        return property_mapping::MapResult::TypeError;
+    }
+    if (*value)
+    {
+        return property_mapping::MapResult::Skip;
+    }
+    out = "Absent";
+    return property_mapping::MapResult::Set;
 }
 
-inline void getFanLocation(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
-        [asyncResp](const boost::system::error_code& ec,
-                    const std::string& value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        asyncResp->res.jsonValue["Location"]["PartLocation"]["ServiceLabel"] =
-            value;
-    });
-}
+constexpr std::array<property_mapping::PropertyMapping, 8> fanProperties = {{
+    {"xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
+     "/Status/Health", fanHealth},
+    {"xyz.openbmc_project.Inventory.Item", "Present", "/Status/State",
+     fanState},
+    {"xyz.openbmc_project.Inventory.Decorator.Asset", "PartNumber",
+     "/PartNumber", property_mapping::transforms::copy<std::string>},
+    {"xyz.openbmc_project.Inventory.Decorator.Asset", "SerialNumber",
+     "/SerialNumber", property_mapping::transforms::copy<std::string>},
+    {"xyz.openbmc_project.Inventory.Decorator.Asset", "Manufacturer",
+     "/Manufacturer", property_mapping::transforms::copy<std::string>},
+    {"xyz.openbmc_project.Inventory.Decorator.Asset", "Model", "/Model",
+     property_mapping::transforms::copy<std::string>},
+    {"xyz.openbmc_project.Inventory.Decorator.Asset", "SparePartNumber",
+     "/SparePartNumber", property_mapping::transforms::copy<std::string>},
+    {"xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
+     "/Location/PartLocation/ServiceLabel",
+     property_mapping::transforms::copy<std::string>},
+}};
 
 inline void doFanGet(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                      const std::string& chassisId, const std::string& fanId,
@@ -339,10 +267,9 @@ inline void doFanGet(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                 return;
             }
 
-            getFanHealth(asyncResp, object.begin()->first, fanPath);
-            getFanState(asyncResp, object.begin()->first, fanPath);
-            getFanAsset(asyncResp, object.begin()->first, fanPath);
-            getFanLocation(asyncResp, object.begin()->first, fanPath);
+            property_mapping::fillProperties(asyncResp, object.begin()->first,
+                                             fanPath, fanProperties,
+                                             object.begin()->second);
         });
 
         getLocationIndicatorActive(asyncResp, fanPath);
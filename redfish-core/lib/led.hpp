@@ -21,6 +21,7 @@
 
 #include <app.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <utils/led_state_cache.hpp>
 
 #include <array>
 
@@ -145,6 +146,7 @@ inline void
                 messages::internalError(aResp->res);
                 return;
             }
+            led_util::LedStateCache::getInstance().invalidateStates();
             messages::success(aResp->res);
         },
             "xyz.openbmc_project.LED.GroupManager",
@@ -224,6 +226,7 @@ inline void setLedAsset(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
                 }
                 return;
             }
+            led_util::LedStateCache::getInstance().invalidateStates();
         });
     });
 }
@@ -231,6 +234,11 @@ inline void setLedAsset(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 /**
  * @brief Retrieves identify led group properties over dbus
  *
+ * The identifying association and the group states come from the
+ * LedStateCache, so that the members of an expanded collection share one
+ * read of the group manager.  Groups the group manager doesn't host are
+ * read individually.
+ *
  * @param[in] aResp     Shared pointer for generating response message.
  * @param[in] objPath   Object path on PIM
  *
@@ -242,25 +250,36 @@ inline void getLocationIndicatorActive(
 {
     BMCWEB_LOG_DEBUG << "Get LocationIndicatorActive";
 
-    dbus::utility::getAssociationEndPoints(
-        objPath + "/identifying",
-        [aResp, callback{std::move(callback)}](
-            const boost::system::error_code& ec,
-            const dbus::utility::MapperEndPoints& endpoints) {
+    led_util::LedStateCache::getInstance().getIdentifyingLeds(
+        objPath, [aResp, callback{std::move(callback)}](
+                     const boost::system::error_code& ec,
+                     const std::vector<std::string>& endpoints) {
         if (ec)
         {
-            if (ec.value() != EBADR)
-            {
-                BMCWEB_LOG_ERROR << "DBUS response error " << ec.value();
-                messages::internalError(aResp->res);
-            }
+            BMCWEB_LOG_ERROR << "DBUS response error " << ec.value();
+            messages::internalError(aResp->res);
             return;
         }
-
-        for (const auto& endpoint : endpoints)
+        if (endpoints.empty())
         {
-            getLedAsset(aResp, endpoint, callback);
+            return;
         }
+
+        led_util::LedStateCache::getInstance().getGroupStates(
+            [aResp, callback, endpoints](
+                const boost::system::error_code& ec2,
+                const led_util::LedGroupStates& states) {
+            for (const auto& endpoint : endpoints)
+            {
+                auto state = states.find(endpoint);
+                if (ec2 || state == states.end())
+                {
+                    getLedAsset(aResp, endpoint, callback);
+                    continue;
+                }
+                callback(state->second);
+            }
+        });
     });
 }
 
@@ -288,18 +307,21 @@ inline void
 {
     BMCWEB_LOG_DEBUG << "Set LocationIndicatorActive";
 
-    dbus::utility::getAssociationEndPoints(
-        objPath + "/identifying",
-        [aResp, ledState,
-         objPath](const boost::system::error_code& ec,
-                  const dbus::utility::MapperEndPoints& endpoints) {
+    led_util::LedStateCache::getInstance().getIdentifyingLeds(
+        objPath, [aResp, ledState,
+                  objPath](const boost::system::error_code& ec,
+                           const std::vector<std::string>& endpoints) {
         if (ec)
         {
-            if (ec.value() != EBADR)
-            {
-                BMCWEB_LOG_ERROR << "DBUS response error " << ec.value();
-                messages::internalError(aResp->res);
-            }
+            BMCWEB_LOG_ERROR << "DBUS response error " << ec.value();
+            messages::internalError(aResp->res);
+            messages::resourceNotFound(aResp->res, "LedGroup", objPath);
+            return;
+        }
+        // The mapper drops associations without endpoints, so this is an
+        // item without an identifying LED
+        if (endpoints.empty())
+        {
             messages::resourceNotFound(aResp->res, "LedGroup", objPath);
             return;
         }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "assembly.hpp"
+#include "async_file.hpp"
 #include "gzfile.hpp"
 #include "http_utility.hpp"
 #include "human_sort.hpp"
@@ -50,6 +51,7 @@
 
 #include <charconv>
 #include <filesystem>
+#include <limits>
 #include <optional>
 #include <span>
 #include <string_view>
@@ -1776,6 +1778,7 @@ inline void requestRoutesJournalEventLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/")
         .privileges(redfish::privileges::getLogEntryCollection)
+        .expensive()
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -2051,6 +2054,7 @@ inline void requestRoutesDBusEventLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/")
         .privileges(redfish::privileges::getLogEntryCollection)
+        .expensive()
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -2588,8 +2592,8 @@ inline void requestRoutesDBusEventLogEntry(App& app)
 
         // DBus implementation of EventLog/Entries
         // Make call to Logging Service to find all log entry objects
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, "xyz.openbmc_project.Logging",
+        dbus::utility::getAllProperties(
+            "xyz.openbmc_project.Logging",
             "/xyz/openbmc_project/logging/entry/" + entryID, "",
             [asyncResp, entryID](const boost::system::error_code ec,
                                  const dbus::utility::DBusPropertiesMap& resp) {
@@ -2825,8 +2829,8 @@ inline void requestRoutesDBusCELogEntry(App& app)
 
         // DBus implementation of CELog/Entries
         // Make call to Logging Service to find all log entry objects
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, "xyz.openbmc_project.Logging",
+        dbus::utility::getAllProperties(
+            "xyz.openbmc_project.Logging",
             "/xyz/openbmc_project/logging/entry/" + entryID, "",
             [asyncResp, entryID](const boost::system::error_code ec,
                                  const dbus::utility::DBusPropertiesMap& resp) {
@@ -3764,6 +3768,7 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Managers/bmc/LogServices/Journal/Entries/")
         .privileges(redfish::privileges::getLogEntryCollection)
+        .expensive()
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
@@ -4537,8 +4542,8 @@ static void
             logEntryJson.update(logEntry);
         }
     };
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, crashdumpObject,
+    dbus::utility::getAllProperties(
+        crashdumpObject,
         crashdumpPath + std::string("/") + logID, crashdumpInterface,
         std::move(getStoredLogCallback));
 }
@@ -4704,17 +4709,28 @@ inline void requestRoutesCrashdumpFile(App& app)
                 messages::resourceNotFound(asyncResp->res, "LogEntry", logID);
                 return;
             }
-            std::ifstream ifs(dbusFilepath, std::ios::in | std::ios::binary);
-            asyncResp->res.body() =
-                std::string(std::istreambuf_iterator<char>{ifs}, {});
+            bmcweb::asyncReadFile(
+                crow::connections::systemBus->get_io_context(), dbusFilepath,
+                std::numeric_limits<uint64_t>::max(),
+                [asyncResp](const boost::system::error_code& ec2,
+                            std::string&& data) {
+                if (ec2)
+                {
+                    BMCWEB_LOG_ERROR << "Failed to read crashdump: " << ec2;
+                    messages::internalError(asyncResp->res);
+                    return;
+                }
+                asyncResp->res.body() = std::move(data);
 
-            // Configure this to be a file download when accessed
-            // from a browser
-            asyncResp->res.addHeader(
-                boost::beast::http::field::content_disposition, "attachment");
+                // Configure this to be a file download when accessed
+                // from a browser
+                asyncResp->res.addHeader(
+                    boost::beast::http::field::content_disposition,
+                    "attachment");
+            });
         };
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, crashdumpObject,
+        dbus::utility::getAllProperties(
+            crashdumpObject,
             crashdumpPath + std::string("/") + logID, crashdumpInterface,
             std::move(getStoredLogCallback));
     });
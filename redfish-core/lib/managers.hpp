@@ -1281,8 +1281,8 @@ struct GetPIDValues : std::enable_shared_from_this<GetPIDValues>
             const std::string& path = subtreeLocal[0].first;
             const std::string& owner = subtreeLocal[0].second[0].first;
 
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, owner, path, thermalModeIface,
+            dbus::utility::getAllProperties(
+                owner, path, thermalModeIface,
                 [path, owner,
                  self](const boost::system::error_code ec2,
                        const dbus::utility::DBusPropertiesMap& resp) {
@@ -1494,8 +1494,8 @@ struct SetPIDValues : std::enable_shared_from_this<SetPIDValues>
 
             const std::string& path = subtree[0].first;
             const std::string& owner = subtree[0].second[0].first;
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, owner, path, thermalModeIface,
+            dbus::utility::getAllProperties(
+                owner, path, thermalModeIface,
                 [self, path, owner](const boost::system::error_code ec2,
                                     const dbus::utility::DBusPropertiesMap& r) {
                 if (ec2)
@@ -1865,10 +1865,10 @@ inline void
     std::string firmwareId = runningFirmwareTarget.substr(idPos);
 
     // Make sure the image is valid before setting priority
-    crow::connections::systemBus->async_method_call(
+    sw_util::FirmwareInventoryCache::getInstance().getImages(
         [aResp, firmwareId,
-         runningFirmwareTarget](const boost::system::error_code ec,
-                                dbus::utility::ManagedObjectType& subtree) {
+         runningFirmwareTarget](const boost::system::error_code& ec,
+                                const sw_util::SoftwareImages& images) {
         if (ec)
         {
             BMCWEB_LOG_DEBUG << "D-Bus response error getting objects.";
@@ -1876,39 +1876,21 @@ inline void
             return;
         }
 
-        if (subtree.empty())
+        if (images.empty())
         {
             BMCWEB_LOG_DEBUG << "Can't find image!";
             messages::internalError(aResp->res);
             return;
         }
 
-        bool foundImage = false;
-        for (const auto& object : subtree)
-        {
-            const std::string& path =
-                static_cast<const std::string&>(object.first);
-            std::size_t idPos2 = path.rfind('/');
-
-            if (idPos2 == std::string::npos)
-            {
-                continue;
-            }
-
-            idPos2++;
-            if (idPos2 >= path.size())
-            {
-                continue;
-            }
-
-            if (path.substr(idPos2) == firmwareId)
-            {
-                foundImage = true;
-                break;
-            }
-        }
-
-        if (!foundImage)
+        // Only images of the BMC updater can be made the running image
+        auto image = std::ranges::find_if(
+            images, [&firmwareId](const sw_util::SoftwareImage& candidate) {
+            return candidate.id == firmwareId &&
+                   candidate.service ==
+                       "xyz.openbmc_project.Software.BMC.Updater";
+            });
+        if (image == images.end())
         {
             messages::propertyValueNotInList(aResp->res, runningFirmwareTarget,
                                              "@odata.id");
@@ -1938,10 +1920,7 @@ inline void
             "org.freedesktop.DBus.Properties", "Set",
             "xyz.openbmc_project.Software.RedundancyPriority", "Priority",
             dbus::utility::DbusVariantType(static_cast<uint8_t>(0)));
-    },
-        "xyz.openbmc_project.Software.BMC.Updater",
-        "/xyz/openbmc_project/software", "org.freedesktop.DBus.ObjectManager",
-        "GetManagedObjects");
+    });
 }
 
 inline void setDateTime(std::shared_ptr<bmcweb::AsyncResp> aResp,
@@ -2217,8 +2196,8 @@ inline void requestRoutesManager(App& app)
                 if (interfaceName ==
                     "xyz.openbmc_project.Inventory.Decorator.Asset")
                 {
-                    sdbusplus::asio::getAllProperties(
-                        *crow::connections::systemBus, connectionName, path,
+                    dbus::utility::getAllProperties(
+                        connectionName, path,
                         "xyz.openbmc_project.Inventory.Decorator.Asset",
                         [asyncResp](const boost::system::error_code ec2,
                                     const dbus::utility::DBusPropertiesMap&
@@ -61,7 +61,13 @@ inline void requestRoutesMetricReportCollection(App& app)
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateTop = true,
+            .canDelegateSkip = true,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -78,7 +84,8 @@ inline void requestRoutesMetricReportCollection(App& app)
             asyncResp,
             boost::urls::url("/redfish/v1/TelemetryService/MetricReports"),
             interfaces,
-            "/xyz/openbmc_project/Telemetry/Reports/TelemetryService");
+            "/xyz/openbmc_project/Telemetry/Reports/TelemetryService",
+            delegatedQuery);
     });
 }
 
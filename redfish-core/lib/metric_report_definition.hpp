@@ -723,7 +723,13 @@ inline void requestRoutesMetricReportDefinitionCollection(App& app)
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateTop = true,
+            .canDelegateSkip = true,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -741,7 +747,8 @@ inline void requestRoutesMetricReportDefinitionCollection(App& app)
             boost::urls::url(
                 "/redfish/v1/TelemetryService/MetricReportDefinitions"),
             interfaces,
-            "/xyz/openbmc_project/Telemetry/Reports/TelemetryService");
+            "/xyz/openbmc_project/Telemetry/Reports/TelemetryService",
+            delegatedQuery);
     });
 
     BMCWEB_ROUTE(app, "/redfish/v1/TelemetryService/MetricReportDefinitions/")
@@ -804,8 +811,8 @@ inline void requestRoutesMetricReportDefinition(App& app)
             return;
         }
 
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, telemetry::service,
+        dbus::utility::getAllProperties(
+            telemetry::service,
             telemetry::getDbusReportPath(id), telemetry::reportInterface,
             [asyncResp,
              id](const boost::system::error_code& ec,
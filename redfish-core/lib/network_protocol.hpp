@@ -20,20 +20,24 @@
 #include "redfish_util.hpp"
 
 #include <app.hpp>
+#include <cancellation.hpp>
 #include <dbus_utility.hpp>
 #include <query.hpp>
 #include <registries/privilege_registry.hpp>
 #include <sdbusplus/asio/property.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
 #include <utils/json_utils.hpp>
 #include <utils/stl_utils.hpp>
 
+#include <functional>
+#include <memory>
 #include <optional>
 #include <variant>
 
 namespace redfish
 {
 
-void getNTPProtocolEnabled(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp);
 std::string getHostName();
 
 static constexpr std::string_view sshServiceName = "dropbear";
@@ -113,37 +117,325 @@ void getEthernetIfaceData(CallbackFunc&& callback)
         "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
 }
 
-inline void afterNetworkPortRequest(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const boost::system::error_code& ec,
-    const std::vector<std::tuple<std::string, std::string, bool>>& socketData)
+/**
+ * @brief What the NetworkProtocol resource reports, other than the host
+ * name, which is read locally on every request.
+ */
+struct NetworkProtocolState
 {
-    if (ec)
+    struct Protocol
     {
-        messages::internalError(asyncResp->res);
-        return;
+        std::string name;
+        bool enabled = false;
+        std::optional<int> port;
+    };
+
+    std::vector<std::string> ntpServers;
+    std::vector<std::string> domainNames;
+    // Unset if the time sync method couldn't be read
+    std::optional<bool> ntpEnabled;
+    // The protocols of networkProtocolToDbus that have a socket unit
+    std::vector<Protocol> protocols;
+    // False if xyz.openbmc_project.Network couldn't be read
+    bool networkAvailable = true;
+};
+
+/**
+ * @brief In memory copy of the NetworkProtocol state.
+ *
+ * Building it takes a GetManagedObjects of the network daemon, the time sync
+ * method, a ListUnits of systemd and a read of the listen address of every
+ * protocol socket, which is a lot for a page that management software polls.
+ * The state is built on first use, shared by readers that arrive while it is
+ * being built, and dropped when the network daemon's objects, the time sync
+ * method, or one of the protocol units change.  bmcweb subscribes to systemd
+ * for the latter, as systemd only sends unit signals once someone has.
+ */
+class NetworkProtocolCache
+{
+  public:
+    using Callback = std::function<void(const boost::system::error_code&,
+                                        const NetworkProtocolState&)>;
+
+    NetworkProtocolCache(const NetworkProtocolCache&) = delete;
+    NetworkProtocolCache(NetworkProtocolCache&&) = delete;
+    NetworkProtocolCache& operator=(const NetworkProtocolCache&) = delete;
+    NetworkProtocolCache& operator=(NetworkProtocolCache&&) = delete;
+    ~NetworkProtocolCache() = default;
+
+    static NetworkProtocolCache& getInstance()
+    {
+        static NetworkProtocolCache cache;
+        return cache;
+    }
+
+    /**
+     * @brief Calls callback with the current state, reading it from D-Bus
+     * first if it isn't cached.
+     */
+    void getState(Callback&& callback)
+    {
+        if (state)
+        {
+            callback(boost::system::error_code(), *state);
+            return;
+        }
+        waiters.emplace_back(std::move(callback));
+        if (waiters.size() == 1)
+        {
+            refresh();
+        }
+    }
+
+    void invalidate()
+    {
+        BMCWEB_LOG_DEBUG << "Network protocol state changed, dropping cache";
+        state.reset();
+        generation++;
+    }
+
+  private:
+    // Collects the results of one rebuild, and publishes them once all of the
+    // D-Bus calls it started have answered
+    struct Refresh
+    {
+        Refresh(NetworkProtocolCache& cacheIn, uint64_t generationIn) :
+            cache(cacheIn), generation(generationIn)
+        {}
+
+        Refresh(const Refresh&) = delete;
+        Refresh(Refresh&&) = delete;
+        Refresh& operator=(const Refresh&) = delete;
+        Refresh& operator=(Refresh&&) = delete;
+
+        ~Refresh()
+        {
+            cache.complete(generation, ec, std::move(found));
+        }
+
+        NetworkProtocolCache& cache;
+        uint64_t generation;
+        boost::system::error_code ec;
+        NetworkProtocolState found;
+    };
+
+    static constexpr const char* unitRoot = "/org/freedesktop/systemd1/unit";
+
+    NetworkProtocolCache()
+    {
+        namespace rules = sdbusplus::bus::match::rules;
+        auto onChange = [this](sdbusplus::message_t&) { invalidate(); };
+
+        // StaticNTPServers and DomainName of the ethernet interfaces
+        networkChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',interface='org.freedesktop.DBus.Properties',"
+            "member='PropertiesChanged',"
+            "path_namespace='/xyz/openbmc_project/network'",
+            onChange);
+        networkAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesAdded() +
+                rules::argNpath(0, "/xyz/openbmc_project/network/"),
+            onChange);
+        networkRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::interfacesRemoved() +
+                rules::argNpath(0, "/xyz/openbmc_project/network/"),
+            onChange);
+        timeSyncMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            rules::propertiesChanged(
+                "/xyz/openbmc_project/time/sync_method",
+                "xyz.openbmc_project.Time.Synchronization"),
+            onChange);
+
+        // Socket units change state as protocols are enabled and disabled,
+        // and come and go as they are installed and removed
+        unitChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',sender='org.freedesktop.systemd1',"
+            "interface='org.freedesktop.DBus.Properties',"
+            "member='PropertiesChanged',path_namespace='" +
+                std::string(unitRoot) + "'",
+            [this](sdbusplus::message_t& msg) {
+            if (isProtocolUnit(msg.get_path()))
+            {
+                invalidate();
+            }
+        });
+        auto onUnitNewOrRemoved = [this](sdbusplus::message_t& msg) {
+            std::string unitName;
+            sdbusplus::message::object_path unitPath;
+            try
+            {
+                msg.read(unitName, unitPath);
+            }
+            catch (const sdbusplus::exception_t& e)
+            {
+                BMCWEB_LOG_ERROR << "Bad systemd unit signal: " << e.what();
+                return;
+            }
+            if (isProtocolUnit(unitPath.str))
+            {
+                invalidate();
+            }
+        };
+        unitNewMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',sender='org.freedesktop.systemd1',"
+            "interface='org.freedesktop.systemd1.Manager',member='UnitNew'",
+            onUnitNewOrRemoved);
+        unitRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            *crow::connections::systemBus,
+            "type='signal',sender='org.freedesktop.systemd1',"
+            "interface='org.freedesktop.systemd1.Manager',member='UnitRemoved'",
+            onUnitNewOrRemoved);
+        crow::connections::systemBus->async_method_call(
+            [](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Subscribing to systemd failed " << ec;
+            }
+        },
+            "org.freedesktop.systemd1", "/org/freedesktop/systemd1",
+            "org.freedesktop.systemd1.Manager", "Subscribe");
+    }
+
+    // Whether a unit object is one of the protocols' services or sockets.
+    // systemd escapes unit names in object paths the same way sdbusplus
+    // does, so comparing the escaped forms is enough.
+    static bool isProtocolUnit(std::string_view unitPath)
+    {
+        for (const auto& protocol : networkProtocolToDbus)
+        {
+            sdbusplus::message::object_path prefix(unitRoot);
+            prefix /= protocol.second;
+            if (unitPath.starts_with(prefix.str))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void complete(uint64_t refreshGeneration,
+                  const boost::system::error_code& ec,
+                  NetworkProtocolState&& found)
+    {
+        std::vector<Callback> callbacks = std::move(waiters);
+        waiters.clear();
+
+        if (!ec && refreshGeneration == generation)
+        {
+            state = std::move(found);
+            for (Callback& callback : callbacks)
+            {
+                callback(ec, *state);
+            }
+            return;
+        }
+        // Failed, or raced with a change and may be a mix of old and new
+        // state; good enough for the readers that waited, but not kept
+        for (Callback& callback : callbacks)
+        {
+            callback(ec, found);
+        }
     }
-    for (const auto& data : socketData)
+
+    void refresh()
     {
-        const std::string& socketPath = get<0>(data);
-        const std::string& protocolName = get<1>(data);
-        bool isProtocolEnabled = get<2>(data);
-
-        asyncResp->res.jsonValue[protocolName]["ProtocolEnabled"] =
-            isProtocolEnabled;
-        asyncResp->res.jsonValue[protocolName]["Port"] = nullptr;
-        getPortNumber(socketPath, [asyncResp, protocolName](
-                                      const boost::system::error_code& ec2,
-                                      int portNumber) {
-            if (ec2)
+        // Shared by every reader, so not cut short with the one request that
+        // started it
+        crow::CancellationScope noCancellation(nullptr);
+        auto refresh = std::make_shared<Refresh>(*this, generation);
+
+        getEthernetIfaceData(
+            [refresh](const bool& success,
+                      const std::vector<std::string>& ntpServers,
+                      const std::vector<std::string>& domainNames) {
+            if (!success)
+            {
+                refresh->found.networkAvailable = false;
+                refresh->ec = boost::system::errc::make_error_code(
+                    boost::system::errc::io_error);
+                return;
+            }
+            refresh->found.ntpServers = ntpServers;
+            refresh->found.domainNames = domainNames;
+        });
+
+        sdbusplus::asio::getProperty<std::string>(
+            *crow::connections::systemBus, "xyz.openbmc_project.Settings",
+            "/xyz/openbmc_project/time/sync_method",
+            "xyz.openbmc_project.Time.Synchronization", "TimeSyncMethod",
+            [refresh](const boost::system::error_code& ec,
+                      const std::string& timeSyncMethod) {
+            if (ec)
+            {
+                return;
+            }
+            if (timeSyncMethod ==
+                "xyz.openbmc_project.Time.Synchronization.Method.NTP")
+            {
+                refresh->found.ntpEnabled = true;
+            }
+            else if (timeSyncMethod ==
+                     "xyz.openbmc_project.Time.Synchronization.Method.Manual")
+            {
+                refresh->found.ntpEnabled = false;
+            }
+        });
+
+        getPortStatusAndPath(
+            std::span(networkProtocolToDbus),
+            [refresh](const boost::system::error_code& ec,
+                      const std::vector<std::tuple<std::string, std::string,
+                                                   bool>>& socketData) {
+            if (ec)
             {
-                messages::internalError(asyncResp->res);
+                refresh->ec = ec;
                 return;
             }
-            asyncResp->res.jsonValue[protocolName]["Port"] = portNumber;
+            // protocols is complete before any port is read, so the indexes
+            // handed out stay valid
+            std::vector<NetworkProtocolState::Protocol>& protocols =
+                refresh->found.protocols;
+            for (const auto& [socketPath, name, enabled] : socketData)
+            {
+                protocols.emplace_back(name, enabled, std::nullopt);
+            }
+            for (size_t index = 0; index < socketData.size(); index++)
+            {
+                getPortNumber(std::get<0>(socketData[index]),
+                              [refresh, index](
+                                  const boost::system::error_code& ec2,
+                                  int portNumber) {
+                    if (ec2)
+                    {
+                        refresh->ec = ec2;
+                        return;
+                    }
+                    refresh->found.protocols[index].port = portNumber;
+                });
+            }
         });
     }
-}
+
+    std::optional<NetworkProtocolState> state;
+    // Bumped on every change signal, so a refresh that raced with a change
+    // is not cached
+    uint64_t generation = 0;
+    std::vector<Callback> waiters;
+
+    std::unique_ptr<sdbusplus::bus::match_t> networkChangedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> networkAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> networkRemovedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> timeSyncMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> unitChangedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> unitNewMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> unitRemovedMatch;
+};
 
 inline void getNetworkData(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                            const crow::Request& req)
@@ -184,29 +476,50 @@ inline void getNetworkData(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
 
     asyncResp->res.jsonValue["HostName"] = hostName;
 
-    getNTPProtocolEnabled(asyncResp);
-
-    getEthernetIfaceData(
-        [hostName, asyncResp](const bool& success,
-                              const std::vector<std::string>& ntpServers,
-                              const std::vector<std::string>& domainNames) {
-        if (!success)
+    NetworkProtocolCache::getInstance().getState(
+        [hostName, asyncResp](const boost::system::error_code& ec,
+                              const NetworkProtocolState& state) {
+        if (!state.networkAvailable)
         {
             messages::resourceNotFound(asyncResp->res, "ManagerNetworkProtocol",
                                        "NetworkProtocol");
             return;
         }
-        asyncResp->res.jsonValue["NTP"]["NTPServers"] = ntpServers;
+        if (ec)
+        {
+            messages::internalError(asyncResp->res);
+            return;
+        }
+        if (state.ntpEnabled)
+        {
+            asyncResp->res.jsonValue["NTP"]["ProtocolEnabled"] =
+                *state.ntpEnabled;
+        }
+        asyncResp->res.jsonValue["NTP"]["NTPServers"] = state.ntpServers;
         if (!hostName.empty())
         {
             std::string fqdn = hostName;
-            if (!domainNames.empty())
+            if (!state.domainNames.empty())
             {
                 fqdn += ".";
-                fqdn += domainNames[0];
+                fqdn += state.domainNames[0];
             }
             asyncResp->res.jsonValue["FQDN"] = std::move(fqdn);
         }
+        for (const NetworkProtocolState::Protocol& protocol : state.protocols)
+        {
+            nlohmann::json& protocolJson =
+                asyncResp->res.jsonValue[protocol.name];
+            protocolJson["ProtocolEnabled"] = protocol.enabled;
+            if (protocol.port)
+            {
+                protocolJson["Port"] = *protocol.port;
+            }
+            else
+            {
+                protocolJson["Port"] = nullptr;
+            }
+        }
     });
 
     Privileges effectiveUserPrivileges =
@@ -221,10 +534,7 @@ inline void getNetworkData(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         asyncResp->res.jsonValue["HTTPS"]["Certificates"]["@odata.id"] =
             "/redfish/v1/Managers/bmc/NetworkProtocol/HTTPS/Certificates";
     }
-
-    getPortStatusAndPath(std::span(networkProtocolToDbus),
-                         std::bind_front(afterNetworkPortRequest, asyncResp));
-} // namespace redfish
+}
 
 inline void handleNTPProtocolEnabled(
     const bool& ntpEnabled, const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
@@ -245,7 +555,9 @@ inline void handleNTPProtocolEnabled(
         if (errorCode)
         {
             messages::internalError(asyncResp->res);
+            return;
         }
+        NetworkProtocolCache::getInstance().invalidate();
     },
         "xyz.openbmc_project.Settings", "/xyz/openbmc_project/time/sync_method",
         "org.freedesktop.DBus.Properties", "Set",
@@ -361,6 +673,7 @@ inline void
                             messages::internalError(asyncResp->res);
                             return;
                         }
+                        NetworkProtocolCache::getInstance().invalidate();
                     },
                         service, objectPath, "org.freedesktop.DBus.Properties",
                         "Set", interface, "StaticNTPServers",
@@ -402,6 +715,7 @@ inline void
                         messages::internalError(asyncResp->res);
                         return;
                     }
+                    NetworkProtocolCache::getInstance().invalidate();
                 },
                     entry.second.begin()->first, entry.first,
                     "org.freedesktop.DBus.Properties", "Set",
@@ -415,6 +729,7 @@ inline void
                         messages::internalError(asyncResp->res);
                         return;
                     }
+                    NetworkProtocolCache::getInstance().invalidate();
                 },
                     entry.second.begin()->first, entry.first,
                     "org.freedesktop.DBus.Properties", "Set",
@@ -442,33 +757,6 @@ inline std::string getHostName()
     return hostName;
 }
 
-inline void
-    getNTPProtocolEnabled(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
-{
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, "xyz.openbmc_project.Settings",
-        "/xyz/openbmc_project/time/sync_method",
-        "xyz.openbmc_project.Time.Synchronization", "TimeSyncMethod",
-        [asyncResp](const boost::system::error_code errorCode,
-                    const std::string& timeSyncMethod) {
-        if (errorCode)
-        {
-            return;
-        }
-
-        if (timeSyncMethod ==
-            "xyz.openbmc_project.Time.Synchronization.Method.NTP")
-        {
-            asyncResp->res.jsonValue["NTP"]["ProtocolEnabled"] = true;
-        }
-        else if (timeSyncMethod == "xyz.openbmc_project.Time.Synchronization."
-                                   "Method.Manual")
-        {
-            asyncResp->res.jsonValue["NTP"]["ProtocolEnabled"] = false;
-        }
-    });
-}
-
 inline std::string encodeServiceObjectPath(std::string_view serviceName)
 {
     sdbusplus::message::object_path objPath(
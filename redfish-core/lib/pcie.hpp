@@ -653,8 +653,8 @@ inline void
         sdbusplus::message::object_path objpath(pcieDevicePath);
         std::string pcieSlotPath = objpath.parent_path();
 
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, serviceName, pcieDevicePath, "",
+        dbus::utility::getAllProperties(
+            serviceName, pcieDevicePath, "",
             [asyncResp, device, pcieDevicePath, pcieSlotPath,
              getPCIeDevicePropertiesCallback](
                 const boost::system::error_code& ec1,
@@ -847,8 +847,8 @@ inline void requestRoutesSystemPCIeFunctionCollection(App& app)
                 return;
             }
 
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, serviceName, pcieDevicePath,
+            dbus::utility::getAllProperties(
+                serviceName, pcieDevicePath,
                 "xyz.openbmc_project.Inventory.Item.PCIeDevice",
                 std::move(getPCIeDeviceCallback));
         });
@@ -985,8 +985,8 @@ inline void requestRoutesSystemPCIeFunction(App& app)
                 return;
             }
 
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, serviceName, pcieDevicePath,
+            dbus::utility::getAllProperties(
+                serviceName, pcieDevicePath,
                 "xyz.openbmc_project.Inventory.Item.PCIeDevice",
                 getPCIeDeviceCallback);
         });
@@ -518,8 +518,8 @@ inline void doHandlePCIeSlotCollectionGet(
 
         for (const auto& [pcieSlotPath, connectionName] : slotPathConnNames)
         {
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, connectionName, pcieSlotPath,
+            dbus::utility::getAllProperties(
+                connectionName, pcieSlotPath,
                 "xyz.openbmc_project.Inventory.Item.PCIeSlot",
                 [asyncResp, connectionName, pcieSlotPath](
                     const boost::system::error_code& ec,
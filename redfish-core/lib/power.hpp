@@ -120,6 +120,7 @@ inline void requestRoutesPower(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Chassis/<str>/Power/")
         .privileges(redfish::privileges::getPower)
+        .expensive()
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -288,8 +289,8 @@ inline void requestRoutesPower(App& app)
                 }
             };
 
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, "xyz.openbmc_project.Settings",
+            dbus::utility::getAllProperties(
+                "xyz.openbmc_project.Settings",
                 "/xyz/openbmc_project/control/host0/power_cap",
                 "xyz.openbmc_project.Control.Power.Cap",
                 std::move(valueHandler));
@@ -39,8 +39,8 @@ inline void getPowerSubsystemAllocationProperties(
     const std::string& service, const std::string& objectPath)
 {
     // Get all properties of Power.Cap D-Bus interface
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, objectPath, powerCapInterface,
+    dbus::utility::getAllProperties(
+        service, objectPath, powerCapInterface,
         [asyncResp](const boost::system::error_code& ec,
                     const dbus::utility::DBusPropertiesMap& propertiesList) {
         if (ec)
@@ -7,7 +7,10 @@
 #include "registries/privilege_registry.hpp"
 #include "utils/chassis_utils.hpp"
 #include "utils/power_supply_utils.hpp"
+#include "utils/property_mapping.hpp"
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -142,190 +145,66 @@ inline void requestRoutesPowerSupplyCollection(App& app)
             std::bind_front(handlePowerSupplyCollectionGet, std::ref(app)));
 }
 
-inline void
-    getPowerSupplyState(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::string& service, const std::string& path,
-                        bool available)
+constexpr const char* powerSupplyAvailabilityInterface =
+    "xyz.openbmc_project.State.Decorator.Availability";
+
+constexpr std::array<property_mapping::PropertyMapping, 10>
+    powerSupplyProperties = {{
+        {"xyz.openbmc_project.Inventory.Decorator.Asset", "PartNumber",
+         "/PartNumber", property_mapping::transforms::copy<std::string>},
+        {"xyz.openbmc_project.Inventory.Decorator.Asset", "SerialNumber",
+         "/SerialNumber", property_mapping::transforms::copy<std::string>},
+        {"xyz.openbmc_project.Inventory.Decorator.Asset", "Manufacturer",
+         "/Manufacturer", property_mapping::transforms::copy<std::string>},
+        {"xyz.openbmc_project.Inventory.Decorator.Asset", "Model", "/Model",
+         property_mapping::transforms::copy<std::string>},
+        // SparePartNumber is optional on D-Bus so skip if it is empty
+        {"xyz.openbmc_project.Inventory.Decorator.Asset", "SparePartNumber",
+         "/SparePartNumber", property_mapping::transforms::nonEmptyString},
+        {"xyz.openbmc_project.Software.Version", "Version", "/FirmwareVersion",
+         property_mapping::transforms::copy<std::string>},
+        {"xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
+         "/Location/PartLocation/ServiceLabel",
+         property_mapping::transforms::copy<std::string>},
+        // Status depends on all three, so is set by setPowerSupplyStatus
+        {powerSupplyAvailabilityInterface, "Available", "", nullptr},
+        {"xyz.openbmc_project.Inventory.Item", "Present", "", nullptr},
+        {"xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
+         "", nullptr},
+    }};
+
+inline void setPowerSupplyStatus(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const property_mapping::InterfaceProperties& properties)
 {
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Item", "Present",
-        [asyncResp, available](const boost::system::error_code ec,
-                               const bool value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
+    const bool* available = property_mapping::findProperty<bool>(
+        properties, powerSupplyAvailabilityInterface, "Available");
+    if (available == nullptr)
+    {
+        return;
+    }
 
-        if (!value)
+    const bool* present = property_mapping::findProperty<bool>(
+        properties, "xyz.openbmc_project.Inventory.Item", "Present");
+    if (present != nullptr)
+    {
+        if (!*present)
         {
             asyncResp->res.jsonValue["Status"]["State"] = "Absent";
         }
-        else if (!available)
+        else if (!*available)
         {
             asyncResp->res.jsonValue["Status"]["State"] = "UnavailableOffline";
         }
-    });
-}
-
-inline void
-    getPowerSupplyHealth(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                         const std::string& service, const std::string& path,
-                         bool available)
-{
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
-        [asyncResp, available](const boost::system::error_code ec,
-                               const bool value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        if (!value || !available)
-        {
-            asyncResp->res.jsonValue["Status"]["Health"] = "Critical";
-        }
-    });
-}
-
-inline void getPowerSupplyStateAndHealth(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getProperty<bool>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.State.Decorator.Availability", "Available",
-        [asyncResp, service, path](const boost::system::error_code ec,
-                                   const bool available) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        getPowerSupplyState(asyncResp, service, path, available);
-
-        getPowerSupplyHealth(asyncResp, service, path, available);
-    });
-}
-
-inline void
-    getPowerSupplyAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                        const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Decorator.Asset",
-        [asyncResp](const boost::system::error_code ec,
-                    const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-
-        const std::string* partNumber = nullptr;
-        const std::string* serialNumber = nullptr;
-        const std::string* manufacturer = nullptr;
-        const std::string* model = nullptr;
-        const std::string* sparePartNumber = nullptr;
-
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "PartNumber",
-            partNumber, "SerialNumber", serialNumber, "Manufacturer",
-            manufacturer, "Model", model, "SparePartNumber", sparePartNumber);
-
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (partNumber != nullptr)
-        {
-            asyncResp->res.jsonValue["PartNumber"] = *partNumber;
-        }
-
-        if (serialNumber != nullptr)
-        {
-            asyncResp->res.jsonValue["SerialNumber"] = *serialNumber;
-        }
-
-        if (manufacturer != nullptr)
-        {
-            asyncResp->res.jsonValue["Manufacturer"] = *manufacturer;
-        }
-
-        if (model != nullptr)
-        {
-            asyncResp->res.jsonValue["Model"] = *model;
-        }
-
-        // SparePartNumber is optional on D-Bus so skip if it is empty
-        if (sparePartNumber != nullptr && !sparePartNumber->empty())
-        {
-            asyncResp->res.jsonValue["SparePartNumber"] = *sparePartNumber;
-        }
-    });
-}
-
-inline void getPowerSupplyFirmwareVersion(
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Software.Version", "Version",
-        [asyncResp](const boost::system::error_code ec,
-                    const std::string& value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-        asyncResp->res.jsonValue["FirmwareVersion"] = value;
-    });
-}
+    }
 
-inline void
-    getPowerSupplyLocation(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                           const std::string& service, const std::string& path)
-{
-    sdbusplus::asio::getProperty<std::string>(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Inventory.Decorator.LocationCode", "LocationCode",
-        [asyncResp](const boost::system::error_code ec,
-                    const std::string& value) {
-        if (ec)
-        {
-            if (ec.value() != EBADR)
-            {
-                messages::internalError(asyncResp->res);
-            }
-            return;
-        }
-        asyncResp->res.jsonValue["Location"]["PartLocation"]["ServiceLabel"] =
-            value;
-    });
+    const bool* functional = property_mapping::findProperty<bool>(
+        properties, "xyz.openbmc_project.State.Decorator.OperationalStatus",
+        "Functional");
+    if (functional != nullptr && (!*functional || !*available))
+    {
+        asyncResp->res.jsonValue["Status"]["Health"] = "Critical";
+    }
 }
 
 inline void
@@ -442,14 +321,10 @@ inline void
                 return;
             }
 
-            getPowerSupplyStateAndHealth(asyncResp, object.begin()->first,
-                                         powerSupplyPath);
-            getPowerSupplyAsset(asyncResp, object.begin()->first,
-                                powerSupplyPath);
-            getPowerSupplyFirmwareVersion(asyncResp, object.begin()->first,
-                                          powerSupplyPath);
-            getPowerSupplyLocation(asyncResp, object.begin()->first,
-                                   powerSupplyPath);
+            property_mapping::fillProperties(
+                asyncResp, object.begin()->first, powerSupplyPath,
+                powerSupplyProperties, object.begin()->second,
+                std::bind_front(setPowerSupplyStatus, asyncResp));
         });
 
         getEfficiencyPercent(asyncResp);
@@ -148,8 +148,8 @@ inline void getInputHistory(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         [asyncResp, historyPaths](const std::string& service,
                                   const std::string& interface) mutable {
         // Get all properties from the first history path
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, service, historyPaths.front(),
+        dbus::utility::getAllProperties(
+            service, historyPaths.front(),
             interface,
             [asyncResp, historyPaths,
              interface](const boost::system::error_code& ec,
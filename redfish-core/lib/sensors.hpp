@@ -1019,8 +1019,8 @@ inline void populateFanRedundancy(
                 {
                     return;
                 }
-                sdbusplus::asio::getAllProperties(
-                    *crow::connections::systemBus, owner, path,
+                dbus::utility::getAllProperties(
+                    owner, path,
                     "xyz.openbmc_project.Control.FanRedundancy",
                     [path, sensorsAsyncResp](
                         const boost::system::error_code& err,
@@ -2868,8 +2868,8 @@ inline void
     BMCWEB_LOG_DEBUG << "Looking up " << connectionName;
     BMCWEB_LOG_DEBUG << "Path " << sensorPath;
 
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, connectionName, sensorPath, "",
+    dbus::utility::getAllProperties(
+        connectionName, sensorPath, "",
         [asyncResp,
          sensorPath](const boost::system::error_code ec,
                      const ::dbus::utility::DBusPropertiesMap& valuesDict) {
@@ -2945,6 +2945,7 @@ inline void requestRoutesSensorCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Chassis/<str>/Sensors/")
         .privileges(redfish::privileges::getSensorCollection)
+        .expensive()
         .methods(boost::beast::http::verb::get)(
             std::bind_front(sensors::handleSensorCollectionGet, std::ref(app)));
 }
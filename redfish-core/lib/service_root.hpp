@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include "dbus_utility.hpp"
 #include "utils/dbus_utils.hpp"
 
 #include <bmcweb_config.h>
@@ -117,8 +118,8 @@ inline void
                     if (interfaceName ==
                         "xyz.openbmc_project.Inventory.Item.System")
                     {
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
+                        dbus::utility::getAllProperties(
+                            connection.first,
                             path,
                             "xyz.openbmc_project.Inventory.Decorator.Asset",
                             [asyncResp](const boost::system::error_code ec2,
@@ -176,8 +176,8 @@ inline void
                 }
             });
 
-            sdbusplus::asio::getAllProperties(
-                *crow::connections::systemBus, connectionName, path,
+            dbus::utility::getAllProperties(
+                connectionName, path,
                 "xyz.openbmc_project.Inventory.Decorator.Asset",
                 [asyncResp, index](
                     const boost::system::error_code ec2,
@@ -266,8 +266,8 @@ inline void getDriveAsset(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                           const std::string& connectionName,
                           const std::string& path)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, connectionName, path,
+    dbus::utility::getAllProperties(
+        connectionName, path,
         "xyz.openbmc_project.Inventory.Decorator.Asset",
         [asyncResp](const boost::system::error_code ec,
                     const std::vector<
@@ -417,8 +417,8 @@ inline void
                            const std::string& connectionName,
                            const std::string& path)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, connectionName, path,
+    dbus::utility::getAllProperties(
+        connectionName, path,
         "xyz.openbmc_project.Inventory.Item.Drive",
         [asyncResp](const boost::system::error_code ec,
                     const std::vector<
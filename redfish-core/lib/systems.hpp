@@ -219,8 +219,8 @@ inline void getProcessorSummary(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
         "xyz.openbmc_project.State.Decorator.OperationalStatus", "Functional",
         std::move(getCpuFunctionalState));
 
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
+    dbus::utility::getAllProperties(
+        service, path,
         "xyz.openbmc_project.Inventory.Item.Cpu",
         [aResp, service,
          path](const boost::system::error_code ec2,
@@ -283,8 +283,8 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                         BMCWEB_LOG_DEBUG
                             << "Found Dimm, now get its properties.";
 
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
+                        dbus::utility::getAllProperties(
+                            connection.first,
                             path, "xyz.openbmc_project.Inventory.Item.Dimm",
                             [aResp, service{connection.first},
                              path](const boost::system::error_code ec2,
@@ -378,8 +378,8 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                         BMCWEB_LOG_DEBUG
                             << "Found UUID, now get its properties.";
 
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
+                        dbus::utility::getAllProperties(
+                            connection.first,
                             path, "xyz.openbmc_project.Common.UUID",
                             [aResp](const boost::system::error_code ec3,
                                     const dbus::utility::DBusPropertiesMap&
@@ -425,8 +425,8 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                     else if (interfaceName ==
                              "xyz.openbmc_project.Inventory.Item.System")
                     {
-                        sdbusplus::asio::getAllProperties(
-                            *crow::connections::systemBus, connection.first,
+                        dbus::utility::getAllProperties(
+                            connection.first,
                             path,
                             "xyz.openbmc_project.Inventory.Decorator.Asset",
                             [aResp](const boost::system::error_code ec2,
@@ -1371,8 +1371,8 @@ inline void
 inline void getProvisioningStatus(std::shared_ptr<bmcweb::AsyncResp> aResp)
 {
     BMCWEB_LOG_DEBUG << "Get OEM information.";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.PFR.Manager",
+    dbus::utility::getAllProperties(
+        "xyz.openbmc_project.PFR.Manager",
         "/xyz/openbmc_project/pfr", "xyz.openbmc_project.PFR.Attributes",
         [aResp](const boost::system::error_code ec,
                 const dbus::utility::DBusPropertiesMap& propertiesList) {
@@ -1523,8 +1523,8 @@ inline void getPowerMode(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
         }
 
         // Valid Power Mode object found, now read the current value
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, service, path,
+        dbus::utility::getAllProperties(
+            service, path,
             "xyz.openbmc_project.Control.Power.Mode",
             [aResp](const boost::system::error_code ec2,
                     const dbus::utility::DBusPropertiesMap& properties) {
@@ -1769,8 +1769,8 @@ inline void
     getHostWatchdogTimer(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
 {
     BMCWEB_LOG_DEBUG << "Get host watchodg";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.Watchdog",
+    dbus::utility::getAllProperties(
+        "xyz.openbmc_project.Watchdog",
         "/xyz/openbmc_project/watchdog/host0",
         "xyz.openbmc_project.State.Watchdog",
         [aResp](const boost::system::error_code ec,
@@ -2006,8 +2006,8 @@ inline void getIdlePowerSaver(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
         }
 
         // Valid IdlePowerSaver object found, now read the current values
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, service, path,
+        dbus::utility::getAllProperties(
+            service, path,
             "xyz.openbmc_project.Control.Power.IdlePowerSaver",
             [aResp](const boost::system::error_code ec2,
                     const dbus::utility::DBusPropertiesMap& properties) {
@@ -2191,8 +2191,8 @@ inline void requestRoutesSystemActionsOemExecutePanelFunction(App& app)
 inline void getChapData(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
     BMCWEB_LOG_DEBUG << "Get ChapData";
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, "xyz.openbmc_project.PLDM",
+    dbus::utility::getAllProperties(
+        "xyz.openbmc_project.PLDM",
         "/xyz/openbmc_project/pldm", "com.ibm.PLDM.ChapData",
         [asyncResp](const boost::system::error_code ec,
                     const dbus::utility::DBusPropertiesMap& propertiesList) {
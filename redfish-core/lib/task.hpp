@@ -46,7 +46,7 @@ struct Payload
     explicit Payload(const crow::Request& req) :
         targetUri(req.url), httpOperation(req.methodString()),
         httpHeaders(nlohmann::json::array()),
-        jsonBody(nlohmann::json::parse(req.body, nullptr, false))
+        jsonBody(nlohmann::json::parse(req.body(), nullptr, false))
     {
         using field_ns = boost::beast::http::field;
         constexpr const std::array<boost::beast::http::field, 7>
@@ -60,7 +60,7 @@ struct Payload
             jsonBody = nullptr;
         }
 
-        for (const auto& field : req.fields)
+        for (const auto& field : req.fields())
         {
             if (std::find(headerWhitelist.begin(), headerWhitelist.end(),
                           field.name()) == headerWhitelist.end())
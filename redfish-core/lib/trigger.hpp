@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dbus_utility.hpp"
 #include "utils/collection.hpp"
 #include "utils/telemetry_utils.hpp"
 
@@ -295,7 +296,13 @@ inline void requestRoutesTriggerCollection(App& app)
         .methods(boost::beast::http::verb::get)(
             [&app](const crow::Request& req,
                    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-        if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+        query_param::QueryCapabilities capabilities = {
+            .canDelegateTop = true,
+            .canDelegateSkip = true,
+        };
+        query_param::Query delegatedQuery;
+        if (!redfish::setUpRedfishRouteWithDelegation(
+                app, req, asyncResp, delegatedQuery, capabilities))
         {
             return;
         }
@@ -310,7 +317,8 @@ inline void requestRoutesTriggerCollection(App& app)
             asyncResp,
             boost::urls::url("/redfish/v1/TelemetryService/Triggers"),
             interfaces,
-            "/xyz/openbmc_project/Telemetry/Triggers/TelemetryService");
+            "/xyz/openbmc_project/Telemetry/Triggers/TelemetryService",
+            delegatedQuery);
     });
 }
 
@@ -326,8 +334,8 @@ inline void requestRoutesTrigger(App& app)
         {
             return;
         }
-        sdbusplus::asio::getAllProperties(
-            *crow::connections::systemBus, telemetry::service,
+        dbus::utility::getAllProperties(
+            telemetry::service,
             telemetry::getDbusTriggerPath(id), telemetry::triggerInterface,
             [asyncResp,
              id](const boost::system::error_code ec,
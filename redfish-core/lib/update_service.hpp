@@ -665,7 +665,7 @@ inline void
     BMCWEB_LOG_DEBUG << "Writing file to " << filepath;
     std::ofstream out(filepath, std::ofstream::out | std::ofstream::binary |
                                     std::ofstream::trunc);
-    out << req.body;
+    out << req.body();
     out.close();
     BMCWEB_LOG_DEBUG << "file upload complete!!";
 }
@@ -903,48 +903,26 @@ inline void requestRoutesSoftwareInventoryCollection(App& app)
             "/redfish/v1/UpdateService/FirmwareInventory";
         asyncResp->res.jsonValue["Name"] = "Software Inventory Collection";
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp](
-                const boost::system::error_code ec,
-                const dbus::utility::MapperGetSubTreeResponse& subtree) {
+        sw_util::FirmwareInventoryCache::getInstance().getImages(
+            [asyncResp](const boost::system::error_code& ec,
+                        const sw_util::SoftwareImages& images) {
             if (ec)
             {
                 messages::internalError(asyncResp->res);
                 return;
             }
-            asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
-            asyncResp->res.jsonValue["Members@odata.count"] = 0;
-
-            for (const auto& obj : subtree)
+            nlohmann::json::array_t members;
+            members.reserve(images.size());
+            for (const sw_util::SoftwareImage& image : images)
             {
-                sdbusplus::message::object_path path(obj.first);
-                std::string swId = path.filename();
-                if (swId.empty())
-                {
-                    messages::internalError(asyncResp->res);
-                    BMCWEB_LOG_DEBUG << "Can't parse firmware ID!!";
-                    return;
-                }
-
-                nlohmann::json& members = asyncResp->res.jsonValue["Members"];
                 nlohmann::json::object_t member;
                 member["@odata.id"] =
-                    "/redfish/v1/UpdateService/FirmwareInventory/" + swId;
+                    "/redfish/v1/UpdateService/FirmwareInventory/" + image.id;
                 members.push_back(std::move(member));
-                asyncResp->res.jsonValue["Members@odata.count"] =
-                    members.size();
             }
-        },
-            // Note that only firmware levels associated with a device
-            // are stored under /xyz/openbmc_project/software therefore
-            // to ensure only real FirmwareInventory items are returned,
-            // this full object path must be used here as input to
-            // mapper
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-            "/xyz/openbmc_project/software", static_cast<int32_t>(0),
-            std::array<const char*, 1>{"xyz.openbmc_project.Software.Version"});
+            asyncResp->res.jsonValue["Members@odata.count"] = members.size();
+            asyncResp->res.jsonValue["Members"] = std::move(members);
+        });
     });
 }
 /* Fill related item links (i.e. bmc, bios) in for inventory */
@@ -976,74 +954,39 @@ inline static void
 
 inline void
     getSoftwareVersion(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-                       const std::string& service, const std::string& path,
-                       const std::string& swId)
+                       const sw_util::SoftwareImage& image)
 {
-    sdbusplus::asio::getAllProperties(
-        *crow::connections::systemBus, service, path,
-        "xyz.openbmc_project.Software.Version",
-        [asyncResp,
-         swId](const boost::system::error_code errorCode,
-               const dbus::utility::DBusPropertiesMap& propertiesList) {
-        if (errorCode)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        const std::string* swInvPurpose = nullptr;
-        const std::string* version = nullptr;
-
-        const bool success = sdbusplus::unpackPropertiesNoThrow(
-            dbus_utils::UnpackErrorPrinter(), propertiesList, "Purpose",
-            swInvPurpose, "Version", version);
-
-        if (!success)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-
-        if (swInvPurpose == nullptr)
-        {
-            BMCWEB_LOG_DEBUG << "Can't find property \"Purpose\"!";
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    if (image.purpose.empty())
+    {
+        BMCWEB_LOG_DEBUG << "Can't find property \"Purpose\"!";
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        BMCWEB_LOG_DEBUG << "swInvPurpose = " << *swInvPurpose;
+    BMCWEB_LOG_DEBUG << "swInvPurpose = " << image.purpose;
 
-        if (version == nullptr)
-        {
-            BMCWEB_LOG_DEBUG << "Can't find property \"Version\"!";
+    asyncResp->res.jsonValue["Version"] = image.version;
+    asyncResp->res.jsonValue["Id"] = image.id;
 
-            messages::internalError(asyncResp->res);
-
-            return;
-        }
-        asyncResp->res.jsonValue["Version"] = *version;
-        asyncResp->res.jsonValue["Id"] = swId;
-
-        // swInvPurpose is of format:
-        // xyz.openbmc_project.Software.Version.VersionPurpose.ABC
-        // Translate this to "ABC image"
-        size_t endDesc = swInvPurpose->rfind('.');
-        if (endDesc == std::string::npos)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        endDesc++;
-        if (endDesc >= swInvPurpose->size())
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
+    // swInvPurpose is of format:
+    // xyz.openbmc_project.Software.Version.VersionPurpose.ABC
+    // Translate this to "ABC image"
+    size_t endDesc = image.purpose.rfind('.');
+    if (endDesc == std::string::npos)
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
+    endDesc++;
+    if (endDesc >= image.purpose.size())
+    {
+        messages::internalError(asyncResp->res);
+        return;
+    }
 
-        std::string formatDesc = swInvPurpose->substr(endDesc);
-        asyncResp->res.jsonValue["Description"] = formatDesc + " image";
-        getRelatedItems(asyncResp, *swInvPurpose);
-    });
+    std::string formatDesc = image.purpose.substr(endDesc);
+    asyncResp->res.jsonValue["Description"] = formatDesc + " image";
+    getRelatedItems(asyncResp, image.purpose);
 }
 
 inline void requestRoutesSoftwareInventory(App& app)
@@ -1058,16 +1001,12 @@ inline void requestRoutesSoftwareInventory(App& app)
         {
             return;
         }
-        std::shared_ptr<std::string> swId =
-            std::make_shared<std::string>(param);
-
         asyncResp->res.jsonValue["@odata.id"] =
-            "/redfish/v1/UpdateService/FirmwareInventory/" + *swId;
+            "/redfish/v1/UpdateService/FirmwareInventory/" + param;
 
-        crow::connections::systemBus->async_method_call(
-            [asyncResp,
-             swId](const boost::system::error_code ec,
-                   const dbus::utility::MapperGetSubTreeResponse& subtree) {
+        sw_util::FirmwareInventoryCache::getInstance().getImages(
+            [asyncResp, swId{param}](const boost::system::error_code& ec,
+                                     const sw_util::SoftwareImages& images) {
             BMCWEB_LOG_DEBUG << "doGet callback...";
             if (ec)
             {
@@ -1076,49 +1015,26 @@ inline void requestRoutesSoftwareInventory(App& app)
             }
 
             // Ensure we find our input swId, otherwise return an error
-            bool found = false;
-            for (const std::pair<std::string,
-                                 std::vector<std::pair<
-                                     std::string, std::vector<std::string>>>>&
-                     obj : subtree)
+            auto image = std::ranges::find(images, swId,
+                                           &sw_util::SoftwareImage::id);
+            if (image == images.end())
             {
-                if (!obj.first.ends_with(*swId))
-                {
-                    continue;
-                }
-
-                if (obj.second.empty())
-                {
-                    continue;
-                }
-
-                found = true;
-                sw_util::getSwStatus(asyncResp, swId, obj.second[0].first);
-                getSoftwareVersion(asyncResp, obj.second[0].first, obj.first,
-                                   *swId);
-                asyncResp->res.jsonValue["Name"] = "Software Inventory";
-            }
-            if (!found)
-            {
-                BMCWEB_LOG_ERROR << "Input swID " << *swId << " not found!";
+                BMCWEB_LOG_ERROR << "Input swID " << swId << " not found!";
                 messages::resourceMissingAtURI(
                     asyncResp->res, crow::utility::urlFromPieces(
                                         "redfish", "v1", "UpdateService",
-                                        "FirmwareInventory", *swId));
+                                        "FirmwareInventory", swId));
                 return;
             }
+
+            asyncResp->res.jsonValue["Name"] = "Software Inventory";
             asyncResp->res.jsonValue["@odata.type"] =
                 "#SoftwareInventory.v1_1_0.SoftwareInventory";
             asyncResp->res.jsonValue["Status"]["HealthRollup"] = "OK";
-
-            asyncResp->res.jsonValue["Updateable"] = false;
-            sw_util::getSwUpdatableStatus(asyncResp, swId);
-        },
-            "xyz.openbmc_project.ObjectMapper",
-            "/xyz/openbmc_project/object_mapper",
-            "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/",
-            static_cast<int32_t>(0),
-            std::array<const char*, 1>{"xyz.openbmc_project.Software.Version"});
+            asyncResp->res.jsonValue["Updateable"] = image->updateable;
+            sw_util::getSwStatus(asyncResp, *image);
+            getSoftwareVersion(asyncResp, *image);
+        });
     });
 }
 
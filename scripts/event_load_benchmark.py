@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+
+# Measures how many events per second the event service can deliver.  Runs an
+# HTTP sink, subscribes it to the BMC a number of times, then has bmcweb
+# (built with -Devent-load-generator=enabled) inject synthetic events at the
+# given rate.  Reports delivery latency percentiles, and events missing or
+# received more than once per subscription, next to the delivery, retry and
+# CPU figures bmcweb gives for the run.
+#
+# Latencies compare the BMC clock, when the event was sent, with this
+# machine's, when it arrived, so they are only meaningful with the sink
+# running on the BMC itself, or with the two clocks in sync.
+
+import argparse
+import json
+import ssl
+import statistics
+import threading
+import time
+import urllib.request
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--host", help="Host to connect to", default="127.0.0.1")
+parser.add_argument("--port", help="Port to connect to", type=int, default=443)
+parser.add_argument("--username", help="Username", default="root")
+parser.add_argument("--password", help="Password", default="0penBmc")
+parser.add_argument(
+    "--sink-host",
+    help="Address of this machine, as seen from the BMC",
+    default="127.0.0.1",
+)
+parser.add_argument(
+    "--sink-port", help="Port for the event sink", type=int, default=8099
+)
+parser.add_argument(
+    "--subscribers", help="Subscriptions to create", type=int, default=4
+)
+parser.add_argument(
+    "--rate", help="Events per second to inject", type=int, default=100
+)
+parser.add_argument(
+    "--count", help="Events to inject", type=int, default=1000
+)
+parser.add_argument(
+    "--payload", help="Padding bytes per event", type=int, default=256
+)
+parser.add_argument(
+    "--path",
+    help="Path events take through the event service",
+    choices=["SendEvent", "EventLog"],
+    default="SendEvent",
+)
+parser.add_argument(
+    "--drain",
+    help="Seconds to wait for stragglers once all events are sent",
+    type=float,
+    default=10,
+)
+
+args = parser.parse_args()
+
+context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+context.check_hostname = False
+context.verify_mode = ssl.CERT_NONE
+
+password_manager = urllib.request.HTTPPasswordMgrWithDefaultRealm()
+base = f"https://{args.host}:{args.port}"
+password_manager.add_password(None, base, args.username, args.password)
+opener = urllib.request.build_opener(
+    urllib.request.HTTPSHandler(context=context),
+    urllib.request.HTTPBasicAuthHandler(password_manager),
+)
+
+
+def call(method, path, body=None):
+    data = json.dumps(body).encode() if body is not None else None
+    request = urllib.request.Request(base + path, data=data, method=method)
+    request.add_header("Content-Type", "application/json")
+    with opener.open(request) as response:
+        text = response.read()
+        location = response.headers.get("Location")
+    return (json.loads(text) if text else None), location
+
+
+lock = threading.Lock()
+# Per subscriber, the sequence numbers received, and the latencies in ms
+received = {}
+latencies = []
+
+
+class Sink(BaseHTTPRequestHandler):
+    def do_POST(self):
+        arrived_us = time.time_ns() // 1000
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        self.send_response(200)
+        self.end_headers()
+        subscriber = self.path
+        try:
+            events = json.loads(body).get("Events", [])
+        except ValueError:
+            return
+        with lock:
+            for event in events:
+                message_args = event.get("MessageArgs", [])
+                if not message_args:
+                    continue
+                fields = str(message_args[0]).split(":")
+                if len(fields) != 3 or fields[0] != "LoadTest":
+                    continue
+                sequence, sent_us = int(fields[1]), int(fields[2])
+                received.setdefault(subscriber, []).append(sequence)
+                latencies.append((arrived_us - sent_us) / 1000)
+
+    def log_message(self, format, *args):
+        pass
+
+
+sink = ThreadingHTTPServer(("", args.sink_port), Sink)
+threading.Thread(target=sink.serve_forever, daemon=True).start()
+
+subscriptions = []
+try:
+    for i in range(args.subscribers):
+        _, location = call(
+            "POST",
+            "/redfish/v1/EventService/Subscriptions",
+            {
+                "Destination": f"http://{args.sink_host}:{args.sink_port}/{i}",
+                "Protocol": "Redfish",
+                "EventFormatType": "Event",
+            },
+        )
+        subscriptions.append(location)
+
+    call(
+        "POST",
+        "/debug/v1/events/load",
+        {
+            "EventsPerSecond": args.rate,
+            "Count": args.count,
+            "PayloadBytes": args.payload,
+            "Path": args.path,
+        },
+    )
+    while True:
+        time.sleep(0.5)
+        status, _ = call("GET", "/debug/v1/events/load")
+        if not status["Running"]:
+            break
+    time.sleep(args.drain)
+    status, _ = call("GET", "/debug/v1/events/load")
+finally:
+    for location in subscriptions:
+        if location:
+            call("DELETE", location)
+    sink.shutdown()
+
+sent = status["EventsSent"]
+print(
+    f"sent {sent} events of {args.payload} bytes to {args.subscribers}"
+    f" subscribers in {status['ElapsedSeconds']:.1f} s"
+    f" ({status['AchievedEventsPerSecond']:.1f}/s of {args.rate}/s asked)"
+)
+print(
+    f"bmcweb: {status['CpuPercent']:.1f}% CPU,"
+    f" {status['Delivered']} delivered, {status['Failed']} failed,"
+    f" {status['Dropped']} dropped, {status['Retries']} retries"
+)
+missing = 0
+duplicates = 0
+for i in range(args.subscribers):
+    sequences = received.get(f"/{i}", [])
+    unique = set(sequences)
+    missing += sent - len(unique)
+    duplicates += len(sequences) - len(unique)
+print(f"sink: {missing} missing, {duplicates} received more than once")
+if len(latencies) >= 2:
+    quantiles = statistics.quantiles(latencies, n=100)
+    print(
+        f"latency: p50 {quantiles[49]:7.1f} ms  p90 {quantiles[89]:7.1f} ms"
+        f"  p99 {quantiles[98]:7.1f} ms  max {max(latencies):7.1f} ms"
+    )
+else:
+    print("Not enough events received to report latencies")
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+# Measures how much file-heavy requests hold up everything else.  A set of
+# workers repeatedly fetch a large file (a web UI asset by default), while
+# the latency of a cheap request, the service root, is sampled alongside.
+# Run once with --workers 0 for the baseline, then with workers; the
+# difference in the percentiles is the time spent waiting behind file I/O.
+
+import argparse
+import ssl
+import statistics
+import threading
+import time
+import urllib.request
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--host", help="Host to connect to", default="127.0.0.1")
+parser.add_argument("--port", help="Port to connect to", type=int, default=443)
+parser.add_argument("--username", help="Username", default="root")
+parser.add_argument("--password", help="Password", default="0penBmc")
+parser.add_argument(
+    "--file-url",
+    help="File-backed URL fetched by the workers",
+    default="/js/app.js.gz",
+)
+parser.add_argument(
+    "--workers", help="Concurrent file fetches", type=int, default=4
+)
+parser.add_argument(
+    "--count", help="Service root requests to time", type=int, default=200
+)
+
+args = parser.parse_args()
+
+context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+context.check_hostname = False
+context.verify_mode = ssl.CERT_NONE
+
+password_manager = urllib.request.HTTPPasswordMgrWithDefaultRealm()
+base = f"https://{args.host}:{args.port}"
+password_manager.add_password(None, base, args.username, args.password)
+opener = urllib.request.build_opener(
+    urllib.request.HTTPSHandler(context=context),
+    urllib.request.HTTPBasicAuthHandler(password_manager),
+)
+
+stop = threading.Event()
+file_fetches = 0
+file_failures = 0
+lock = threading.Lock()
+
+
+def fetch_files():
+    global file_fetches, file_failures
+    while not stop.is_set():
+        try:
+            with opener.open(base + args.file_url) as response:
+                response.read()
+            with lock:
+                file_fetches += 1
+        except OSError:
+            with lock:
+                file_failures += 1
+
+
+workers = [
+    threading.Thread(target=fetch_files, daemon=True)
+    for _ in range(args.workers)
+]
+for worker in workers:
+    worker.start()
+
+latencies = []
+failures = 0
+start = time.monotonic()
+for _ in range(args.count):
+    request_start = time.monotonic()
+    try:
+        with opener.open(base + "/redfish/v1/") as response:
+            response.read()
+        latencies.append((time.monotonic() - request_start) * 1000)
+    except OSError as e:
+        failures += 1
+        if failures == 1:
+            print(f"service root request failed: {e}")
+elapsed = time.monotonic() - start
+
+stop.set()
+for worker in workers:
+    worker.join()
+
+if len(latencies) < 2:
+    print("Not enough successful requests to report on")
+else:
+    quantiles = statistics.quantiles(latencies, n=100)
+    print(
+        f"service root: p50 {quantiles[49]:7.1f} ms"
+        f"  p99 {quantiles[98]:7.1f} ms  max {max(latencies):7.1f} ms"
+    )
+    print(
+        f"file fetches: {file_fetches / elapsed:7.1f}/s"
+        f" with {args.workers} workers"
+    )
+if failures or file_failures:
+    print(f"failures: {failures} service root, {file_failures} file")
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+# Measures full TLS handshake throughput against bmcweb for ECDSA and RSA
+# certificates.  bmcweb serves both when its certificate is RSA and an ECDSA
+# pair is present, and OpenSSL picks one per ClientHello; restricting the
+# client to ECDSA or RSA cipher suites (TLS 1.2) selects which one is used.
+#
+# Run on the BMC itself with --pid to also report the CPU time bmcweb spent,
+# which is the number that matters on BMC class cores.
+
+import argparse
+import os
+import socket
+import ssl
+import time
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--host", help="Host to connect to", default="127.0.0.1")
+parser.add_argument("--port", help="Port to connect to", type=int, default=443)
+parser.add_argument(
+    "--count", help="Handshakes per key type", type=int, default=200
+)
+parser.add_argument(
+    "--pid", help="bmcweb pid, to report server CPU time", type=int
+)
+
+args = parser.parse_args()
+
+key_types = {
+    "ECDSA": "ECDHE-ECDSA-AES128-GCM-SHA256",
+    "RSA": "ECDHE-RSA-AES128-GCM-SHA256",
+}
+
+
+def server_cpu_seconds():
+    if args.pid is None:
+        return None
+    with open(f"/proc/{args.pid}/stat") as stat:
+        fields = stat.read().rsplit(")", 1)[1].split()
+    # utime and stime, fields 14 and 15 of /proc/<pid>/stat
+    ticks = int(fields[11]) + int(fields[12])
+    return ticks / os.sysconf("SC_CLK_TCK")
+
+
+def make_context(ciphers):
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    context.check_hostname = False
+    context.verify_mode = ssl.CERT_NONE
+    context.minimum_version = ssl.TLSVersion.TLSv1_2
+    context.maximum_version = ssl.TLSVersion.TLSv1_2
+    context.set_ciphers(ciphers)
+    # Every handshake has to be a full one for the numbers to mean anything
+    context.options |= ssl.OP_NO_TICKET
+    return context
+
+
+def run(name, ciphers):
+    context = make_context(ciphers)
+    cpu_start = server_cpu_seconds()
+    failures = 0
+    start = time.monotonic()
+    for _ in range(args.count):
+        try:
+            with socket.create_connection((args.host, args.port)) as sock:
+                with context.wrap_socket(sock) as tls:
+                    tls.do_handshake()
+        except (OSError, ssl.SSLError) as e:
+            failures += 1
+            if failures == 1:
+                print(f"{name}: handshake failed: {e}")
+    elapsed = time.monotonic() - start
+    cpu_end = server_cpu_seconds()
+
+    done = args.count - failures
+    line = f"{name:<6} {done / elapsed:8.1f} handshakes/s"
+    if cpu_start is not None and cpu_end is not None and done > 0:
+        cpu_ms = (cpu_end - cpu_start) * 1000 / done
+        line += f" {cpu_ms:8.2f} ms server CPU/handshake"
+    if failures:
+        line += f" ({failures} failed)"
+    print(line)
+
+
+for key_type, cipher in key_types.items():
+    run(key_type, cipher)
@@ -0,0 +1,115 @@
+#include "memory_accounting.hpp"
+
+#ifdef BMCWEB_ENABLE_MEMORY_ACCOUNTING
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replacements for the global, non aligned, operator new and delete, which
+// put a header in front of each allocation saying which account it was
+// charged to and how large it was.  Over-aligned allocations go to the
+// aligned forms, which are left alone and so aren't accounted.
+
+namespace
+{
+
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) Header
+{
+    bmcweb::memory::Account* account;
+    size_t size;
+};
+
+void* allocate(size_t size) noexcept
+{
+    void* block = std::malloc(sizeof(Header) + size);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+    Header* header = static_cast<Header*>(block);
+    header->account = bmcweb::memory::onAllocate(size);
+    header->size = size;
+    return header + 1;
+}
+
+void* allocateOrThrow(size_t size)
+{
+    void* ptr = allocate(size);
+    while (ptr == nullptr)
+    {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+        ptr = allocate(size);
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    Header* header = static_cast<Header*>(ptr) - 1;
+    bmcweb::memory::onFree(header->account, header->size);
+    std::free(header);
+}
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    return allocateOrThrow(size);
+}
+
+void* operator new[](size_t size)
+{
+    return allocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t /*size*/) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t& /*tag*/) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t& /*tag*/) noexcept
+{
+    deallocate(ptr);
+}
+
+#endif
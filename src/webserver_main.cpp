@@ -25,6 +25,8 @@
 #include <sdbusplus/server.hpp>
 #include <security_headers.hpp>
 #include <ssl_key_handler.hpp>
+#include <stats_routes.hpp>
+#include <trace_routes.hpp>
 #include <user_monitor.hpp>
 #include <vm_websocket.hpp>
 #include <webassets.hpp>
@@ -37,26 +39,35 @@ constexpr int defaultPort = 18080;
 
 inline void setupSocket(crow::App& app)
 {
-    int listenFd = sd_listen_fds(0);
-    if (1 == listenFd)
+    int listenFds = sd_listen_fds(0);
+    if (listenFds > 0)
     {
         BMCWEB_LOG_INFO << "attempting systemd socket activation";
-        if (sd_is_socket_inet(SD_LISTEN_FDS_START, AF_UNSPEC, SOCK_STREAM, 1,
-                              0) != 0)
+    }
+    bool haveInetSocket = false;
+    for (int fd = SD_LISTEN_FDS_START; fd < SD_LISTEN_FDS_START + listenFds;
+         fd++)
+    {
+        if (!haveInetSocket &&
+            sd_is_socket_inet(fd, AF_UNSPEC, SOCK_STREAM, 1, 0) > 0)
         {
-            BMCWEB_LOG_INFO << "Starting webserver on socket handle: "
-                            << SD_LISTEN_FDS_START;
-            app.socket(SD_LISTEN_FDS_START);
+            BMCWEB_LOG_INFO << "Starting webserver on socket handle: " << fd;
+            app.socket(fd);
+            haveInetSocket = true;
+            continue;
         }
-        else
+#ifdef BMCWEB_ENABLE_UNIX_SOCKET
+        if (sd_is_socket_unix(fd, SOCK_STREAM, 1, nullptr, 0) > 0)
         {
-            BMCWEB_LOG_INFO
-                << "bad incoming socket, starting webserver on port: "
-                << defaultPort;
-            app.port(defaultPort);
+            BMCWEB_LOG_INFO << "Serving local clients on socket handle: "
+                            << fd;
+            app.localSocket(fd);
+            continue;
         }
+#endif
+        BMCWEB_LOG_INFO << "Ignoring bad incoming socket handle: " << fd;
     }
-    else
+    if (!haveInetSocket)
     {
         BMCWEB_LOG_INFO << "Starting webserver on"
                         << "port: " << defaultPort;
@@ -159,6 +170,12 @@ static int run()
     }
 
     crow::login_routes::requestRoutes(app);
+    crow::stats_routes::requestRoutes(app);
+
+    if constexpr (bmcwebRequestTraceSpans != 0)
+    {
+        crow::trace_routes::requestRoutes(app);
+    }
 
     setupSocket(app);
 
@@ -0,0 +1,96 @@
+#include "cancellation.hpp"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(CancellationToken, StartsNotCancelled)
+{
+    CancellationToken token;
+    EXPECT_FALSE(token.isCancelled());
+    token.cancel();
+    EXPECT_TRUE(token.isCancelled());
+    token.cancel();
+    EXPECT_TRUE(token.isCancelled());
+}
+
+TEST(CancellationToken, DeadlineCancels)
+{
+    CancellationToken token;
+    EXPECT_FALSE(token.hasDeadline());
+    EXPECT_EQ(token.timeLeft(), std::nullopt);
+
+    token.setDeadline(CancellationToken::Clock::now() +
+                      std::chrono::hours(1));
+    EXPECT_TRUE(token.hasDeadline());
+    EXPECT_FALSE(token.deadlineExceeded());
+    EXPECT_FALSE(token.isCancelled());
+    std::optional<CancellationToken::Clock::duration> timeLeft =
+        token.timeLeft();
+    ASSERT_NE(timeLeft, std::nullopt);
+    EXPECT_GT(*timeLeft, std::chrono::minutes(59));
+
+    token.setDeadline(CancellationToken::Clock::now() -
+                      std::chrono::seconds(1));
+    EXPECT_TRUE(token.deadlineExceeded());
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_EQ(token.timeLeft(), CancellationToken::Clock::duration::zero());
+
+    EXPECT_FALSE(token.workSkipped());
+    token.markWorkSkipped();
+    EXPECT_TRUE(token.workSkipped());
+}
+
+TEST(CancellationToken, KeepsLongestRetryAfter)
+{
+    CancellationToken token;
+    EXPECT_FALSE(token.serviceUnavailable());
+
+    token.markServiceUnavailable(std::chrono::seconds(5));
+    token.markServiceUnavailable(std::chrono::seconds(20));
+    token.markServiceUnavailable(std::chrono::seconds(10));
+    ASSERT_TRUE(token.serviceUnavailable());
+    EXPECT_EQ(*token.serviceUnavailable(), std::chrono::seconds(20));
+    // Unavailable isn't cancelled; the response still goes out
+    EXPECT_FALSE(token.isCancelled());
+}
+
+TEST(CancellationScope, NestsAndRestores)
+{
+    EXPECT_EQ(CancellationScope::current(), nullptr);
+
+    auto outer = std::make_shared<CancellationToken>();
+    auto inner = std::make_shared<CancellationToken>();
+    {
+        CancellationScope outerScope(outer);
+        EXPECT_EQ(CancellationScope::current(), outer);
+        {
+            CancellationScope innerScope(inner);
+            EXPECT_EQ(CancellationScope::current(), inner);
+        }
+        EXPECT_EQ(CancellationScope::current(), outer);
+        {
+            // Work that isn't for any particular request
+            CancellationScope noScope(nullptr);
+            EXPECT_EQ(CancellationScope::current(), nullptr);
+        }
+        EXPECT_EQ(CancellationScope::current(), outer);
+    }
+    EXPECT_EQ(CancellationScope::current(), nullptr);
+    // The scopes don't keep the tokens alive
+    EXPECT_EQ(outer.use_count(), 1);
+    EXPECT_EQ(inner.use_count(), 1);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,62 @@
+#include "common_headers.hpp"
+#include "security_headers.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+TEST(CommonHeaders, SecurityHeaderBlockHasEveryHeader)
+{
+    const std::string& block = getSecurityHeaderBlock();
+    for (const auto& [name, value] : securityHeaders)
+    {
+        std::string line(name);
+        line += ": ";
+        line += value;
+        line += "\r\n";
+        EXPECT_NE(block.find(line), std::string::npos) << name;
+    }
+    EXPECT_TRUE(block.ends_with("\r\n"));
+    EXPECT_FALSE(block.ends_with("\r\n\r\n"));
+}
+
+TEST(CommonHeaders, BlockStartsWithDate)
+{
+    CommonHeaders headers;
+    std::shared_ptr<const std::string> block = headers.get();
+    ASSERT_NE(block, nullptr);
+
+    EXPECT_TRUE(block->starts_with("Date: "));
+    // "Date: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+    size_t dateEnd = block->find("\r\n");
+    ASSERT_EQ(dateEnd, 35U);
+    EXPECT_EQ(block->substr(dateEnd - 4, 4), " GMT");
+    EXPECT_EQ(block->substr(dateEnd + 2), getSecurityHeaderBlock());
+}
+
+TEST(CommonHeaders, BlockIsSharedWithinASecond)
+{
+    CommonHeaders headers;
+    std::shared_ptr<const std::string> first = headers.get();
+    std::shared_ptr<const std::string> second = headers.get();
+    // Unless the second happened to roll over between the two calls
+    if (first != second)
+    {
+        second = headers.get();
+        first = headers.get();
+    }
+    EXPECT_EQ(first, second);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,119 @@
+#include "destination_health.hpp"
+
+#include <chrono>
+#include <random>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+TEST(RetryBackoff, NoIntervalMeansNoWait)
+{
+    std::minstd_rand gen(1);
+    EXPECT_EQ(retryBackoff(seconds(0), seconds(300), 1, 0, gen),
+              milliseconds(0));
+    EXPECT_EQ(retryBackoff(seconds(0), seconds(300), 5, 3, gen),
+              milliseconds(0));
+}
+
+TEST(RetryBackoff, DoublesPerRetryWithJitter)
+{
+    std::minstd_rand gen(1);
+    for (int i = 0; i < 100; i++)
+    {
+        milliseconds first = retryBackoff(seconds(10), seconds(300), 1, 0, gen);
+        EXPECT_GE(first, seconds(10));
+        EXPECT_LE(first, seconds(15));
+
+        milliseconds third = retryBackoff(seconds(10), seconds(300), 3, 0, gen);
+        EXPECT_GE(third, seconds(40));
+        EXPECT_LE(third, seconds(60));
+    }
+}
+
+TEST(RetryBackoff, JitterSpreadsRetries)
+{
+    std::minstd_rand gen(1);
+    milliseconds first = retryBackoff(seconds(10), seconds(300), 1, 0, gen);
+    bool differs = false;
+    for (int i = 0; i < 100 && !differs; i++)
+    {
+        differs = retryBackoff(seconds(10), seconds(300), 1, 0, gen) != first;
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(RetryBackoff, Capped)
+{
+    std::minstd_rand gen(1);
+    milliseconds delay = retryBackoff(seconds(10), seconds(60), 20, 0, gen);
+    EXPECT_GE(delay, seconds(60));
+    EXPECT_LE(delay, seconds(90));
+
+    // A cap below the interval doesn't shorten it
+    delay = retryBackoff(seconds(30), seconds(5), 1, 0, gen);
+    EXPECT_GE(delay, seconds(30));
+}
+
+TEST(RetryBackoff, FailingDestinationsBackOffFurther)
+{
+    std::minstd_rand gen(1);
+    milliseconds delay = retryBackoff(seconds(5), seconds(300), 1, 2, gen);
+    EXPECT_GE(delay, seconds(20));
+    EXPECT_LE(delay, seconds(30));
+
+    // The penalty stops growing after a while
+    delay = retryBackoff(seconds(5), seconds(300), 1, 50, gen);
+    EXPECT_GE(delay, seconds(80));
+    EXPECT_LE(delay, seconds(120));
+}
+
+TEST(DestinationHealth, ScoreFallsAndRecovers)
+{
+    DestinationHealth health;
+    DestinationHealth::Clock::time_point now = DestinationHealth::Clock::now();
+    EXPECT_EQ(health.score, DestinationHealth::fullScore);
+
+    health.recordFailed(now, seconds(0));
+    health.recordFailed(now, seconds(0));
+    EXPECT_LT(health.score, 60);
+    EXPECT_EQ(health.failureStreak, 2);
+    EXPECT_EQ(health.failed, 2);
+
+    health.recordDelivered(now);
+    EXPECT_EQ(health.failureStreak, 0);
+    EXPECT_EQ(health.delivered, 1);
+    uint32_t afterOne = health.score;
+    health.recordDelivered(now);
+    EXPECT_GT(health.score, afterOne);
+}
+
+TEST(DestinationHealth, HoldsOffAfterRepeatedFailures)
+{
+    DestinationHealth health;
+    DestinationHealth::Clock::time_point now = DestinationHealth::Clock::now();
+
+    health.recordFailed(now, seconds(30));
+    health.recordFailed(now, seconds(30));
+    EXPECT_FALSE(health.isHoldingOff(now));
+
+    health.recordFailed(now, seconds(30));
+    EXPECT_TRUE(health.isHoldingOff(now));
+    EXPECT_TRUE(health.isHoldingOff(now + seconds(29)));
+    EXPECT_FALSE(health.isHoldingOff(now + seconds(30)));
+
+    health.recordDelivered(now);
+    EXPECT_FALSE(health.isHoldingOff(now));
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,58 @@
+#include "http_request.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/verb.hpp>
+
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+Request makeRequest()
+{
+    std::error_code ec;
+    Request::Message message(boost::beast::http::verb::patch,
+                             "/redfish/v1/Systems/system?$select=Id", 11,
+                             std::string(4096, 'x'));
+    message.set(boost::beast::http::field::if_match, "\"etag\"");
+    Request req(std::move(message), ec);
+    EXPECT_FALSE(ec);
+    return req;
+}
+
+TEST(HttpRequest, CopiesShareTheBody)
+{
+    Request req = makeRequest();
+    Request copy(req);
+    EXPECT_EQ(&copy.body(), &req.body());
+    EXPECT_EQ(copy.url, "/redfish/v1/Systems/system");
+    EXPECT_EQ(copy.urlView.encoded_query(), "$select=Id");
+}
+
+TEST(HttpRequest, ChangingACopyLeavesTheOriginal)
+{
+    Request req = makeRequest();
+    Request copy(req);
+    copy.clearHeader(boost::beast::http::field::if_match);
+    EXPECT_EQ(copy.getHeaderValue(boost::beast::http::field::if_match), "");
+    EXPECT_EQ(req.getHeaderValue(boost::beast::http::field::if_match),
+              "\"etag\"");
+    EXPECT_NE(&copy.body(), &req.body());
+    EXPECT_EQ(copy.body(), req.body());
+
+    ASSERT_TRUE(copy.target("/redfish/v1/Managers/bmc"));
+    EXPECT_EQ(copy.url, "/redfish/v1/Managers/bmc");
+    EXPECT_EQ(req.url, "/redfish/v1/Systems/system");
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,127 @@
+#include "rate_limiter.hpp"
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/address_v4.hpp>
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using Clock = RateLimiter::Clock;
+
+const boost::asio::ip::address address1 =
+    boost::asio::ip::make_address("10.0.0.1");
+const boost::asio::ip::address address2 =
+    boost::asio::ip::make_address("10.0.0.2");
+
+TEST(RateLimiter, BurstThenRate)
+{
+    RateLimiter limiter({2, 3}, {0, 0});
+    Clock::time_point now = Clock::now();
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(limiter.tryAcquire("", address1, RouteCost::Normal, now),
+                  std::nullopt);
+    }
+    std::optional<std::chrono::seconds> retryAfter =
+        limiter.tryAcquire("", address1, RouteCost::Normal, now);
+    ASSERT_NE(retryAfter, std::nullopt);
+    EXPECT_EQ(*retryAfter, std::chrono::seconds(1));
+    EXPECT_EQ(limiter.getStats().throttledByAddress, 1);
+
+    // Another address has its own budget
+    EXPECT_EQ(limiter.tryAcquire("", address2, RouteCost::Normal, now),
+              std::nullopt);
+
+    // Tokens come back at the configured rate
+    now += std::chrono::milliseconds(500);
+    EXPECT_EQ(limiter.tryAcquire("", address1, RouteCost::Normal, now),
+              std::nullopt);
+    EXPECT_NE(limiter.tryAcquire("", address1, RouteCost::Normal, now),
+              std::nullopt);
+}
+
+TEST(RateLimiter, UserLimitedAcrossAddresses)
+{
+    RateLimiter limiter({1, 2}, {0, 0});
+    Clock::time_point now = Clock::now();
+    EXPECT_EQ(limiter.tryAcquire("admin", address1, RouteCost::Normal, now),
+              std::nullopt);
+    EXPECT_EQ(limiter.tryAcquire("admin", address2, RouteCost::Normal, now),
+              std::nullopt);
+    EXPECT_NE(limiter.tryAcquire("admin", address2, RouteCost::Normal, now),
+              std::nullopt);
+    EXPECT_EQ(limiter.getStats().throttledByUser, 1);
+
+    // A throttled request takes no tokens, so another user from the same
+    // address still has one left
+    EXPECT_EQ(limiter.tryAcquire("operator", address2, RouteCost::Normal, now),
+              std::nullopt);
+}
+
+TEST(RateLimiter, ExpensiveRoutesHaveTheirOwnBudget)
+{
+    RateLimiter limiter({10, 10}, {1, 1});
+    Clock::time_point now = Clock::now();
+    EXPECT_EQ(limiter.tryAcquire("", address1, RouteCost::Expensive, now),
+              std::nullopt);
+    std::optional<std::chrono::seconds> retryAfter =
+        limiter.tryAcquire("", address1, RouteCost::Expensive, now);
+    ASSERT_NE(retryAfter, std::nullopt);
+    EXPECT_EQ(*retryAfter, std::chrono::seconds(1));
+    EXPECT_EQ(limiter.getStats().throttledExpensive, 1);
+
+    EXPECT_EQ(limiter.tryAcquire("", address1, RouteCost::Normal, now),
+              std::nullopt);
+}
+
+TEST(RateLimiter, DisabledLimitsNeverThrottle)
+{
+    RateLimiter limiter({0, 0}, {0, 0});
+    Clock::time_point now = Clock::now();
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(limiter.tryAcquire("admin", address1, RouteCost::Expensive,
+                                     now),
+                  std::nullopt);
+    }
+    EXPECT_EQ(limiter.clientCount(), 0);
+}
+
+TEST(RateLimiter, IdleClientsAreForgotten)
+{
+    RateLimiter limiter({1, 1}, {0, 0});
+    Clock::time_point now = Clock::now();
+    for (unsigned int i = 0; i < RateLimiter::maxClients; i++)
+    {
+        boost::asio::ip::address_v4 address(0x0a000000U + i);
+        EXPECT_EQ(limiter.tryAcquire("", address, RouteCost::Normal, now),
+                  std::nullopt);
+    }
+    EXPECT_EQ(limiter.clientCount(), RateLimiter::maxClients);
+
+    // With every client active, new ones are let through untracked
+    boost::asio::ip::address_v4 other(0x0b000000U);
+    EXPECT_EQ(limiter.tryAcquire("", other, RouteCost::Normal, now),
+              std::nullopt);
+    EXPECT_EQ(limiter.getStats().untracked, 1);
+
+    // Once the others have been idle long enough, they make room
+    now += std::chrono::seconds(10);
+    EXPECT_EQ(limiter.tryAcquire("", other, RouteCost::Normal, now),
+              std::nullopt);
+    EXPECT_EQ(limiter.clientCount(), 1);
+}
+
+} // namespace
+} // namespace crow
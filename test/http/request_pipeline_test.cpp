@@ -0,0 +1,139 @@
+#include "request_pipeline.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+struct Entry
+{
+    bool keepAlive = true;
+    bool concurrent = true;
+    bool complete = false;
+};
+
+std::shared_ptr<Entry> get()
+{
+    return std::make_shared<Entry>();
+}
+
+std::shared_ptr<Entry> post()
+{
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    entry->concurrent = false;
+    return entry;
+}
+
+TEST(RequestPipeline, ReadsUpToDepth)
+{
+    RequestPipeline<Entry> pipeline(2);
+    EXPECT_TRUE(pipeline.canReadNext());
+    EXPECT_TRUE(pipeline.push(get()));
+    EXPECT_TRUE(pipeline.canReadNext());
+    EXPECT_TRUE(pipeline.push(get()));
+    EXPECT_FALSE(pipeline.canReadNext());
+}
+
+TEST(RequestPipeline, StopsReadingAfterLastRequest)
+{
+    RequestPipeline<Entry> pipeline(4);
+    std::shared_ptr<Entry> last = get();
+    last->keepAlive = false;
+    EXPECT_TRUE(pipeline.push(last));
+    EXPECT_FALSE(pipeline.canReadNext());
+}
+
+TEST(RequestPipeline, WritesInRequestOrder)
+{
+    RequestPipeline<Entry> pipeline(4);
+    std::shared_ptr<Entry> first = get();
+    std::shared_ptr<Entry> second = get();
+    pipeline.push(first);
+    pipeline.push(second);
+    EXPECT_EQ(pipeline.nextToWrite(), nullptr);
+
+    // The second finishing first still waits for the first
+    second->complete = true;
+    EXPECT_EQ(pipeline.nextToWrite(), nullptr);
+
+    first->complete = true;
+    EXPECT_EQ(pipeline.nextToWrite(), first.get());
+    EXPECT_EQ(pipeline.popWritten(), nullptr);
+    EXPECT_EQ(pipeline.nextToWrite(), second.get());
+    EXPECT_EQ(pipeline.popWritten(), nullptr);
+    EXPECT_EQ(pipeline.size(), 0U);
+}
+
+TEST(RequestPipeline, HoldsWriteUntilAheadAnswered)
+{
+    RequestPipeline<Entry> pipeline(4);
+    std::shared_ptr<Entry> first = get();
+    std::shared_ptr<Entry> second = get();
+    std::shared_ptr<Entry> write = post();
+    EXPECT_TRUE(pipeline.push(first));
+    EXPECT_TRUE(pipeline.push(second));
+    EXPECT_FALSE(pipeline.push(write));
+    // Nothing after it is read until it is handled
+    EXPECT_FALSE(pipeline.canReadNext());
+
+    first->complete = true;
+    EXPECT_EQ(pipeline.popWritten(), nullptr);
+    second->complete = true;
+    EXPECT_EQ(pipeline.popWritten(), write);
+    // Nor while it is handled
+    EXPECT_FALSE(pipeline.canReadNext());
+
+    write->complete = true;
+    EXPECT_EQ(pipeline.popWritten(), nullptr);
+    EXPECT_TRUE(pipeline.canReadNext());
+}
+
+TEST(RequestPipeline, WriteAloneRunsStraightAway)
+{
+    RequestPipeline<Entry> pipeline(4);
+    EXPECT_TRUE(pipeline.push(post()));
+    // Nothing is handled alongside it
+    EXPECT_FALSE(pipeline.canReadNext());
+}
+
+TEST(RequestPipeline, EndOfStreamWithNothingPending)
+{
+    RequestPipeline<Entry> pipeline(4);
+    EXPECT_TRUE(pipeline.endOfStream());
+    EXPECT_TRUE(pipeline.finished());
+    EXPECT_FALSE(pipeline.canReadNext());
+}
+
+TEST(RequestPipeline, EndOfStreamAnswersPending)
+{
+    RequestPipeline<Entry> pipeline(4);
+    std::shared_ptr<Entry> first = get();
+    std::shared_ptr<Entry> write = post();
+    pipeline.push(first);
+    EXPECT_FALSE(pipeline.push(write));
+
+    EXPECT_FALSE(pipeline.endOfStream());
+    EXPECT_TRUE(pipeline.isReadClosed());
+    EXPECT_FALSE(pipeline.finished());
+    EXPECT_FALSE(pipeline.canReadNext());
+
+    // The held request is still handled, and both are written
+    first->complete = true;
+    EXPECT_EQ(pipeline.nextToWrite(), first.get());
+    EXPECT_EQ(pipeline.popWritten(), write);
+    EXPECT_FALSE(pipeline.finished());
+    write->complete = true;
+    EXPECT_EQ(pipeline.nextToWrite(), write.get());
+    EXPECT_EQ(pipeline.popWritten(), nullptr);
+    EXPECT_TRUE(pipeline.finished());
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,83 @@
+#include "tls_handshake_limiter.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+using Clock = TlsHandshakeLimiter::Clock;
+
+TEST(TlsHandshakeLimiter, StartsUpToLimit)
+{
+    TlsHandshakeLimiter limiter(2);
+    std::vector<int> started;
+    for (int i = 0; i < 3; i++)
+    {
+        limiter.acquire(
+            [&started, i](Clock::time_point) { started.push_back(i); });
+    }
+    EXPECT_EQ(started, (std::vector<int>{0, 1}));
+    EXPECT_EQ(limiter.activeCount(), 2U);
+    EXPECT_EQ(limiter.queueDepth(), 1U);
+    EXPECT_EQ(limiter.getStats().started, 2U);
+    EXPECT_EQ(limiter.getStats().deferred, 1U);
+    EXPECT_EQ(limiter.getStats().maxQueueDepth, 1U);
+}
+
+TEST(TlsHandshakeLimiter, ReleaseStartsNextInArrivalOrder)
+{
+    TlsHandshakeLimiter limiter(1);
+    std::vector<int> started;
+    Clock::time_point firstStart;
+    limiter.acquire([&started, &firstStart](Clock::time_point startedAt) {
+        started.push_back(0);
+        firstStart = startedAt;
+    });
+    for (int i = 1; i < 3; i++)
+    {
+        limiter.acquire(
+            [&started, i](Clock::time_point) { started.push_back(i); });
+    }
+    EXPECT_EQ(started, (std::vector<int>{0}));
+
+    limiter.release(firstStart, true);
+    EXPECT_EQ(started, (std::vector<int>{0, 1}));
+    EXPECT_EQ(limiter.activeCount(), 1U);
+    EXPECT_EQ(limiter.queueDepth(), 1U);
+
+    limiter.release(Clock::now(), false);
+    EXPECT_EQ(started, (std::vector<int>{0, 1, 2}));
+    limiter.release(Clock::now(), true);
+    EXPECT_EQ(limiter.activeCount(), 0U);
+    EXPECT_EQ(limiter.queueDepth(), 0U);
+
+    const TlsHandshakeStats& stats = limiter.getStats();
+    EXPECT_EQ(stats.started, 3U);
+    EXPECT_EQ(stats.succeeded, 2U);
+    EXPECT_EQ(stats.failed, 1U);
+    EXPECT_EQ(stats.deferred, 2U);
+    EXPECT_EQ(stats.maxQueueDepth, 2U);
+}
+
+TEST(TlsHandshakeLimiter, ZeroIsUnlimited)
+{
+    TlsHandshakeLimiter limiter(0);
+    int started = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        limiter.acquire([&started](Clock::time_point) { started++; });
+    }
+    EXPECT_EQ(started, 100);
+    EXPECT_EQ(limiter.queueDepth(), 0U);
+    EXPECT_EQ(limiter.getStats().deferred, 0U);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,129 @@
+#include "tracing.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow
+{
+namespace
+{
+
+SpanRecord makeRecord(uint64_t traceId, uint64_t spanId,
+                      uint64_t parentSpanId = 0)
+{
+    SpanRecord record;
+    record.traceId = traceId;
+    record.spanId = spanId;
+    record.parentSpanId = parentSpanId;
+    record.name = "span" + std::to_string(spanId);
+    return record;
+}
+
+TEST(Tracing, SpansNeedAParent)
+{
+    Span span("orphan");
+    EXPECT_FALSE(span.isActive());
+    EXPECT_FALSE(span.context().isValid());
+    EXPECT_EQ(Span::startShared("orphan"), nullptr);
+}
+
+TEST(Tracing, ChildrenOfTheCurrentScope)
+{
+    Span root = Span::startTrace("request");
+    ASSERT_TRUE(root.isActive());
+    TraceContext rootContext = root.context();
+    uint64_t childSpanId = 0;
+    {
+        TraceScope scope(rootContext);
+        Span child("child");
+        ASSERT_TRUE(child.isActive());
+        EXPECT_EQ(child.context().traceId, rootContext.traceId);
+        EXPECT_NE(child.context().spanId, rootContext.spanId);
+        childSpanId = child.context().spanId;
+    }
+    EXPECT_FALSE(TraceScope::current().isValid());
+    root.end();
+    EXPECT_FALSE(root.isActive());
+
+    std::vector<const SpanRecord*> spans =
+        Tracer::getInstance().getSpans(rootContext.traceId);
+    ASSERT_EQ(spans.size(), 2);
+    // Children end, and so are recorded, first
+    EXPECT_EQ(spans[0]->name, "child");
+    EXPECT_EQ(spans[0]->spanId, childSpanId);
+    EXPECT_EQ(spans[0]->parentSpanId, rootContext.spanId);
+    EXPECT_EQ(spans[1]->name, "request");
+    EXPECT_EQ(spans[1]->parentSpanId, 0);
+}
+
+TEST(Tracing, RingKeepsTheNewestSpans)
+{
+    Tracer tracer(2);
+    tracer.record(makeRecord(1, 1));
+    tracer.record(makeRecord(1, 2));
+    tracer.record(makeRecord(2, 3));
+
+    std::vector<const SpanRecord*> spans = tracer.getSpans();
+    ASSERT_EQ(spans.size(), 2);
+    EXPECT_EQ(spans[0]->spanId, 2);
+    EXPECT_EQ(spans[1]->spanId, 3);
+    EXPECT_EQ(tracer.getSpans(2).size(), 1);
+
+    Tracer disabled(0);
+    disabled.record(makeRecord(1, 1));
+    EXPECT_TRUE(disabled.getSpans().empty());
+}
+
+TEST(Tracing, HexIds)
+{
+    EXPECT_EQ(Tracer::hexId(0xabc), "0000000000000abc");
+    EXPECT_EQ(Tracer::parseId("0000000000000abc"), 0xabc);
+    EXPECT_EQ(Tracer::parseId(""), std::nullopt);
+    EXPECT_EQ(Tracer::parseId("xyz"), std::nullopt);
+    EXPECT_EQ(Tracer::parseId("12g"), std::nullopt);
+}
+
+TEST(Tracing, ChromeTraceExport)
+{
+    Tracer tracer(4);
+    SpanRecord record = makeRecord(1, 2, 3);
+    record.attributes.emplace_back("dbus.member", "GetAll");
+    tracer.record(std::move(record));
+
+    nlohmann::json trace = tracer.toChromeTrace();
+    ASSERT_EQ(trace["traceEvents"].size(), 1);
+    const nlohmann::json& event = trace["traceEvents"][0];
+    EXPECT_EQ(event["name"], "span2");
+    EXPECT_EQ(event["ph"], "X");
+    EXPECT_EQ(event["tid"], "0000000000000001");
+    EXPECT_EQ(event["args"]["parent_span_id"], "0000000000000003");
+    EXPECT_EQ(event["args"]["dbus.member"], "GetAll");
+}
+
+TEST(Tracing, OtlpExport)
+{
+    Tracer tracer(4);
+    tracer.record(makeRecord(1, 2));
+    tracer.record(makeRecord(5, 6, 2));
+
+    nlohmann::json trace = tracer.toOtlp(1);
+    const nlohmann::json& spans =
+        trace["resourceSpans"][0]["scopeSpans"][0]["spans"];
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_EQ(spans[0]["traceId"], "00000000000000000000000000000001");
+    EXPECT_EQ(spans[0]["spanId"], "0000000000000002");
+    EXPECT_FALSE(spans[0].contains("parentSpanId"));
+    EXPECT_EQ(spans[0]["kind"], 2);
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,179 @@
+#include "async_file.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace bmcweb
+{
+namespace
+{
+
+class AsyncFileTest : public ::testing::Test
+{
+  protected:
+    AsyncFileTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("async_file_test_" +
+             std::string(::testing::UnitTest::GetInstance()
+                             ->current_test_info()
+                             ->name())))
+    {
+        std::filesystem::create_directory(dir);
+    }
+
+    ~AsyncFileTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    AsyncFileTest(const AsyncFileTest&) = delete;
+    AsyncFileTest(AsyncFileTest&&) = delete;
+    AsyncFileTest& operator=(const AsyncFileTest&) = delete;
+    AsyncFileTest& operator=(AsyncFileTest&&) = delete;
+
+    static std::string bigData()
+    {
+        std::string data;
+        // Spans several chunks, and ends partway through one
+        for (size_t i = 0; data.size() < 3 * async_file::chunkSize + 100; i++)
+        {
+            data += std::to_string(i);
+        }
+        return data;
+    }
+
+    boost::asio::io_context io;
+    std::filesystem::path dir;
+};
+
+TEST_F(AsyncFileTest, WriteThenRead)
+{
+    const std::filesystem::path path = dir / "file";
+    const std::string data = bigData();
+
+    std::optional<boost::system::error_code> writeEc;
+    asyncWriteFile(io, path, std::string(data),
+                   std::filesystem::perms::owner_read |
+                       std::filesystem::perms::owner_write,
+                   [&writeEc](const boost::system::error_code& ec) {
+        writeEc = ec;
+    });
+    // Nothing completes before the io context runs
+    EXPECT_EQ(writeEc, std::nullopt);
+    io.run();
+    ASSERT_NE(writeEc, std::nullopt);
+    EXPECT_FALSE(*writeEc);
+    EXPECT_EQ(std::filesystem::status(path).permissions(),
+              std::filesystem::perms::owner_read |
+                  std::filesystem::perms::owner_write);
+    // Only the file itself is left behind
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir),
+                            std::filesystem::directory_iterator()),
+              1);
+
+    std::optional<boost::system::error_code> readEc;
+    std::string contents;
+    asyncReadFile(io, path, data.size(),
+                  [&readEc, &contents](const boost::system::error_code& ec,
+                                       std::string&& read) {
+        readEc = ec;
+        contents = std::move(read);
+    });
+    EXPECT_EQ(readEc, std::nullopt);
+    io.restart();
+    io.run();
+    ASSERT_NE(readEc, std::nullopt);
+    EXPECT_FALSE(*readEc);
+    EXPECT_EQ(contents, data);
+}
+
+TEST_F(AsyncFileTest, WriteReplacesFile)
+{
+    const std::filesystem::path path = dir / "file";
+    std::ofstream(path) << "old contents that are longer";
+
+    std::optional<boost::system::error_code> writeEc;
+    asyncWriteFile(io, path, "new", std::nullopt,
+                   [&writeEc](const boost::system::error_code& ec) {
+        writeEc = ec;
+    });
+    io.run();
+    ASSERT_NE(writeEc, std::nullopt);
+    EXPECT_FALSE(*writeEc);
+
+    std::ifstream file(path);
+    std::string contents(std::istreambuf_iterator<char>{file}, {});
+    EXPECT_EQ(contents, "new");
+}
+
+TEST_F(AsyncFileTest, ReadErrors)
+{
+    std::optional<boost::system::error_code> missingEc;
+    asyncReadFile(io, dir / "missing", 1024,
+                  [&missingEc](const boost::system::error_code& ec,
+                               std::string&& /*contents*/) {
+        missingEc = ec;
+    });
+
+    const std::filesystem::path path = dir / "file";
+    std::ofstream(path) << bigData();
+    std::optional<boost::system::error_code> tooLargeEc;
+    asyncReadFile(io, path, 1024,
+                  [&tooLargeEc](const boost::system::error_code& ec,
+                                std::string&& /*contents*/) {
+        tooLargeEc = ec;
+    });
+
+    io.run();
+    ASSERT_NE(missingEc, std::nullopt);
+    EXPECT_TRUE(*missingEc);
+    ASSERT_NE(tooLargeEc, std::nullopt);
+    EXPECT_EQ(*tooLargeEc, boost::system::errc::file_too_large);
+}
+
+TEST_F(AsyncFileTest, WriteToMissingDirectoryFails)
+{
+    std::optional<boost::system::error_code> writeEc;
+    asyncWriteFile(io, dir / "missing" / "file", "data", std::nullopt,
+                   [&writeEc](const boost::system::error_code& ec) {
+        writeEc = ec;
+    });
+    io.run();
+    ASSERT_NE(writeEc, std::nullopt);
+    EXPECT_TRUE(*writeEc);
+}
+
+TEST_F(AsyncFileTest, UnfinishedWriteLeavesNothingBehind)
+{
+    const std::filesystem::path path = dir / "file";
+    {
+        boost::asio::io_context unrun;
+        asyncWriteFile(unrun, path, bigData(), std::nullopt,
+                       [](const boost::system::error_code&) {});
+        // Gone before the write gets to run
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(dir));
+}
+
+TEST(IsTemporaryPath, OnlyTemporaryFiles)
+{
+    EXPECT_TRUE(async_file::isTemporaryPath(
+        async_file::temporaryPath("/tmp/file")));
+    EXPECT_FALSE(async_file::isTemporaryPath("/tmp/file"));
+    EXPECT_FALSE(async_file::isTemporaryPath("/tmp/file.json"));
+}
+
+} // namespace
+} // namespace bmcweb
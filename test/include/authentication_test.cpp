@@ -0,0 +1,47 @@
+#include "authentication.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace crow::authentication
+{
+namespace
+{
+
+TEST(CarriesCredentials, NoneWithoutAuthHeaders)
+{
+    boost::beast::http::header<true> header;
+    header.set(boost::beast::http::field::host, "localhost");
+    header.set(boost::beast::http::field::cookie, "theme=dark");
+    EXPECT_FALSE(carriesCredentials(header));
+}
+
+TEST(CarriesCredentials, Authorization)
+{
+    boost::beast::http::header<true> header;
+    header.set(boost::beast::http::field::authorization, "Basic cm9vdDow");
+    EXPECT_TRUE(carriesCredentials(header));
+}
+
+TEST(CarriesCredentials, XAuthToken)
+{
+    boost::beast::http::header<true> header;
+    header.set("X-Auth-Token", "token");
+    EXPECT_TRUE(carriesCredentials(header));
+}
+
+TEST(CarriesCredentials, SessionCookie)
+{
+    boost::beast::http::header<true> header;
+    header.set(boost::beast::http::field::cookie,
+               "theme=dark; SESSION=token; XSRF-TOKEN=xsrf");
+    EXPECT_TRUE(carriesCredentials(header));
+}
+
+} // namespace
+} // namespace crow::authentication
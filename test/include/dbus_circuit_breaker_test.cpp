@@ -0,0 +1,109 @@
+#include "bmcweb_config.h"
+
+#include "dbus_circuit_breaker.hpp"
+
+#include <boost/system/errc.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace bmcweb
+{
+namespace
+{
+
+const boost::system::error_code timedOut =
+    boost::system::errc::make_error_code(boost::system::errc::timed_out);
+
+void timeOut(const std::string& service, size_t times)
+{
+    for (size_t i = 0; i < times; i++)
+    {
+        DbusCircuitBreaker::getInstance().recordResult(service, timedOut);
+    }
+}
+
+TEST(DbusCircuitBreaker, OpensAfterConsecutiveTimeouts)
+{
+    if (bmcwebDbusCircuitBreakerThreshold == 0)
+    {
+        GTEST_SKIP() << "Circuit breaker disabled";
+    }
+    DbusCircuitBreaker& breaker = DbusCircuitBreaker::getInstance();
+    const std::string service = "xyz.openbmc_project.Test.Opens";
+
+    timeOut(service, bmcwebDbusCircuitBreakerThreshold - 1);
+    EXPECT_TRUE(breaker.allowCall(service));
+
+    timeOut(service, 1);
+    EXPECT_FALSE(breaker.allowCall(service));
+    EXPECT_GE(breaker.retryAfter(service), std::chrono::seconds(1));
+    EXPECT_LE(breaker.retryAfter(service), DbusCircuitBreaker::openDuration);
+    EXPECT_EQ(breaker.openCircuits(), std::vector<std::string>{service});
+
+    // Other services are unaffected
+    EXPECT_TRUE(breaker.allowCall("xyz.openbmc_project.Test.Other"));
+
+    breaker.recordResult(service, boost::system::error_code());
+    EXPECT_TRUE(breaker.allowCall(service));
+    EXPECT_TRUE(breaker.openCircuits().empty());
+}
+
+TEST(DbusCircuitBreaker, CancelledProbeIsHandedOutAgain)
+{
+    if (bmcwebDbusCircuitBreakerThreshold == 0)
+    {
+        GTEST_SKIP() << "Circuit breaker disabled";
+    }
+    DbusCircuitBreaker& breaker = DbusCircuitBreaker::getInstance();
+    const std::string service = "xyz.openbmc_project.Test.Probe";
+    DbusCircuitBreaker::Clock::time_point now =
+        DbusCircuitBreaker::Clock::now();
+
+    for (size_t i = 0; i < bmcwebDbusCircuitBreakerThreshold; i++)
+    {
+        breaker.recordResult(service, timedOut, now);
+    }
+    EXPECT_FALSE(breaker.allowCall(service, now));
+
+    DbusCircuitBreaker::Clock::time_point halfOpen =
+        now + DbusCircuitBreaker::openDuration;
+    EXPECT_TRUE(breaker.allowCall(service, halfOpen));
+    EXPECT_TRUE(breaker.probing(service));
+    EXPECT_FALSE(breaker.allowCall(service, halfOpen));
+
+    // The probe ran out of its caller's time before the service answered
+    breaker.cancelProbe(service);
+    EXPECT_FALSE(breaker.probing(service));
+    EXPECT_TRUE(breaker.allowCall(service, halfOpen));
+
+    breaker.recordResult(service, boost::system::error_code());
+    EXPECT_FALSE(breaker.probing(service));
+    EXPECT_TRUE(breaker.allowCall(service));
+}
+
+TEST(DbusCircuitBreaker, ErrorRepliesKeepCircuitClosed)
+{
+    DbusCircuitBreaker& breaker = DbusCircuitBreaker::getInstance();
+    const std::string service = "xyz.openbmc_project.Test.Errors";
+
+    for (size_t i = 0; i < bmcwebDbusCircuitBreakerThreshold + 1; i++)
+    {
+        timeOut(service, 1);
+        breaker.recordResult(service,
+                             boost::system::errc::make_error_code(
+                                 boost::system::errc::invalid_argument));
+    }
+    EXPECT_TRUE(breaker.allowCall(service));
+}
+
+} // namespace
+} // namespace bmcweb
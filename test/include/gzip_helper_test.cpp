@@ -0,0 +1,141 @@
+#include "gzip_helper.hpp"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace bmcweb
+{
+namespace
+{
+
+std::string compress(std::string_view data, Inflater::Format format)
+{
+    z_stream strm{};
+    int windowBits = format == Inflater::Format::Gzip ? 16 + MAX_WBITS
+                                                      : MAX_WBITS;
+    EXPECT_EQ(deflateInit2(&strm, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits,
+                           8, Z_DEFAULT_STRATEGY),
+              Z_OK);
+    std::string out(deflateBound(&strm, data.size()), '\0');
+    strm.next_in = (Bytef*)data.data();                   // NOLINT
+    strm.avail_in = static_cast<uInt>(data.size());
+    strm.next_out = (Bytef*)out.data();                   // NOLINT
+    strm.avail_out = static_cast<uInt>(out.size());
+    EXPECT_EQ(deflate(&strm, Z_FINISH), Z_STREAM_END);
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+    return out;
+}
+
+std::string testData()
+{
+    std::string data;
+    for (size_t i = 0; i < 10000; i++)
+    {
+        data += "{\"AttributeName\": \"Attribute" + std::to_string(i) + "\"}";
+    }
+    return data;
+}
+
+TEST(Inflater, InflatesGzipInPieces)
+{
+    const std::string data = testData();
+    const std::string compressed = compress(data, Inflater::Format::Gzip);
+    ASSERT_LT(compressed.size(), data.size());
+
+    Inflater inflater(Inflater::Format::Gzip);
+    std::string out;
+    // Odd sized pieces, as they would come off the network
+    for (size_t pos = 0; pos < compressed.size(); pos += 777)
+    {
+        std::string_view piece =
+            std::string_view(compressed).substr(pos, 777);
+        ASSERT_TRUE(inflater.write(piece, out, data.size()));
+        EXPECT_EQ(inflater.finished(), pos + piece.size() == compressed.size());
+    }
+    EXPECT_TRUE(inflater.finished());
+    EXPECT_EQ(inflater.totalIn(), compressed.size());
+    EXPECT_EQ(out, data);
+}
+
+TEST(Inflater, InflatesDeflate)
+{
+    const std::string data = testData();
+    Inflater inflater(Inflater::Format::Deflate);
+    std::string out;
+    EXPECT_TRUE(inflater.write(compress(data, Inflater::Format::Deflate), out,
+                               data.size()));
+    EXPECT_TRUE(inflater.finished());
+    EXPECT_EQ(out, data);
+}
+
+TEST(Inflater, TrailerAloneAtMaxSize)
+{
+    const std::string data = testData();
+    const std::string compressed = compress(data, Inflater::Format::Gzip);
+    // The gzip trailer is the CRC and the length, 8 bytes
+    std::string_view body = std::string_view(compressed).substr(
+        0, compressed.size() - 8);
+    std::string_view trailer = std::string_view(compressed).substr(
+        compressed.size() - 8);
+
+    Inflater inflater(Inflater::Format::Gzip);
+    std::string out;
+    ASSERT_TRUE(inflater.write(body, out, data.size()));
+    EXPECT_EQ(out.size(), data.size());
+    EXPECT_FALSE(inflater.finished());
+    EXPECT_TRUE(inflater.write(trailer, out, data.size()));
+    EXPECT_TRUE(inflater.finished());
+    EXPECT_EQ(out, data);
+}
+
+TEST(Inflater, StopsAtMaxSize)
+{
+    const std::string data = testData();
+    Inflater inflater(Inflater::Format::Gzip);
+    std::string out;
+    EXPECT_FALSE(inflater.write(compress(data, Inflater::Format::Gzip), out,
+                                data.size() - 1));
+    EXPECT_LE(out.size(), data.size() - 1);
+    // Stays failed
+    EXPECT_FALSE(inflater.write("x", out, data.size()));
+}
+
+TEST(Inflater, RejectsCorruptAndTrailingData)
+{
+    Inflater corrupt(Inflater::Format::Gzip);
+    std::string out;
+    EXPECT_FALSE(corrupt.write("this is not gzip", out, 1024));
+
+    std::string compressed = compress("hello", Inflater::Format::Gzip);
+    compressed += "trailing";
+    Inflater trailing(Inflater::Format::Gzip);
+    EXPECT_FALSE(trailing.write(compressed, out, 1024));
+}
+
+TEST(GzipInflate, InflatesWholeBuffer)
+{
+    const std::string data = testData();
+    std::string out = "previous contents";
+    EXPECT_TRUE(gzipInflate(compress(data, Inflater::Format::Gzip), out));
+    EXPECT_EQ(out, data);
+
+    // Truncated streams fail
+    std::string compressed = compress(data, Inflater::Format::Gzip);
+    compressed.resize(compressed.size() / 2);
+    EXPECT_FALSE(gzipInflate(compressed, out));
+
+    EXPECT_TRUE(gzipInflate("", out));
+    EXPECT_TRUE(out.empty());
+}
+
+} // namespace
+} // namespace bmcweb
@@ -0,0 +1,64 @@
+#include "memory_accounting.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace bmcweb::memory
+{
+namespace
+{
+
+TEST(MemoryAccounting, ChargesCurrentAccount)
+{
+    Account outer;
+    Account inner;
+    auto usage = std::make_shared<RequestUsage>();
+    {
+        Scope outerScope({&outer, usage});
+        EXPECT_EQ(onAllocate(100), &outer);
+        {
+            Scope innerScope({&inner, nullptr});
+            EXPECT_EQ(onAllocate(40), &inner);
+        }
+        EXPECT_EQ(Scope::current().account, &outer);
+        onFree(&outer, 100);
+    }
+    EXPECT_EQ(Scope::current().account, nullptr);
+
+    EXPECT_EQ(outer.liveBytes, 0);
+    EXPECT_EQ(outer.peakLiveBytes, 100);
+    EXPECT_EQ(outer.allocatedBytes, 100);
+    EXPECT_EQ(outer.allocations, 1);
+    EXPECT_EQ(inner.liveBytes, 40);
+    // Only allocations made for the request count towards it
+    EXPECT_EQ(usage->allocatedBytes, 100);
+
+    onFree(&inner, 40);
+    EXPECT_EQ(inner.liveBytes, 0);
+}
+
+TEST(MemoryAccounting, UntaggedAllocations)
+{
+    uint64_t before = untagged().allocatedBytes;
+    Account* account = onAllocate(8);
+    EXPECT_EQ(account, &untagged());
+    EXPECT_EQ(untagged().allocatedBytes, before + 8);
+    onFree(account, 8);
+}
+
+TEST(MemoryAccounting, RouteStats)
+{
+    finishRequest("/test/route/", RequestUsage{100});
+    finishRequest("/test/route/", RequestUsage{300});
+    const RouteStats& stats = routeStats().find("/test/route/")->second;
+    EXPECT_EQ(stats.requests, 2);
+    EXPECT_EQ(stats.totalBytes, 400);
+    EXPECT_EQ(stats.peakBytes, 300);
+}
+
+} // namespace
+} // namespace bmcweb::memory
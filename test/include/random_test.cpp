@@ -0,0 +1,96 @@
+#include "random.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+// IWYU pragma: no_include <gmock/gmock-matchers.h>
+
+namespace
+{
+
+// Replays a fixed byte sequence, so rejection sampling can be checked
+struct SequenceGenerator
+{
+    explicit SequenceGenerator(std::vector<uint8_t> valuesIn) :
+        values(std::move(valuesIn))
+    {}
+
+    uint8_t operator()()
+    {
+        if (index >= values.size())
+        {
+            err = true;
+            return 0;
+        }
+        return values[index++];
+    }
+
+    static constexpr uint8_t max()
+    {
+        return std::numeric_limits<uint8_t>::max();
+    }
+
+    bool error() const
+    {
+        return err;
+    }
+
+    std::vector<uint8_t> values;
+    size_t index = 0;
+    bool err = false;
+};
+
+TEST(FillRandomAlphanum, MapsBytesToAlphabet)
+{
+    SequenceGenerator gen({0, 10, 36, 61, 62, 247});
+    std::string out(6, ' ');
+    ASSERT_TRUE(bmcweb::fillRandomAlphanum(gen, out));
+    EXPECT_EQ(out, "0Aaz0z");
+}
+
+TEST(FillRandomAlphanum, RejectsBiasedBytes)
+{
+    SequenceGenerator gen({248, 255, 1, 250, 2});
+    std::string out(2, ' ');
+    ASSERT_TRUE(bmcweb::fillRandomAlphanum(gen, out));
+    EXPECT_EQ(out, "12");
+    EXPECT_EQ(gen.index, 5U);
+}
+
+TEST(FillRandomAlphanum, ReportsGeneratorError)
+{
+    SequenceGenerator gen({1, 2});
+    std::string out(3, ' ');
+    EXPECT_FALSE(bmcweb::fillRandomAlphanum(gen, out));
+}
+
+TEST(BufferedOpenSSLGenerator, ProducesDistinctTokens)
+{
+    bmcweb::BufferedOpenSSLGenerator gen;
+    std::set<std::string> tokens;
+    // Enough draws to cross several buffer refills
+    for (size_t i = 0; i < 100; i++)
+    {
+        std::string token(20, '0');
+        ASSERT_TRUE(bmcweb::fillRandomAlphanum(gen, token));
+        EXPECT_FALSE(gen.error());
+        for (char c : token)
+        {
+            EXPECT_NE(bmcweb::alphanumCharacters.find(c), std::string::npos);
+        }
+        tokens.insert(token);
+    }
+    EXPECT_EQ(tokens.size(), 100U);
+}
+
+} // namespace
@@ -0,0 +1,60 @@
+#include "event_load_generator.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h> // IWYU pragma: keep
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish
+{
+namespace
+{
+
+TEST(EventLoadGenerator, EventsDue)
+{
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+    EXPECT_EQ(EventLoadGenerator::eventsDue(seconds(0), 100, 1000), 0);
+    EXPECT_EQ(EventLoadGenerator::eventsDue(milliseconds(15), 100, 1000), 1);
+    EXPECT_EQ(EventLoadGenerator::eventsDue(milliseconds(2500), 100, 1000),
+              250);
+    // Never more than asked for
+    EXPECT_EQ(EventLoadGenerator::eventsDue(seconds(60), 100, 1000), 1000);
+    // No overflow on long runs at the highest rate
+    EXPECT_EQ(EventLoadGenerator::eventsDue(
+                  std::chrono::hours(24 * 365),
+                  EventLoadGenerator::maxEventsPerSecond,
+                  EventLoadGenerator::maxCount),
+              EventLoadGenerator::maxCount);
+}
+
+TEST(EventLoadGenerator, MarkerRoundTrip)
+{
+    std::chrono::system_clock::time_point sentAt(
+        std::chrono::microseconds(1700000000123456));
+    std::string marker = EventLoadGenerator::makeMarker(42, sentAt);
+    EXPECT_EQ(marker, "LoadTest:42:1700000000123456");
+
+    std::optional<EventLoadGenerator::Marker> parsed =
+        EventLoadGenerator::parseMarker(marker);
+    ASSERT_NE(parsed, std::nullopt);
+    EXPECT_EQ(parsed->sequence, 42);
+    EXPECT_EQ(parsed->sentAtUs, 1700000000123456);
+}
+
+TEST(EventLoadGenerator, BadMarkers)
+{
+    EXPECT_EQ(EventLoadGenerator::parseMarker(""), std::nullopt);
+    EXPECT_EQ(EventLoadGenerator::parseMarker("LoadTest:"), std::nullopt);
+    EXPECT_EQ(EventLoadGenerator::parseMarker("LoadTest:1"), std::nullopt);
+    EXPECT_EQ(EventLoadGenerator::parseMarker("LoadTest:1:"), std::nullopt);
+    EXPECT_EQ(EventLoadGenerator::parseMarker("LoadTest:1:2x"), std::nullopt);
+    EXPECT_EQ(EventLoadGenerator::parseMarker("Other:1:2"), std::nullopt);
+}
+
+} // namespace
+} // namespace redfish
@@ -0,0 +1,92 @@
+#include "utils/collection.hpp"
+
+#include <boost/url/url.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::collection_util
+{
+namespace
+{
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<std::string> unsortedIds()
+{
+    return {"dimm10", "dimm2", "dimm0", "dimm11", "dimm1", "dimm3"};
+}
+
+TEST(SortPage, WholeCollectionIsSortedLikeMembers)
+{
+    std::vector<std::string> ids = unsortedIds();
+    std::span<std::string> page =
+        sortPage(ids, 0, std::numeric_limits<size_t>::max());
+    EXPECT_THAT(page, ElementsAre("dimm0", "dimm1", "dimm2", "dimm3",
+                                  "dimm10", "dimm11"));
+}
+
+TEST(SortPage, TopOnlySortsTheFirstMembers)
+{
+    std::vector<std::string> ids = unsortedIds();
+    EXPECT_THAT(sortPage(ids, 0, 2), ElementsAre("dimm0", "dimm1"));
+}
+
+TEST(SortPage, SkipAndTopGiveTheMiddlePage)
+{
+    std::vector<std::string> ids = unsortedIds();
+    EXPECT_THAT(sortPage(ids, 2, 3), ElementsAre("dimm2", "dimm3", "dimm10"));
+}
+
+TEST(SortPage, TopPastTheEndIsClamped)
+{
+    std::vector<std::string> ids = unsortedIds();
+    EXPECT_THAT(sortPage(ids, 4, 10), ElementsAre("dimm10", "dimm11"));
+}
+
+TEST(SortPage, SkipPastTheEndIsEmpty)
+{
+    std::vector<std::string> ids = unsortedIds();
+    EXPECT_THAT(sortPage(ids, 7, 2), IsEmpty());
+
+    std::vector<std::string> none;
+    EXPECT_THAT(sortPage(none, 0, 2), IsEmpty());
+}
+
+TEST(SetMembers, NextLinkKeepsPageSize)
+{
+    std::vector<std::string> ids = unsortedIds();
+    nlohmann::json json;
+    setMembers(json, boost::urls::url("/redfish/v1/Systems/system/Memory"),
+               ids, 2, 3);
+    EXPECT_EQ(json["Members@odata.count"], 6);
+    EXPECT_EQ(json["Members"].size(), 3U);
+    EXPECT_EQ(json["Members"][0]["@odata.id"],
+              "/redfish/v1/Systems/system/Memory/dimm2");
+    EXPECT_EQ(json["Members@odata.nextLink"],
+              "/redfish/v1/Systems/system/Memory?$skip=5&$top=3");
+}
+
+TEST(SetMembers, NoNextLinkOnLastPage)
+{
+    std::vector<std::string> ids = unsortedIds();
+    nlohmann::json json;
+    setMembers(json, boost::urls::url("/redfish/v1/Systems/system/Memory"),
+               ids, 4, 10);
+    EXPECT_EQ(json["Members"].size(), 2U);
+    EXPECT_FALSE(json.contains("Members@odata.nextLink"));
+}
+
+} // namespace
+} // namespace redfish::collection_util
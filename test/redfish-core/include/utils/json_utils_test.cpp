@@ -272,9 +272,8 @@ TEST(ReadJsonPatch, ValidElementsReturnsTrueResponseOkValuesUnpackedCorrectly)
 {
     crow::Response res;
     std::error_code ec;
-    crow::Request req({}, ec);
-    // Ignore errors intentionally
-    req.body = "{\"integer\": 1}";
+    crow::Request req(
+        {boost::beast::http::verb::patch, "/", 11, "{\"integer\": 1}"}, ec);
 
     int64_t integer = 0;
     ASSERT_TRUE(readJsonPatch(req, res, "integer", integer));
@@ -287,9 +286,7 @@ TEST(ReadJsonPatch, EmptyObjectReturnsFalseResponseBadRequest)
 {
     crow::Response res;
     std::error_code ec;
-    crow::Request req({}, ec);
-    // Ignore errors intentionally
-    req.body = "{}";
+    crow::Request req({boost::beast::http::verb::patch, "/", 11, "{}"}, ec);
 
     std::optional<int64_t> integer = 0;
     ASSERT_FALSE(readJsonPatch(req, res, "integer", integer));
@@ -301,9 +298,9 @@ TEST(ReadJsonPatch, OdataIgnored)
 {
     crow::Response res;
     std::error_code ec;
-    crow::Request req({}, ec);
-    // Ignore errors intentionally
-    req.body = R"({"@odata.etag": "etag", "integer": 1})";
+    crow::Request req({boost::beast::http::verb::patch, "/", 11,
+                       R"({"@odata.etag": "etag", "integer": 1})"},
+                      ec);
 
     std::optional<int64_t> integer = 0;
     ASSERT_TRUE(readJsonPatch(req, res, "integer", integer));
@@ -316,9 +313,9 @@ TEST(ReadJsonPatch, OnlyOdataGivesNoOperation)
 {
     crow::Response res;
     std::error_code ec;
-    crow::Request req({}, ec);
-    // Ignore errors intentionally
-    req.body = R"({"@odata.etag": "etag"})";
+    crow::Request req({boost::beast::http::verb::patch, "/", 11,
+                       R"({"@odata.etag": "etag"})"},
+                      ec);
 
     std::optional<int64_t> integer = 0;
     ASSERT_FALSE(readJsonPatch(req, res, "integer", integer));
@@ -330,9 +327,8 @@ TEST(ReadJsonAction, ValidElementsReturnsTrueResponseOkValuesUnpackedCorrectly)
 {
     crow::Response res;
     std::error_code ec;
-    crow::Request req({}, ec);
-    // Ignore errors intentionally
-    req.body = "{\"integer\": 1}";
+    crow::Request req(
+        {boost::beast::http::verb::patch, "/", 11, "{\"integer\": 1}"}, ec);
 
     int64_t integer = 0;
     ASSERT_TRUE(readJsonAction(req, res, "integer", integer));
@@ -345,9 +341,7 @@ TEST(ReadJsonAction, EmptyObjectReturnsTrueResponseOk)
 {
     crow::Response res;
     std::error_code ec;
-    crow::Request req({}, ec);
-    // Ignore errors intentionally
-    req.body = "{}";
+    crow::Request req({boost::beast::http::verb::patch, "/", 11, "{}"}, ec);
 
     std::optional<int64_t> integer = 0;
     ASSERT_TRUE(readJsonAction(req, res, "integer", integer));
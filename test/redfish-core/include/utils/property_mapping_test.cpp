@@ -0,0 +1,92 @@
+#include "utils/property_mapping.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h> // IWYU pragma: keep
+#include <gtest/gtest.h> // IWYU pragma: keep
+
+// IWYU pragma: no_include <gtest/gtest-message.h>
+// IWYU pragma: no_include <gtest/gtest-test-part.h>
+// IWYU pragma: no_include "gtest/gtest_pred_impl.h"
+
+namespace redfish::property_mapping
+{
+namespace
+{
+using ::testing::ElementsAre;
+
+constexpr std::array<PropertyMapping, 4> testTable = {{
+    {"xyz.Asset", "Model", "/Model", transforms::copy<std::string>},
+    {"xyz.Asset", "SparePartNumber", "/SparePartNumber",
+     transforms::nonEmptyString},
+    {"xyz.Location", "LocationCode", "/Location/PartLocation/ServiceLabel",
+     transforms::copy<std::string>},
+    {"xyz.Item", "Present", "", nullptr},
+}};
+
+TEST(PlanInterfaces, ReadsEachInterfaceOnce)
+{
+    EXPECT_THAT(planInterfaces(testTable, {}),
+                ElementsAre("xyz.Asset", "xyz.Location", "xyz.Item"));
+}
+
+TEST(PlanInterfaces, SkipsInterfacesNotImplemented)
+{
+    std::vector<std::string> implemented = {"xyz.Item", "xyz.Asset",
+                                            "xyz.Other"};
+    EXPECT_THAT(planInterfaces(testTable, implemented),
+                ElementsAre("xyz.Asset", "xyz.Item"));
+}
+
+TEST(ApplyMappings, WritesMappedProperties)
+{
+    nlohmann::json json;
+    dbus::utility::DBusPropertiesMap asset = {
+        {"Model", std::string("PSU-1")},
+        {"SparePartNumber", std::string()},
+        {"SerialNumber", std::string("1234")}};
+    EXPECT_TRUE(applyMappings(testTable, "xyz.Asset", asset, json));
+
+    dbus::utility::DBusPropertiesMap location = {
+        {"LocationCode", std::string("U1")}};
+    EXPECT_TRUE(applyMappings(testTable, "xyz.Location", location, json));
+
+    // Fetch only mappings aren't written
+    dbus::utility::DBusPropertiesMap item = {{"Present", true}};
+    EXPECT_TRUE(applyMappings(testTable, "xyz.Item", item, json));
+
+    EXPECT_EQ(json, R"({
+                "Model": "PSU-1",
+                "Location": {"PartLocation": {"ServiceLabel": "U1"}}
+            })"_json);
+}
+
+TEST(ApplyMappings, ReportsTypeErrors)
+{
+    nlohmann::json json;
+    dbus::utility::DBusPropertiesMap asset = {
+        {"Model", true}, {"SparePartNumber", std::string("SP1")}};
+    EXPECT_FALSE(applyMappings(testTable, "xyz.Asset", asset, json));
+    EXPECT_EQ(json, R"({"SparePartNumber": "SP1"})"_json);
+}
+
+TEST(FindProperty, FindsTypedProperty)
+{
+    InterfaceProperties properties;
+    properties["xyz.Item"] = {{"Present", true}};
+    const bool* present = findProperty<bool>(properties, "xyz.Item", "Present");
+    ASSERT_NE(present, nullptr);
+    EXPECT_TRUE(*present);
+    EXPECT_EQ(findProperty<std::string>(properties, "xyz.Item", "Present"),
+              nullptr);
+    EXPECT_EQ(findProperty<bool>(properties, "xyz.Item", "Functional"),
+              nullptr);
+    EXPECT_EQ(findProperty<bool>(properties, "xyz.Asset", "Present"), nullptr);
+}
+
+} // namespace
+} // namespace redfish::property_mapping